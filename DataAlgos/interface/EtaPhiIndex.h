@@ -0,0 +1,99 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  EtaPhiIndex.h
+ *
+ *    Description:  Buckets objects into a grid of eta-phi cells so the objects
+ *                  near a given direction can be found without scanning the
+ *                  whole collection.
+ *
+ *                  The objects are identified by their index in the source
+ *                  collection.  Lookups return indices in ascending order, so
+ *                  a loop over the result visits the objects in the same
+ *                  order as a loop over the full collection.
+ *
+ *                  The index is meant to be filled once per event and reused,
+ *                  clear() keeps the allocated cells.
+ *
+ * =====================================================================================
+ */
+
+#ifndef ETAPHIINDEX_Q7ZK2M4D
+#define ETAPHIINDEX_Q7ZK2M4D
+
+#include <vector>
+#include <cstddef>
+
+class EtaPhiIndex {
+  public:
+    /// Make an index with cells of (at least) [cellSize] in eta and phi.
+    /// Objects with |eta| > [maxEta] go into overflow cells.
+    explicit EtaPhiIndex(double cellSize=0.5, double maxEta=5.0);
+
+    /// Remove all objects
+    void clear();
+
+    /// Add the object with index [index] in the source collection
+    void insert(double eta, double phi, size_t index);
+
+    /// Fill from any collection of objects with eta() and phi() methods
+    /// (i.e. a vector of reco::Candidates).  Clears the index first.
+    template<class C>
+    void fill(const C& collection) {
+      clear();
+      for (size_t i = 0; i < collection.size(); ++i) {
+        insert(collection[i].eta(), collection[i].phi(), i);
+      }
+    }
+
+    /// Number of objects in the index
+    size_t size() const { return nObjects_; }
+
+    /// Get the indices of all objects in the cells overlapping the cone of
+    /// [radius] around (eta, phi).  This is a superset of the objects within
+    /// [radius], for use when the caller applies its own deltaR condition.
+    /// The output is cleared first.
+    void neighbours(double eta, double phi, double radius,
+        std::vector<size_t>& output) const;
+
+    /// Get the indices of all objects with deltaR < [maxDeltaR] to
+    /// (eta, phi).  The output is cleared first.
+    void within(double eta, double phi, double maxDeltaR,
+        std::vector<size_t>& output) const;
+
+    /// Check if any object is within deltaR < [maxDeltaR] of (eta, phi)
+    bool any(double eta, double phi, double maxDeltaR) const;
+
+    /// Get the index of the closest object with deltaR < [maxDeltaR] to
+    /// (eta, phi).  Ties are resolved in favor of the lower index.  Returns
+    /// -1 if there is none.
+    int closest(double eta, double phi, double maxDeltaR) const;
+
+    /// deltaR^2 between (eta, phi) and the object with index [index]
+    double deltaR2(double eta, double phi, size_t index) const;
+
+  private:
+    size_t etaBin(double eta) const;
+    size_t phiBin(double phi) const;
+    // Fill [cells_] with the cell indices to scan
+    void cellsInCone(double eta, double phi, double radius) const;
+
+    double etaCellSize_;
+    double maxEta_;
+    size_t nEtaBins_; // including the two overflow bins
+    size_t nPhiBins_;
+    double phiCellSize_;
+
+    std::vector<std::vector<size_t> > grid_;
+    std::vector<size_t> filledCells_;
+
+    // Position of each object, by index in the source collection
+    std::vector<double> etas_;
+    std::vector<double> phis_;
+    std::vector<char> present_;
+    size_t nObjects_;
+
+    mutable std::vector<size_t> cells_;
+};
+
+#endif /* end of include guard: ETAPHIINDEX_Q7ZK2M4D */
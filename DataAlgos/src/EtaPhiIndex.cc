@@ -0,0 +1,165 @@
+#include "FinalStateAnalysis/DataAlgos/interface/EtaPhiIndex.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+  const double kPi = M_PI;
+  const double kTwoPi = 2*M_PI;
+
+  // Same convention as reco::deltaPhi
+  double deltaPhi(double phi1, double phi2) {
+    double result = phi1 - phi2;
+    while (result > kPi) result -= kTwoPi;
+    while (result <= -kPi) result += kTwoPi;
+    return result;
+  }
+}
+
+EtaPhiIndex::EtaPhiIndex(double cellSize, double maxEta):
+  etaCellSize_(cellSize),maxEta_(maxEta),nObjects_(0) {
+  // +2 for the under/overflow
+  nEtaBins_ = static_cast<size_t>(std::ceil(2*maxEta_/etaCellSize_)) + 2;
+  nPhiBins_ = std::max(1, static_cast<int>(std::floor(kTwoPi/cellSize)));
+  phiCellSize_ = kTwoPi/nPhiBins_;
+  grid_.resize(nEtaBins_*nPhiBins_);
+}
+
+void EtaPhiIndex::clear() {
+  for (size_t i = 0; i < filledCells_.size(); ++i) {
+    grid_[filledCells_[i]].clear();
+  }
+  filledCells_.clear();
+  etas_.clear();
+  phis_.clear();
+  present_.clear();
+  nObjects_ = 0;
+}
+
+size_t EtaPhiIndex::etaBin(double eta) const {
+  // NaN goes to the underflow
+  if (!(eta >= -maxEta_))
+    return 0;
+  if (eta >= maxEta_)
+    return nEtaBins_ - 1;
+  size_t bin = 1 + static_cast<size_t>((eta + maxEta_)/etaCellSize_);
+  return std::min(bin, nEtaBins_ - 2);
+}
+
+size_t EtaPhiIndex::phiBin(double phi) const {
+  double shifted = std::fmod(phi + kPi, kTwoPi);
+  if (shifted < 0)
+    shifted += kTwoPi;
+  if (!(shifted >= 0)) // NaN
+    return 0;
+  size_t bin = static_cast<size_t>(shifted/phiCellSize_);
+  return std::min(bin, nPhiBins_ - 1);
+}
+
+void EtaPhiIndex::insert(double eta, double phi, size_t index) {
+  if (index >= etas_.size()) {
+    etas_.resize(index + 1, 0.);
+    phis_.resize(index + 1, 0.);
+    present_.resize(index + 1, 0);
+  }
+  etas_[index] = eta;
+  phis_[index] = phi;
+  if (!present_[index])
+    ++nObjects_;
+  present_[index] = 1;
+  size_t cell = etaBin(eta)*nPhiBins_ + phiBin(phi);
+  if (grid_[cell].empty())
+    filledCells_.push_back(cell);
+  grid_[cell].push_back(index);
+}
+
+void EtaPhiIndex::cellsInCone(double eta, double phi, double radius) const {
+  cells_.clear();
+  // Nothing is near a NaN or infinite direction (and the phi cells below
+  // can't be computed for one)
+  if (!std::isfinite(eta) || !std::isfinite(phi) || std::isnan(radius))
+    return;
+  size_t minEta = etaBin(eta - radius);
+  size_t maxEta = etaBin(eta + radius);
+  // The cone can't be wider than the full circle in phi
+  double phiWidth = std::min(radius, kPi);
+  int minPhi = static_cast<int>(std::floor((phi - phiWidth + kPi)/phiCellSize_));
+  int maxPhi = static_cast<int>(std::floor((phi + phiWidth + kPi)/phiCellSize_));
+  // Guard against rounding at the cell edges
+  --minPhi;
+  ++maxPhi;
+  bool allPhi = (maxPhi - minPhi + 1) >= static_cast<int>(nPhiBins_);
+  if (allPhi) {
+    minPhi = 0;
+    maxPhi = nPhiBins_ - 1;
+  }
+  for (size_t iEta = minEta; iEta <= maxEta; ++iEta) {
+    for (int iPhi = minPhi; iPhi <= maxPhi; ++iPhi) {
+      int wrapped = iPhi % static_cast<int>(nPhiBins_);
+      if (wrapped < 0)
+        wrapped += nPhiBins_;
+      cells_.push_back(iEta*nPhiBins_ + wrapped);
+    }
+  }
+}
+
+void EtaPhiIndex::neighbours(double eta, double phi, double radius,
+    std::vector<size_t>& output) const {
+  output.clear();
+  cellsInCone(eta, phi, radius);
+  for (size_t c = 0; c < cells_.size(); ++c) {
+    const std::vector<size_t>& cell = grid_[cells_[c]];
+    output.insert(output.end(), cell.begin(), cell.end());
+  }
+  std::sort(output.begin(), output.end());
+  output.erase(std::unique(output.begin(), output.end()), output.end());
+}
+
+double EtaPhiIndex::deltaR2(double eta, double phi, size_t index) const {
+  double dEta = eta - etas_[index];
+  double dPhi = deltaPhi(phi, phis_[index]);
+  return dEta*dEta + dPhi*dPhi;
+}
+
+void EtaPhiIndex::within(double eta, double phi, double maxDeltaR,
+    std::vector<size_t>& output) const {
+  neighbours(eta, phi, maxDeltaR, output);
+  double maxDeltaR2 = maxDeltaR*maxDeltaR;
+  size_t nKept = 0;
+  for (size_t i = 0; i < output.size(); ++i) {
+    if (deltaR2(eta, phi, output[i]) < maxDeltaR2)
+      output[nKept++] = output[i];
+  }
+  output.resize(nKept);
+}
+
+bool EtaPhiIndex::any(double eta, double phi, double maxDeltaR) const {
+  cellsInCone(eta, phi, maxDeltaR);
+  double maxDeltaR2 = maxDeltaR*maxDeltaR;
+  for (size_t c = 0; c < cells_.size(); ++c) {
+    const std::vector<size_t>& cell = grid_[cells_[c]];
+    for (size_t i = 0; i < cell.size(); ++i) {
+      if (deltaR2(eta, phi, cell[i]) < maxDeltaR2)
+        return true;
+    }
+  }
+  return false;
+}
+
+int EtaPhiIndex::closest(double eta, double phi, double maxDeltaR) const {
+  cellsInCone(eta, phi, maxDeltaR);
+  int best = -1;
+  double bestDeltaR2 = maxDeltaR*maxDeltaR;
+  for (size_t c = 0; c < cells_.size(); ++c) {
+    const std::vector<size_t>& cell = grid_[cells_[c]];
+    for (size_t i = 0; i < cell.size(); ++i) {
+      double dR2 = deltaR2(eta, phi, cell[i]);
+      if (dR2 < bestDeltaR2 ||
+          (best >= 0 && dR2 == bestDeltaR2 && cell[i] < (size_t)best)) {
+        bestDeltaR2 = dR2;
+        best = cell[i];
+      }
+    }
+  }
+  return best;
+}
@@ -0,0 +1,144 @@
+/*
+ * Test the EtaPhiIndex against a brute force loop
+ */
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <Utilities/Testing/interface/CppUnit_testdriver.icpp>
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+#include "FinalStateAnalysis/DataAlgos/interface/EtaPhiIndex.h"
+#include "DataFormats/Math/interface/deltaR.h"
+
+class testEtaPhiIndex: public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(testEtaPhiIndex);
+  CPPUNIT_TEST(testWithin);
+  CPPUNIT_TEST(testPhiWrapping);
+  CPPUNIT_TEST(testOverflow);
+  CPPUNIT_TEST(testClosest);
+  CPPUNIT_TEST(testNotFinite);
+  CPPUNIT_TEST_SUITE_END();
+  public:
+    void setUp();
+    void tearDown(){}
+
+    void testWithin();
+    void testPhiWrapping();
+    void testOverflow();
+    void testClosest();
+    void testNotFinite();
+
+    std::vector<double> etas_;
+    std::vector<double> phis_;
+};
+
+void testEtaPhiIndex::setUp() {
+  std::srand(12345);
+  for (size_t i = 0; i < 500; ++i) {
+    etas_.push_back(-6. + 12.*std::rand()/RAND_MAX);
+    phis_.push_back(-M_PI + 2*M_PI*std::rand()/RAND_MAX);
+  }
+}
+
+void testEtaPhiIndex::testWithin() {
+  EtaPhiIndex index(0.5);
+  for (size_t i = 0; i < etas_.size(); ++i)
+    index.insert(etas_[i], phis_[i], i);
+  CPPUNIT_ASSERT(index.size() == etas_.size());
+
+  double radii[] = {0.05, 0.3, 0.5, 0.8, 2.0, 1e9};
+  std::vector<size_t> found;
+  for (size_t r = 0; r < 6; ++r) {
+    for (size_t q = 0; q < 50; ++q) {
+      double eta = etas_[q] + 0.1;
+      double phi = phis_[q] - 0.1;
+      std::vector<size_t> expected;
+      for (size_t i = 0; i < etas_.size(); ++i) {
+        if (reco::deltaR(eta, phi, etas_[i], phis_[i]) < radii[r])
+          expected.push_back(i);
+      }
+      index.within(eta, phi, radii[r], found);
+      CPPUNIT_ASSERT(found == expected);
+      CPPUNIT_ASSERT(index.any(eta, phi, radii[r]) == !expected.empty());
+    }
+  }
+
+  // Reuse after clear
+  index.clear();
+  CPPUNIT_ASSERT(index.size() == 0);
+  index.within(0, 0, 1e9, found);
+  CPPUNIT_ASSERT(found.empty());
+}
+
+void testEtaPhiIndex::testPhiWrapping() {
+  EtaPhiIndex index(0.4);
+  index.insert(0.0, M_PI - 0.01, 0);
+  index.insert(0.0, -M_PI + 0.01, 1);
+  index.insert(0.0, 0.0, 2);
+  std::vector<size_t> found;
+  index.within(0.0, M_PI, 0.05, found);
+  CPPUNIT_ASSERT(found.size() == 2);
+  CPPUNIT_ASSERT(found[0] == 0);
+  CPPUNIT_ASSERT(found[1] == 1);
+  index.within(0.0, -M_PI + 0.02, 0.05, found);
+  CPPUNIT_ASSERT(found.size() == 2);
+}
+
+void testEtaPhiIndex::testOverflow() {
+  EtaPhiIndex index(0.5, 2.5);
+  index.insert(4.0, 0.0, 0);
+  index.insert(-4.0, 0.0, 1);
+  index.insert(2.4, 0.0, 2);
+  std::vector<size_t> found;
+  index.within(3.5, 0.0, 0.8, found);
+  CPPUNIT_ASSERT(found.size() == 1);
+  CPPUNIT_ASSERT(found[0] == 0);
+  index.within(2.6, 0.0, 0.3, found);
+  CPPUNIT_ASSERT(found.size() == 1);
+  CPPUNIT_ASSERT(found[0] == 2);
+  index.within(-3.5, 0.0, 0.6, found);
+  CPPUNIT_ASSERT(found.size() == 1);
+  CPPUNIT_ASSERT(found[0] == 1);
+}
+
+void testEtaPhiIndex::testClosest() {
+  EtaPhiIndex index(0.5);
+  for (size_t i = 0; i < etas_.size(); ++i)
+    index.insert(etas_[i], phis_[i], i);
+  for (size_t q = 0; q < 50; ++q) {
+    double eta = etas_[q] + 0.05;
+    double phi = phis_[q];
+    int expected = -1;
+    double best = 0.4;
+    for (size_t i = 0; i < etas_.size(); ++i) {
+      double dR = reco::deltaR(eta, phi, etas_[i], phis_[i]);
+      if (dR < best) {
+        best = dR;
+        expected = i;
+      }
+    }
+    CPPUNIT_ASSERT_EQUAL(expected, index.closest(eta, phi, 0.4));
+  }
+}
+
+void testEtaPhiIndex::testNotFinite() {
+  EtaPhiIndex index(0.5);
+  for (size_t i = 0; i < etas_.size(); ++i)
+    index.insert(etas_[i], phis_[i], i);
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  const double inf = std::numeric_limits<double>::infinity();
+  std::vector<size_t> found(1, 0);
+  index.neighbours(0.0, nan, 1e9, found);
+  CPPUNIT_ASSERT(found.empty());
+  index.within(nan, 0.0, 1e9, found);
+  CPPUNIT_ASSERT(found.empty());
+  index.within(0.0, 0.0, nan, found);
+  CPPUNIT_ASSERT(found.empty());
+  CPPUNIT_ASSERT(!index.any(0.0, inf, 1e9));
+  CPPUNIT_ASSERT(!index.any(-inf, 0.0, 1e9));
+  CPPUNIT_ASSERT_EQUAL(-1, index.closest(nan, nan, 1e9));
+}
+
+CPPUNIT_TEST_SUITE_REGISTRATION(testEtaPhiIndex);
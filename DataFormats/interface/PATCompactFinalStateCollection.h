@@ -0,0 +1,117 @@
+/*
+ * PATCompactFinalStateCollection
+ *
+ * A compact, columnar alternative to a PATFinalStateCollection.
+ *
+ * Instead of storing a full PATFinalState (with its own Ptrs, event RefProd,
+ * four-vector and userFloat/userCand maps) for every combination, the legs of
+ * each row are stored as (product, key) indices into the input collections.
+ * The event reference is shared by all rows, and the user data is stored as
+ * one column per name.  The charge and four-vector are recomputed from the
+ * legs when a row is expanded.  The overlaps of each row are stored the same
+ * way as the user data.
+ *
+ * The usual PATFinalState interface can be rebuilt on demand for any row via
+ * finalState(i).  A single final state without user data is kept as a
+ * prototype, so the rows are rebuilt with the concrete type of the input
+ * (e.g. PATElecMuFinalState), which must be the same for all of them.
+ *
+ */
+
+#ifndef FinalStateAnalysis_DataFormats_PATCompactFinalStateCollection_h
+#define FinalStateAnalysis_DataFormats_PATCompactFinalStateCollection_h
+
+#include <string>
+#include <vector>
+
+#include "DataFormats/Candidate/interface/CandidateFwd.h"
+#include "DataFormats/Common/interface/Ptr.h"
+
+#include "FinalStateAnalysis/DataFormats/interface/PATFinalState.h"
+#include "FinalStateAnalysis/DataFormats/interface/PATFinalStateFwd.h"
+#include "FinalStateAnalysis/DataFormats/interface/PATFinalStateEventFwd.h"
+#include "FinalStateAnalysis/DataFormats/interface/PATFinalStateProxy.h"
+
+class PATCompactFinalStateCollection {
+  public:
+    PATCompactFinalStateCollection();
+
+    PATCompactFinalStateCollection(size_t nLegs,
+        const edm::Ptr<PATFinalStateEvent>& evt);
+
+    /// Append a final state.  All the appended final states must have the
+    /// same concrete type and number of legs.  User data and overlap names
+    /// not yet seen are added as new columns; missing entries in a column
+    /// are left empty.
+    void push_back(const PATFinalState& finalState);
+
+    /// Number of stored final states
+    size_t size() const { return nRows_; }
+    bool empty() const { return nRows_ == 0; }
+
+    /// Number of legs in each final state
+    size_t numberOfDaughters() const { return nLegs_; }
+
+    /// The event shared by all the final states
+    const edm::Ptr<PATFinalStateEvent>& evt() const { return event_; }
+
+    /// Get the leg of the ith final state as a Ptr into its input collection
+    reco::CandidatePtr daughterPtr(size_t i, size_t leg) const;
+    /// Get the key of the leg in its input collection
+    unsigned int daughterKey(size_t i, size_t leg) const;
+
+    /// Columnar user data accessors
+    const std::vector<std::string>& userFloatNames() const {
+      return userFloatNames_;
+    }
+    const std::vector<std::string>& userCandNames() const {
+      return userCandNames_;
+    }
+    bool hasUserFloat(size_t i, const std::string& name) const;
+    float userFloat(size_t i, const std::string& name) const;
+    /// Get a whole column, missing entries are NaN.  Throws if the column
+    /// d.n.e.
+    const std::vector<float>& userFloatColumn(const std::string& name) const;
+    reco::CandidatePtr userCand(size_t i, const std::string& name) const;
+    const std::vector<std::string>& overlapLabels() const {
+      return overlapLabels_;
+    }
+    /// Returns an empty vector if the overlaps d.n.e.
+    const reco::CandidatePtrVector& overlaps(size_t i,
+        const std::string& label) const;
+
+    /// Rebuild the full PATFinalState interface for the ith final state.
+    PATFinalStateProxy finalState(size_t i) const;
+
+  private:
+    size_t legIndex(size_t i, size_t leg) const;
+    size_t addLegProduct(const reco::CandidatePtr& leg);
+    bool userFloatPresent(size_t column, size_t i) const;
+
+    unsigned char nLegs_;
+    unsigned int nRows_;
+    edm::Ptr<PATFinalStateEvent> event_;
+
+    // One representative Ptr for each input collection seen, used to recover
+    // the ProductID and product getter when rebuilding a leg.
+    std::vector<reco::CandidatePtr> legProducts_;
+    // Row major [row*nLegs + leg] indices into legProducts_ and the input
+    // collection.
+    std::vector<unsigned char> legProductIdx_;
+    std::vector<unsigned int> legKeys_;
+
+    std::vector<std::string> userFloatNames_;
+    std::vector<std::vector<float> > userFloatColumns_;
+    // Whether each entry of userFloatColumns_ was set.  Missing entries are
+    // NaN in the columns, but a stored userFloat may be NaN too.
+    std::vector<std::vector<unsigned char> > userFloatPresent_;
+    std::vector<std::string> userCandNames_;
+    std::vector<std::vector<reco::CandidatePtr> > userCandColumns_;
+    std::vector<std::string> overlapLabels_;
+    std::vector<std::vector<reco::CandidatePtrVector> > overlapColumns_;
+
+    // Holds (at most) one final state of the concrete type of the rows
+    PATFinalStateCollection prototype_;
+};
+
+#endif /* end of include guard: FinalStateAnalysis_DataFormats_PATCompactFinalStateCollection_h */
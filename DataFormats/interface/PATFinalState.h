@@ -50,6 +50,11 @@ class PATFinalState : public pat::PATObject<reco::LeafCandidate> {
 
     virtual PATFinalState* clone() const = 0;
 
+    /// Build a new final state of the same concrete type from [legs], which
+    /// must match the daughter types.  The user data is not copied.
+    virtual PATFinalState* rebuild(const std::vector<reco::CandidatePtr>& legs,
+        const edm::Ptr<PATFinalStateEvent>& evt) const = 0;
+
     /// Get the ith daughter.  Throws an exception if d.n.e.
     const reco::Candidate* daughter(size_t i) const;
 
@@ -67,14 +72,17 @@ class PATFinalState : public pat::PATObject<reco::LeafCandidate> {
     // Get all daughters, w/o systematics
     std::vector<reco::CandidatePtr> daughterPtrs() const;
 
-    /// Check if the ith daughter has given user cand
+    /// Check if the ith daughter has given user cand, or compact shift
+    /// (see PATObjectShifts)
     bool daughterHasUserCand(size_t i, const std::string& tag) const;
 
-    /// Get the ith daughter's user cand (needs concrete type info)
+    /// Get the ith daughter's user cand (needs concrete type info).  For
+    /// compact shifts it is a transient Ptr to the shifted candidate.
     const reco::CandidatePtr daughterUserCand(size_t i,
         const std::string& tag) const;
 
-    const LorentzVector& daughterUserCandP4(size_t i,
+    /// Get the p4 of the ith daughter's user cand, or compact shift
+    LorentzVector daughterUserCandP4(size_t i,
         const std::string& tag) const;
 
     /// Return the indices of the daughters, ordered by descending pt
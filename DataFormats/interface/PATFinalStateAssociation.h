@@ -0,0 +1,78 @@
+/*
+ * PATFinalStateAssociation
+ *
+ * Lightweight user data associated to the final states of a collection,
+ * keyed by the index of the final state in that collection.
+ *
+ * The final state embedders can emit one of these instead of deep copying
+ * the full final state collection just to add a few userFloats or overlaps.
+ * The associations are folded into a single copy of each final state via
+ * embedInto(..), e.g. by PATFinalStateCopier or PATFinalStateAnalysis.
+ *
+ */
+
+#ifndef FinalStateAnalysis_DataFormats_PATFinalStateAssociation_h
+#define FinalStateAnalysis_DataFormats_PATFinalStateAssociation_h
+
+#include <string>
+#include <vector>
+
+#include "DataFormats/Candidate/interface/CandidateFwd.h"
+#include "DataFormats/Common/interface/PtrVector.h"
+#include "DataFormats/Provenance/interface/ProductID.h"
+
+class PATFinalState;
+
+class PATFinalStateAssociation {
+  public:
+    PATFinalStateAssociation();
+
+    /// Make an (empty) association to the [size] final states in the
+    /// collection with ProductID [src].
+    PATFinalStateAssociation(const edm::ProductID& src, size_t size);
+
+    /// The ProductID of the associated final state collection
+    const edm::ProductID& src() const { return src_; }
+    /// The number of associated final states
+    size_t size() const { return size_; }
+
+    /// Add a userFloat to the ith final state
+    void addUserFloat(size_t i, const std::string& name, float value);
+    /// Set the overlaps of the ith final state
+    void setOverlaps(size_t i, const std::string& label,
+        const reco::CandidatePtrVector& overlaps);
+
+    bool hasUserFloat(size_t i, const std::string& name) const;
+    /// Returns 0 if the userFloat d.n.e, like pat::PATObject::userFloat
+    float userFloat(size_t i, const std::string& name) const;
+
+    /// True if the ith final state has non-empty overlaps
+    bool hasOverlaps(size_t i, const std::string& label) const;
+    /// Returns an empty vector if the overlaps d.n.e.
+    const reco::CandidatePtrVector& overlaps(
+        size_t i, const std::string& label) const;
+
+    /// Merge the user data from another association to the same collection
+    void merge(const PATFinalStateAssociation& other);
+
+    /// Copy the user data of the ith final state into [finalState]
+    void embedInto(size_t i, PATFinalState& finalState) const;
+
+  private:
+    void checkIndex(size_t i) const;
+
+    edm::ProductID src_;
+    unsigned int size_;
+
+    std::vector<std::string> userFloatNames_;
+    std::vector<std::vector<float> > userFloatColumns_;
+    // Whether each entry of userFloatColumns_ was set, since a userFloat
+    // may itself be NaN.
+    std::vector<std::vector<unsigned char> > userFloatPresent_;
+    std::vector<std::string> overlapLabels_;
+    std::vector<std::vector<reco::CandidatePtrVector> > overlapColumns_;
+
+    reco::CandidatePtrVector emptyOverlaps_;
+};
+
+#endif /* end of include guard: FinalStateAnalysis_DataFormats_PATFinalStateAssociation_h */
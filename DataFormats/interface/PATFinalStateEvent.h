@@ -44,7 +44,9 @@ class PATFinalStateEvent {
     // minimal constructor used only for unit tests
     PATFinalStateEvent(
         const edm::Ptr<reco::Vertex>& pv,
-        const edm::Ptr<pat::MET>& met
+        const edm::Ptr<pat::MET>& met,
+        const std::map<std::string, edm::Ptr<pat::MET> >& mets =
+          std::map<std::string, edm::Ptr<pat::MET> >()
     );
 
     // This constructor should only be used in the initial production!
@@ -103,6 +105,10 @@ class PATFinalStateEvent {
     const edm::Ptr<pat::MET> met(const std::string& type) const;
     // Get 4-vector of the MET
     const reco::Candidate::LorentzVector met4vector(const std::string& type, const std::string& tag="", const int applyPhiCorr=0) const;
+    /// Get the 4-vector of a systematic variation of the MET, by index in
+    /// metshifts::Shift.  Faster than the tag version if the shifts are stored
+    /// compactly (see PATMETShifts.h)
+    const reco::Candidate::LorentzVector metShift(const std::string& type, int shift, const int applyPhiCorr=0) const;
 
     /// Get the event ID
     const edm::EventID& evtId() const;
@@ -0,0 +1,57 @@
+/*
+ * Enumeration of the MET systematic variations made by
+ * PATMETSystematicsEmbedder.
+ *
+ * In compact mode the embedder stores all the variations in a single-row
+ * PATObjectShifts embedded in the MET (userData "shifts"), with the shifts
+ * in the order of this enum, so PATFinalStateEvent::metShift(..) can get a
+ * variation by index without any string or product lookup.
+ *
+ * p4(..) gets a variation from either the userCands or the compact shifts.
+ *
+ */
+
+#ifndef FinalStateAnalysis_DataFormats_PATMETShifts_h
+#define FinalStateAnalysis_DataFormats_PATMETShifts_h
+
+#include <string>
+#include <vector>
+
+#include "DataFormats/Candidate/interface/Candidate.h"
+
+namespace pat {
+  class MET;
+}
+
+namespace metshifts {
+  enum Shift {
+    kRaw = 0,
+    kType1,
+    kMESUp,
+    kMESDown,
+    kEESUp,
+    kEESDown,
+    kTESUp,
+    kTESDown,
+    kJESUp,
+    kJESDown,
+    kUESUp,
+    kUESDown,
+    kNShifts
+  };
+
+  /// The userCand name of [shift], i.e. "jes+" for kJESUp
+  const std::string& name(int shift);
+  /// The names of all the shifts, in enum order
+  const std::vector<std::string>& names();
+  /// The shift with the given userCand name, or -1 if it d.n.e.
+  int index(const std::string& name);
+
+  /// The [tag] variation of [met].  Throws if it d.n.e.
+  reco::Candidate::LorentzVector p4(const pat::MET& met,
+      const std::string& tag);
+  /// Same, by index
+  reco::Candidate::LorentzVector p4(const pat::MET& met, int shift);
+}
+
+#endif
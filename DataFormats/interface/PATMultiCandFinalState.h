@@ -15,6 +15,10 @@ class PATMultiCandFinalState : public PATFinalState {
 
     virtual PATMultiCandFinalState* clone() const;
 
+    virtual PATMultiCandFinalState* rebuild(
+        const std::vector<reco::CandidatePtr>& legs,
+        const edm::Ptr<PATFinalStateEvent>& evt) const;
+
     virtual const reco::Candidate* daughterUnsafe(size_t i) const;
 
     virtual const reco::CandidatePtr daughterPtrUnsafe(size_t i) const;
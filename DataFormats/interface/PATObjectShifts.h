@@ -0,0 +1,131 @@
+/*
+ * PATObjectShifts
+ *
+ * Compact storage of the systematically shifted four-vectors of a PAT object
+ * collection.  Each object has one (px, py, pz, E) entry per named shift
+ * (i.e. "jes+", "jes-"), stored in a single flat array.
+ *
+ * The systematics embedders can emit one of these instead of a separate
+ * collection of shifted candidates per shift, linked by userCand.  The
+ * objects then reference the product via the userData "shifts" (a RefProd)
+ * and their row via the userInt "shiftsIndex"; see link(..).  A single
+ * object (i.e. the MET) can instead carry its own one-row PATObjectShifts as
+ * the userData "shifts"; see embed(..).
+ *
+ * shiftedP4(..) retrieves a shifted p4 from either representation, and
+ * shiftedCand(..) a shifted candidate, for the code which needs one.
+ *
+ */
+
+#ifndef FinalStateAnalysis_DataFormats_PATObjectShifts_h
+#define FinalStateAnalysis_DataFormats_PATObjectShifts_h
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "DataFormats/Candidate/interface/Candidate.h"
+#include "DataFormats/Candidate/interface/LeafCandidate.h"
+#include "DataFormats/Common/interface/RefProd.h"
+#include "DataFormats/PatCandidates/interface/PATObject.h"
+
+class PATObjectShifts {
+  public:
+    typedef reco::Candidate::LorentzVector LorentzVector;
+
+    PATObjectShifts();
+
+    /// Make storage for the [shifts] of [nObjects] objects.  All entries
+    /// are initially missing.
+    PATObjectShifts(const std::vector<std::string>& shifts, size_t nObjects);
+
+    /// The number of objects
+    size_t size() const { return nObjects_; }
+    /// The names of the shifts
+    const std::vector<std::string>& shifts() const { return shifts_; }
+    /// The index of shift [name], or -1 if it d.n.e.
+    int index(const std::string& name) const;
+
+    /// Set the p4 of the ith object for the given shift index
+    void setP4(size_t i, size_t shift, const LorentzVector& p4);
+    bool hasP4(size_t i, size_t shift) const;
+    /// Throws an exception if the entry is missing
+    LorentzVector p4(size_t i, size_t shift) const;
+    /// Look up the shift by name.  Returns false if it d.n.e.
+    bool p4(size_t i, const std::string& name, LorentzVector& output) const;
+
+    /// The ith [object] with the p4 of shift [name], like the candidates
+    /// of the userCand representation, or NULL if it d.n.e.  It is built
+    /// on the first call and owned (transiently) by this PATObjectShifts.
+    const reco::Candidate* candidate(size_t i, const std::string& name,
+        const reco::Candidate& object) const;
+
+    /// Reference the [i]th row of [shifts] from [object]
+    template<typename T>
+    static void link(pat::PATObject<T>& object,
+        const edm::RefProd<PATObjectShifts>& shifts, size_t i) {
+      object.addUserData("shifts", shifts);
+      object.addUserInt("shiftsIndex", i);
+    }
+
+    /// Store the one-row [shifts] in [object] itself
+    template<typename T>
+    static void embed(pat::PATObject<T>& object,
+        const PATObjectShifts& shifts) {
+      object.addUserData("shifts", shifts);
+    }
+
+    /// Get the PATObjectShifts embedded in [object], or NULL
+    template<typename T>
+    static const PATObjectShifts* embedded(const pat::PATObject<T>& object) {
+      return object.template userData<PATObjectShifts>("shifts");
+    }
+
+    /// Get the [name] shifted p4 of [object], from either a userCand or the
+    /// embedded or linked PATObjectShifts.  Returns false if none exist.
+    template<typename T>
+    static bool shiftedP4(const pat::PATObject<T>& object,
+        const std::string& name, LorentzVector& output) {
+      const reco::CandidatePtr userCand = object.userCand(name);
+      if (userCand.isNonnull()) {
+        output = userCand->p4();
+        return true;
+      }
+      const PATObjectShifts* own = embedded(object);
+      if (own)
+        return own->p4(0, name, output);
+      const edm::RefProd<PATObjectShifts>* shifts =
+        object.template userData<edm::RefProd<PATObjectShifts> >("shifts");
+      if (!shifts || shifts->isNull() || !object.hasUserInt("shiftsIndex"))
+        return false;
+      return (*shifts)->p4(object.userInt("shiftsIndex"), name, output);
+    }
+
+    /// Same, but get the [name] shifted candidate, see candidate(..)
+    template<typename T>
+    static const reco::Candidate* shiftedCand(
+        const pat::PATObject<T>& object, const std::string& name) {
+      const reco::CandidatePtr userCand = object.userCand(name);
+      if (userCand.isNonnull())
+        return userCand.get();
+      const PATObjectShifts* own = embedded(object);
+      if (own)
+        return own->candidate(0, name, object);
+      const edm::RefProd<PATObjectShifts>* shifts =
+        object.template userData<edm::RefProd<PATObjectShifts> >("shifts");
+      if (!shifts || shifts->isNull() || !object.hasUserInt("shiftsIndex"))
+        return NULL;
+      return (*shifts)->candidate(object.userInt("shiftsIndex"), name, object);
+    }
+
+  private:
+    void checkIndex(size_t i, size_t shift) const;
+    std::vector<std::string> shifts_;
+    unsigned int nObjects_;
+    // [object][shift][px, py, pz, E], NaN if missing
+    std::vector<float> values_;
+    // Transient, see candidate(..)
+    mutable std::map<unsigned int, reco::LeafCandidate> candidates_;
+};
+
+#endif
@@ -23,6 +23,14 @@ class PATPairFinalStateT : public PATFinalState {
       return new PATPairFinalStateT<T1, T2>(*this);
     }
 
+    virtual PATPairFinalStateT<T1, T2>* rebuild(
+        const std::vector<reco::CandidatePtr>& legs,
+        const edm::Ptr<PATFinalStateEvent>& evt) const {
+      return new PATPairFinalStateT<T1, T2>(
+          edm::Ptr<T1>(legs.at(0)),
+          edm::Ptr<T2>(legs.at(1)), evt);
+    }
+
     virtual const reco::Candidate* daughterUnsafe(size_t i) const {
       const reco::Candidate* output = NULL;
       if (i == 0)
@@ -30,6 +30,16 @@ class PATQuadFinalStateT : public PATFinalState {
       return new PATQuadFinalStateT<T1, T2, T3, T4>(*this);
     }
 
+    virtual PATQuadFinalStateT<T1, T2, T3, T4>* rebuild(
+        const std::vector<reco::CandidatePtr>& legs,
+        const edm::Ptr<PATFinalStateEvent>& evt) const {
+      return new PATQuadFinalStateT<T1, T2, T3, T4>(
+          edm::Ptr<T1>(legs.at(0)),
+          edm::Ptr<T2>(legs.at(1)),
+          edm::Ptr<T3>(legs.at(2)),
+          edm::Ptr<T4>(legs.at(3)), evt);
+    }
+
     virtual const reco::Candidate* daughterUnsafe(size_t i) const {
       const reco::Candidate* output = NULL;
       if (i == 0)
@@ -26,6 +26,15 @@ class PATTripletFinalStateT : public PATFinalState {
       return new PATTripletFinalStateT<T1, T2, T3>(*this);
     }
 
+    virtual PATTripletFinalStateT<T1, T2, T3>* rebuild(
+        const std::vector<reco::CandidatePtr>& legs,
+        const edm::Ptr<PATFinalStateEvent>& evt) const {
+      return new PATTripletFinalStateT<T1, T2, T3>(
+          edm::Ptr<T1>(legs.at(0)),
+          edm::Ptr<T2>(legs.at(1)),
+          edm::Ptr<T3>(legs.at(2)), evt);
+    }
+
     virtual const reco::Candidate* daughterUnsafe(size_t i) const {
       const reco::Candidate* output = NULL;
       if (i == 0)
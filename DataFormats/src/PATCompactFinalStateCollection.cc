@@ -0,0 +1,228 @@
+#include "FinalStateAnalysis/DataFormats/interface/PATCompactFinalStateCollection.h"
+#include "FinalStateAnalysis/DataFormats/interface/PATFinalState.h"
+#include "FinalStateAnalysis/DataFormats/interface/PATFinalStateEvent.h"
+#include "FinalStateAnalysis/DataFormats/interface/PATMultiCandFinalState.h"
+
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <typeinfo>
+
+namespace {
+  // Find the column index of [name], or -1 if it d.n.e.
+  int findColumn(const std::vector<std::string>& names,
+      const std::string& name) {
+    std::vector<std::string>::const_iterator findit =
+      std::find(names.begin(), names.end(), name);
+    if (findit == names.end())
+      return -1;
+    return findit - names.begin();
+  }
+}
+
+PATCompactFinalStateCollection::PATCompactFinalStateCollection():
+  nLegs_(0),nRows_(0){}
+
+PATCompactFinalStateCollection::PATCompactFinalStateCollection(
+    size_t nLegs, const edm::Ptr<PATFinalStateEvent>& evt):
+  nLegs_(nLegs),nRows_(0),event_(evt) {}
+
+size_t PATCompactFinalStateCollection::legIndex(size_t i, size_t leg) const {
+  if (i >= nRows_ || leg >= nLegs_) {
+    throw cms::Exception("CandidateIndexOutOfRange")
+      << "PATCompactFinalStateCollection: leg " << leg << " of final state "
+      << i << " is out of range (" << nRows_ << " final states with "
+      << (int)nLegs_ << " legs)" << std::endl;
+  }
+  return i*nLegs_ + leg;
+}
+
+size_t PATCompactFinalStateCollection::addLegProduct(
+    const reco::CandidatePtr& leg) {
+  for (size_t i = 0; i < legProducts_.size(); ++i) {
+    if (legProducts_[i].id() == leg.id())
+      return i;
+  }
+  if (legProducts_.size() >= std::numeric_limits<unsigned char>::max()) {
+    throw cms::Exception("TooManyProducts")
+      << "PATCompactFinalStateCollection: legs come from too many "
+      << "different input collections!" << std::endl;
+  }
+  legProducts_.push_back(leg);
+  return legProducts_.size() - 1;
+}
+
+void PATCompactFinalStateCollection::push_back(
+    const PATFinalState& finalState) {
+  if (finalState.numberOfDaughters() != nLegs_) {
+    throw cms::Exception("BadFinalState")
+      << "PATCompactFinalStateCollection::push_back() final state has "
+      << finalState.numberOfDaughters() << " legs, expected "
+      << (int)nLegs_ << std::endl;
+  }
+  if (!prototype_.empty() && typeid(finalState) != typeid(prototype_[0])) {
+    throw cms::Exception("BadFinalState")
+      << "PATCompactFinalStateCollection::push_back() final state has type "
+      << typeid(finalState).name() << ", expected "
+      << typeid(prototype_[0]).name() << std::endl;
+  }
+  if (event_.isNull())
+    event_ = finalState.evt();
+
+  std::vector<reco::CandidatePtr> legs;
+  legs.reserve(nLegs_);
+  for (size_t leg = 0; leg < nLegs_; ++leg) {
+    const reco::CandidatePtr dau = finalState.daughterPtr(leg);
+    legProductIdx_.push_back(addLegProduct(dau));
+    legKeys_.push_back(dau.key());
+    legs.push_back(dau);
+  }
+  if (prototype_.empty())
+    prototype_.push_back(finalState.rebuild(legs, event_));
+
+  // Add the user data, making new columns if necessary.  Every column is
+  // padded to the new number of rows afterwards.
+  const std::vector<std::string>& floatNames = finalState.userFloatNames();
+  for (size_t i = 0; i < floatNames.size(); ++i) {
+    int column = findColumn(userFloatNames_, floatNames[i]);
+    if (column < 0) {
+      userFloatNames_.push_back(floatNames[i]);
+      userFloatColumns_.push_back(std::vector<float>(nRows_,
+            std::numeric_limits<float>::quiet_NaN()));
+      userFloatPresent_.push_back(std::vector<unsigned char>(nRows_, 0));
+      column = userFloatColumns_.size() - 1;
+    }
+    userFloatColumns_[column].push_back(finalState.userFloat(floatNames[i]));
+    userFloatPresent_[column].push_back(1);
+  }
+  const std::vector<std::string>& candNames = finalState.userCandNames();
+  for (size_t i = 0; i < candNames.size(); ++i) {
+    int column = findColumn(userCandNames_, candNames[i]);
+    if (column < 0) {
+      userCandNames_.push_back(candNames[i]);
+      userCandColumns_.push_back(
+          std::vector<reco::CandidatePtr>(nRows_));
+      column = userCandColumns_.size() - 1;
+    }
+    userCandColumns_[column].push_back(finalState.userCand(candNames[i]));
+  }
+  const std::vector<std::string>& labels = finalState.overlapLabels();
+  for (size_t i = 0; i < labels.size(); ++i) {
+    int column = findColumn(overlapLabels_, labels[i]);
+    if (column < 0) {
+      overlapLabels_.push_back(labels[i]);
+      overlapColumns_.push_back(
+          std::vector<reco::CandidatePtrVector>(nRows_));
+      column = overlapColumns_.size() - 1;
+    }
+    overlapColumns_[column].push_back(finalState.overlaps(labels[i]));
+  }
+
+  ++nRows_;
+  for (size_t i = 0; i < userFloatColumns_.size(); ++i) {
+    userFloatColumns_[i].resize(nRows_,
+        std::numeric_limits<float>::quiet_NaN());
+    userFloatPresent_[i].resize(nRows_, 0);
+  }
+  for (size_t i = 0; i < userCandColumns_.size(); ++i) {
+    userCandColumns_[i].resize(nRows_);
+  }
+  for (size_t i = 0; i < overlapColumns_.size(); ++i) {
+    overlapColumns_[i].resize(nRows_);
+  }
+}
+
+reco::CandidatePtr
+PATCompactFinalStateCollection::daughterPtr(size_t i, size_t leg) const {
+  size_t idx = legIndex(i, leg);
+  const reco::CandidatePtr& product = legProducts_[legProductIdx_[idx]];
+  return reco::CandidatePtr(product.id(), legKeys_[idx],
+      product.productGetter());
+}
+
+unsigned int
+PATCompactFinalStateCollection::daughterKey(size_t i, size_t leg) const {
+  return legKeys_[legIndex(i, leg)];
+}
+
+bool PATCompactFinalStateCollection::userFloatPresent(
+    size_t column, size_t i) const {
+  // Collections written before the presence mask was stored only have the
+  // NaN padding to go by.
+  if (column >= userFloatPresent_.size())
+    return !std::isnan(userFloatColumns_[column][i]);
+  return userFloatPresent_[column][i];
+}
+
+bool PATCompactFinalStateCollection::hasUserFloat(
+    size_t i, const std::string& name) const {
+  int column = findColumn(userFloatNames_, name);
+  if (column < 0 || i >= nRows_)
+    return false;
+  return userFloatPresent(column, i);
+}
+
+float PATCompactFinalStateCollection::userFloat(
+    size_t i, const std::string& name) const {
+  return userFloatColumn(name).at(i);
+}
+
+const std::vector<float>& PATCompactFinalStateCollection::userFloatColumn(
+    const std::string& name) const {
+  int column = findColumn(userFloatNames_, name);
+  if (column < 0) {
+    throw cms::Exception("MissingUserFloat")
+      << "PATCompactFinalStateCollection: no userFloat column named "
+      << name << std::endl;
+  }
+  return userFloatColumns_[column];
+}
+
+reco::CandidatePtr PATCompactFinalStateCollection::userCand(
+    size_t i, const std::string& name) const {
+  int column = findColumn(userCandNames_, name);
+  if (column < 0 || i >= nRows_)
+    return reco::CandidatePtr();
+  return userCandColumns_[column][i];
+}
+
+const reco::CandidatePtrVector& PATCompactFinalStateCollection::overlaps(
+    size_t i, const std::string& label) const {
+  static const reco::CandidatePtrVector empty;
+  int column = findColumn(overlapLabels_, label);
+  if (column < 0 || i >= nRows_)
+    return empty;
+  return overlapColumns_[column][i];
+}
+
+PATFinalStateProxy PATCompactFinalStateCollection::finalState(size_t i) const {
+  std::vector<reco::CandidatePtr> legs;
+  legs.reserve(nLegs_);
+  for (size_t leg = 0; leg < nLegs_; ++leg) {
+    legs.push_back(daughterPtr(i, leg));
+  }
+  // Recomputes the charge and p4 from the legs.  Collections written before
+  // the prototype was stored fall back to the generic type.
+  PATFinalState* output = NULL;
+  if (!prototype_.empty())
+    output = prototype_[0].rebuild(legs, event_);
+  else
+    output = new PATMultiCandFinalState(legs, event_);
+  for (size_t c = 0; c < userFloatColumns_.size(); ++c) {
+    if (userFloatPresent(c, i))
+      output->addUserFloat(userFloatNames_[c], userFloatColumns_[c][i]);
+  }
+  for (size_t c = 0; c < userCandColumns_.size(); ++c) {
+    const reco::CandidatePtr& cand = userCandColumns_[c][i];
+    if (cand.isNonnull())
+      output->addUserCand(userCandNames_[c], cand);
+  }
+  for (size_t c = 0; c < overlapColumns_.size(); ++c) {
+    const reco::CandidatePtrVector& overlaps = overlapColumns_[c][i];
+    if (!overlaps.empty())
+      output->setOverlaps(overlapLabels_[c], overlaps);
+  }
+  return PATFinalStateProxy(output);
+}
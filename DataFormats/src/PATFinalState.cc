@@ -1,6 +1,8 @@
 #include "FinalStateAnalysis/DataFormats/interface/PATFinalState.h"
 #include "FinalStateAnalysis/DataFormats/interface/PATFinalStateEvent.h"
 #include "FinalStateAnalysis/DataFormats/interface/PATMultiCandFinalState.h"
+#include "FinalStateAnalysis/DataFormats/interface/PATObjectShifts.h"
+#include "FinalStateAnalysis/DataFormats/interface/PATMETShifts.h"
 
 #include "FinalStateAnalysis/DataAlgos/interface/helpers.h"
 #include "FinalStateAnalysis/DataAlgos/interface/CollectionFilter.h"
@@ -9,6 +11,7 @@
 #include "DataFormats/PatCandidates/interface/Electron.h"
 #include "DataFormats/PatCandidates/interface/Muon.h"
 #include "DataFormats/PatCandidates/interface/Tau.h"
+#include "DataFormats/PatCandidates/interface/Photon.h"
 #include "DataFormats/PatCandidates/interface/MET.h"
 #include "DataFormats/PatCandidates/interface/Jet.h"
 
@@ -49,6 +52,38 @@ namespace {
         return c1->pt() > c2->pt();
       }
   };
+
+  // Get a shifted p4 stored in the compact PATObjectShifts of a PAT object
+  bool compactShiftedP4(const reco::Candidate* cand, const std::string& tag,
+      reco::Candidate::LorentzVector& output) {
+    if (const pat::Electron* ele = dynamic_cast<const pat::Electron*>(cand))
+      return PATObjectShifts::shiftedP4(*ele, tag, output);
+    if (const pat::Muon* muon = dynamic_cast<const pat::Muon*>(cand))
+      return PATObjectShifts::shiftedP4(*muon, tag, output);
+    if (const pat::Tau* tau = dynamic_cast<const pat::Tau*>(cand))
+      return PATObjectShifts::shiftedP4(*tau, tag, output);
+    if (const pat::Jet* jet = dynamic_cast<const pat::Jet*>(cand))
+      return PATObjectShifts::shiftedP4(*jet, tag, output);
+    if (const pat::Photon* pho = dynamic_cast<const pat::Photon*>(cand))
+      return PATObjectShifts::shiftedP4(*pho, tag, output);
+    return false;
+  }
+
+  // Same, but get the shifted candidate (owned by the PATObjectShifts)
+  const reco::Candidate* compactShiftedCand(const reco::Candidate* cand,
+      const std::string& tag) {
+    if (const pat::Electron* ele = dynamic_cast<const pat::Electron*>(cand))
+      return PATObjectShifts::shiftedCand(*ele, tag);
+    if (const pat::Muon* muon = dynamic_cast<const pat::Muon*>(cand))
+      return PATObjectShifts::shiftedCand(*muon, tag);
+    if (const pat::Tau* tau = dynamic_cast<const pat::Tau*>(cand))
+      return PATObjectShifts::shiftedCand(*tau, tag);
+    if (const pat::Jet* jet = dynamic_cast<const pat::Jet*>(cand))
+      return PATObjectShifts::shiftedCand(*jet, tag);
+    if (const pat::Photon* pho = dynamic_cast<const pat::Photon*>(cand))
+      return PATObjectShifts::shiftedCand(*pho, tag);
+    return NULL;
+  }
 }
 
 // empty constructor
@@ -89,26 +124,39 @@ const reco::CandidatePtr PATFinalState::daughterPtr(size_t i) const {
 const reco::CandidatePtr
 PATFinalState::daughterUserCand(size_t i, const std::string& tag) const {
   const reco::CandidatePtr output = daughterUserCandUnsafe(i, tag);
-  if (output.isNull())
+  if (output.isNonnull())
+    return output;
+  // Compact shifts: a transient Ptr to the shifted candidate
+  const reco::Candidate* shifted = compactShiftedCand(daughter(i), tag);
+  if (!shifted)
     throw cms::Exception("NullDaughter") <<
       "PATFinalState::daughterUserCand(" << i << ","
       << tag << ") is null!" << std::endl;
-  return output;
+  return reco::CandidatePtr(edm::ProductID(), shifted, 0);
 }
 
 bool
 PATFinalState::daughterHasUserCand(size_t i, const std::string& tag) const {
   reco::CandidatePtr userCand = daughterUserCandUnsafe(i, tag);
-  return userCand.isNonnull();
+  if (userCand.isNonnull())
+    return true;
+  LorentzVector unused;
+  return compactShiftedP4(daughter(i), tag, unused);
 }
 
-const PATFinalState::LorentzVector&
+PATFinalState::LorentzVector
 PATFinalState::daughterUserCandP4(size_t i, const std::string& tag) const {
   if (tag == "")
     return daughter(i)->p4();
-  reco::CandidatePtr userCand = daughterUserCand(i, tag);
-  assert(userCand.isNonnull());
-  return userCand->p4();
+  reco::CandidatePtr userCand = daughterUserCandUnsafe(i, tag);
+  if (userCand.isNonnull())
+    return userCand->p4();
+  LorentzVector output;
+  if (!compactShiftedP4(daughter(i), tag, output))
+    throw cms::Exception("NullDaughter") <<
+      "PATFinalState::daughterUserCandP4(" << i << ","
+      << tag << ") is null!" << std::endl;
+  return output;
 }
 
 std::vector<const reco::Candidate*> PATFinalState::daughters() const {
@@ -199,8 +247,9 @@ std::vector<size_t> PATFinalState::indicesByPt(const std::string& tags) const {
     daughtersToSort = daughters(tags);
   }
   std::vector<size_t> indices;
-  indices.reserve(3);
-  indices.push_back(0); indices.push_back(1); indices.push_back(2);
+  indices.reserve(daughtersToSort.size());
+  for (size_t i = 0; i < daughtersToSort.size(); ++i)
+    indices.push_back(i);
 
   std::sort(indices.begin(), indices.end(),
       CandPtIndexOrdering(daughtersToSort));
@@ -262,7 +311,7 @@ PATFinalState::LorentzVector
 PATFinalState::visP4(const std::string& tags) const {
   LorentzVector output;
   std::vector<const reco::Candidate*> theDaughters = daughters(tags);
-  for (size_t i = 0; i < numberOfDaughters(); ++i) {
+  for (size_t i = 0; i < theDaughters.size(); ++i) {
     output += theDaughters[i]->p4();
   }
   return output;
@@ -282,9 +331,7 @@ PATFinalState::LorentzVector PATFinalState::totalP4(
     const std::string& tags, const std::string& metSysTag) const {
   reco::Candidate::LorentzVector output = visP4(tags);
   if (metSysTag != "" && metSysTag != "@") {
-    const reco::CandidatePtr& metUserCand = met()->userCand(metSysTag);
-    assert(metUserCand.isNonnull());
-    output += metUserCand->p4();
+    output += metshifts::p4(*met(), metSysTag);
   } else {
     output += met()->p4();
   }
@@ -374,9 +421,7 @@ PATFinalState::deltaPhiToMEt(int i, const std::string& sysTag,
     const std::string& metTag) const {
   double metPhi = met()->phi();
   if (metTag != "") {
-    const reco::CandidatePtr& metUserCand = met()->userCand(metTag);
-    assert(metUserCand.isNonnull());
-    metPhi = metUserCand->phi();
+    metPhi = metshifts::p4(*met(), metTag).phi();
   }
   return reco::deltaPhi(daughterUserCandP4(i, sysTag).phi(), metPhi);
 }
@@ -402,7 +447,7 @@ double PATFinalState::mtMET(int i, const std::string& tag,
     const std::string& metTag) const {
   if (metTag != "") {
     return fshelpers::transverseMass(daughterUserCandP4(i, tag),
-        met()->userCand(metTag)->p4());
+        metshifts::p4(*met(), metTag));
   } else {
     return fshelpers::transverseMass(daughterUserCandP4(i, tag),
         met()->p4());
@@ -412,7 +457,7 @@ double PATFinalState::mtMET(int i, const std::string& tag,
 double PATFinalState::mtMET(int i, const std::string& metTag) const {
   if (metTag != "") {
     return fshelpers::transverseMass(daughterUserCandP4(i, ""),
-        met()->userCand(metTag)->p4());
+        metshifts::p4(*met(), metTag));
   } else {
     return fshelpers::transverseMass(daughterUserCandP4(i, ""), met()->p4());
   }
@@ -428,7 +473,7 @@ double PATFinalState::mtMET(int i, const std::string& tag,
 double PATFinalState::ht(const std::string& sysTags) const {
   std::vector<const reco::Candidate*> theDaughters = daughters(sysTags);
   double output = 0;
-  for (size_t i = 0; i < numberOfDaughters(); ++i) {
+  for (size_t i = 0; i < theDaughters.size(); ++i) {
     output += theDaughters[i]->pt();
   }
   return output;
@@ -0,0 +1,125 @@
+#include "FinalStateAnalysis/DataFormats/interface/PATFinalStateAssociation.h"
+#include "FinalStateAnalysis/DataFormats/interface/PATFinalState.h"
+
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace {
+  // Find the column index of [name], or -1 if it d.n.e.
+  int findColumn(const std::vector<std::string>& names,
+      const std::string& name) {
+    std::vector<std::string>::const_iterator findit =
+      std::find(names.begin(), names.end(), name);
+    if (findit == names.end())
+      return -1;
+    return findit - names.begin();
+  }
+}
+
+PATFinalStateAssociation::PATFinalStateAssociation():size_(0){}
+
+PATFinalStateAssociation::PATFinalStateAssociation(
+    const edm::ProductID& src, size_t size):
+  src_(src),size_(size){}
+
+void PATFinalStateAssociation::checkIndex(size_t i) const {
+  if (i >= size_) {
+    throw cms::Exception("FinalStateIndexOutOfRange")
+      << "PATFinalStateAssociation: final state index " << i
+      << " is out of range for an association to " << size_
+      << " final states" << std::endl;
+  }
+}
+
+void PATFinalStateAssociation::addUserFloat(
+    size_t i, const std::string& name, float value) {
+  checkIndex(i);
+  int column = findColumn(userFloatNames_, name);
+  if (column < 0) {
+    userFloatNames_.push_back(name);
+    userFloatColumns_.push_back(std::vector<float>(size_,
+          std::numeric_limits<float>::quiet_NaN()));
+    userFloatPresent_.push_back(std::vector<unsigned char>(size_, 0));
+    column = userFloatColumns_.size() - 1;
+  }
+  userFloatColumns_[column][i] = value;
+  userFloatPresent_[column][i] = 1;
+}
+
+void PATFinalStateAssociation::setOverlaps(size_t i, const std::string& label,
+    const reco::CandidatePtrVector& overlaps) {
+  checkIndex(i);
+  int column = findColumn(overlapLabels_, label);
+  if (column < 0) {
+    overlapLabels_.push_back(label);
+    overlapColumns_.push_back(
+        std::vector<reco::CandidatePtrVector>(size_));
+    column = overlapColumns_.size() - 1;
+  }
+  overlapColumns_[column][i] = overlaps;
+}
+
+bool PATFinalStateAssociation::hasUserFloat(
+    size_t i, const std::string& name) const {
+  int column = findColumn(userFloatNames_, name);
+  if (column < 0 || i >= size_)
+    return false;
+  return userFloatPresent_[column][i];
+}
+
+float PATFinalStateAssociation::userFloat(
+    size_t i, const std::string& name) const {
+  if (!hasUserFloat(i, name))
+    return 0.0;
+  return userFloatColumns_[findColumn(userFloatNames_, name)][i];
+}
+
+bool PATFinalStateAssociation::hasOverlaps(
+    size_t i, const std::string& label) const {
+  // Like pat::PATObject, empty overlaps are not stored
+  return !overlaps(i, label).empty();
+}
+
+const reco::CandidatePtrVector& PATFinalStateAssociation::overlaps(
+    size_t i, const std::string& label) const {
+  int column = findColumn(overlapLabels_, label);
+  if (column < 0 || i >= size_)
+    return emptyOverlaps_;
+  return overlapColumns_[column][i];
+}
+
+void PATFinalStateAssociation::merge(const PATFinalStateAssociation& other) {
+  if (other.src() != src_ || other.size() != size_) {
+    throw cms::Exception("MismatchedAssociation")
+      << "PATFinalStateAssociation::merge() can only merge associations "
+      << "to the same final state collection" << std::endl;
+  }
+  for (size_t c = 0; c < other.userFloatNames_.size(); ++c) {
+    const std::vector<float>& column = other.userFloatColumns_[c];
+    const std::vector<unsigned char>& present = other.userFloatPresent_[c];
+    for (size_t i = 0; i < size_; ++i) {
+      if (present[i])
+        addUserFloat(i, other.userFloatNames_[c], column[i]);
+    }
+  }
+  for (size_t c = 0; c < other.overlapLabels_.size(); ++c) {
+    for (size_t i = 0; i < size_; ++i) {
+      setOverlaps(i, other.overlapLabels_[c], other.overlapColumns_[c][i]);
+    }
+  }
+}
+
+void PATFinalStateAssociation::embedInto(
+    size_t i, PATFinalState& finalState) const {
+  checkIndex(i);
+  for (size_t c = 0; c < userFloatNames_.size(); ++c) {
+    if (userFloatPresent_[c][i])
+      finalState.addUserFloat(userFloatNames_[c], userFloatColumns_[c][i]);
+  }
+  for (size_t c = 0; c < overlapLabels_.size(); ++c) {
+    if (!overlapColumns_[c][i].empty())
+      finalState.setOverlaps(overlapLabels_[c], overlapColumns_[c][i]);
+  }
+}
@@ -1,10 +1,13 @@
 #include "FinalStateAnalysis/DataFormats/interface/PATFinalStateEvent.h"
+#include "FinalStateAnalysis/DataFormats/interface/PATMETShifts.h"
 #include "FinalStateAnalysis/DataAlgos/interface/SmartTrigger.h"
 #include "FinalStateAnalysis/DataAlgos/interface/PileupWeighting.h"
 #include "FinalStateAnalysis/DataAlgos/interface/PileupWeighting3D.h"
 #include "FinalStateAnalysis/DataAlgos/interface/helpers.h"
 #include "FinalStateAnalysis/DataAlgos/interface/Hash.h"
 
+#include "FWCore/Utilities/interface/Exception.h"
+
 #include "DataFormats/Math/interface/deltaR.h"
 
 #define FSA_DATA_FORMAT_VERSION 3
@@ -30,9 +33,11 @@ PATFinalStateEvent::PATFinalStateEvent() {}
 // testing CTOR
 PATFinalStateEvent::PATFinalStateEvent(
     const edm::Ptr<reco::Vertex>& pv,
-    const edm::Ptr<pat::MET>& met):
+    const edm::Ptr<pat::MET>& met,
+    const std::map<std::string, edm::Ptr<pat::MET> >& mets):
   pv_(pv),
-  met_(met) { }
+  met_(met),
+  mets_(mets) { }
 
 PATFinalStateEvent::PATFinalStateEvent(
     double rho,
@@ -142,7 +147,24 @@ const reco::Candidate::LorentzVector PATFinalStateEvent::met4vector(
   if (findit == mets_.end())
     return reco::Candidate::LorentzVector();
 
-  const reco::Candidate::LorentzVector& metp4 = (tag == "") ? met(type)->p4() : met(type)->userCand(tag)->p4();
+  const reco::Candidate::LorentzVector metp4 = (tag == "") ? findit->second->p4() : metshifts::p4(*findit->second, tag);
+  if (applyPhiCorr == 1)
+    return fshelpers::metPhiCorrection(metp4, recoVertices_.size(), !isRealData_);
+
+  return metp4;
+}
+
+const reco::Candidate::LorentzVector PATFinalStateEvent::metShift(
+    const std::string& type,
+    int shift,
+    const int applyPhiCorr) const {
+  std::map<std::string, edm::Ptr<pat::MET> >::const_iterator findit =
+    mets_.find(type);
+  if (findit == mets_.end())
+    return reco::Candidate::LorentzVector();
+
+  const reco::Candidate::LorentzVector metp4 =
+    metshifts::p4(*findit->second, shift);
   if (applyPhiCorr == 1)
     return fshelpers::metPhiCorrection(metp4, recoVertices_.size(), !isRealData_);
 
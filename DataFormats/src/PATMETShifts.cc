@@ -0,0 +1,62 @@
+#include "FinalStateAnalysis/DataFormats/interface/PATMETShifts.h"
+#include "FinalStateAnalysis/DataFormats/interface/PATObjectShifts.h"
+
+#include "DataFormats/PatCandidates/interface/MET.h"
+
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include <algorithm>
+
+namespace {
+  const char* kNames[metshifts::kNShifts] = {
+    "raw", "type1",
+    "mes+", "mes-",
+    "ees+", "ees-",
+    "tes+", "tes-",
+    "jes+", "jes-",
+    "ues+", "ues-"
+  };
+}
+
+const std::vector<std::string>& metshifts::names() {
+  static const std::vector<std::string> output(kNames, kNames + kNShifts);
+  return output;
+}
+
+const std::string& metshifts::name(int shift) {
+  if (shift < 0 || shift >= kNShifts) {
+    throw cms::Exception("UnknownMETShift")
+      << "metshifts::name: " << shift << " is not a MET shift" << std::endl;
+  }
+  return names()[shift];
+}
+
+int metshifts::index(const std::string& name) {
+  const std::vector<std::string>& all = names();
+  std::vector<std::string>::const_iterator findit =
+    std::find(all.begin(), all.end(), name);
+  if (findit == all.end())
+    return -1;
+  return findit - all.begin();
+}
+
+reco::Candidate::LorentzVector metshifts::p4(const pat::MET& met,
+    const std::string& tag) {
+  reco::Candidate::LorentzVector output;
+  if (!PATObjectShifts::shiftedP4(met, tag, output)) {
+    throw cms::Exception("MissingShift")
+      << "The MET has no " << tag << " variation" << std::endl;
+  }
+  return output;
+}
+
+reco::Candidate::LorentzVector metshifts::p4(const pat::MET& met,
+    int shift) {
+  const std::string& tag = name(shift);
+  // The compact shifts are stored in enum order
+  const PATObjectShifts* shifts = PATObjectShifts::embedded(met);
+  if (shifts && shifts->shifts().size() == kNShifts
+      && shifts->shifts()[shift] == tag && shifts->hasP4(0, shift))
+    return shifts->p4(0, shift);
+  return p4(met, tag);
+}
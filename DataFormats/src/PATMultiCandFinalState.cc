@@ -32,6 +32,12 @@ PATMultiCandFinalState* PATMultiCandFinalState::clone() const {
   return new PATMultiCandFinalState(*this);
 }
 
+PATMultiCandFinalState* PATMultiCandFinalState::rebuild(
+    const std::vector<reco::CandidatePtr>& legs,
+    const edm::Ptr<PATFinalStateEvent>& evt) const {
+  return new PATMultiCandFinalState(legs, evt);
+}
+
 const reco::Candidate* PATMultiCandFinalState::daughterUnsafe(size_t i) const {
   try {
     return cands_.at(i).get();
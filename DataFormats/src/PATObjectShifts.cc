@@ -0,0 +1,83 @@
+#include "FinalStateAnalysis/DataFormats/interface/PATObjectShifts.h"
+
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+PATObjectShifts::PATObjectShifts():nObjects_(0){}
+
+PATObjectShifts::PATObjectShifts(const std::vector<std::string>& shifts,
+    size_t nObjects):
+  shifts_(shifts),nObjects_(nObjects),
+  values_(4*shifts.size()*nObjects, std::numeric_limits<float>::quiet_NaN()){}
+
+int PATObjectShifts::index(const std::string& name) const {
+  std::vector<std::string>::const_iterator findit =
+    std::find(shifts_.begin(), shifts_.end(), name);
+  if (findit == shifts_.end())
+    return -1;
+  return findit - shifts_.begin();
+}
+
+void PATObjectShifts::checkIndex(size_t i, size_t shift) const {
+  if (i >= nObjects_ || shift >= shifts_.size()) {
+    throw cms::Exception("ShiftIndexOutOfRange")
+      << "PATObjectShifts: entry (" << i << ", " << shift
+      << ") is out of range for " << nObjects_ << " objects and "
+      << shifts_.size() << " shifts" << std::endl;
+  }
+}
+
+void PATObjectShifts::setP4(size_t i, size_t shift, const LorentzVector& p4) {
+  checkIndex(i, shift);
+  std::vector<float>::iterator entry =
+    values_.begin() + 4*(i*shifts_.size() + shift);
+  entry[0] = p4.px();
+  entry[1] = p4.py();
+  entry[2] = p4.pz();
+  entry[3] = p4.energy();
+}
+
+bool PATObjectShifts::hasP4(size_t i, size_t shift) const {
+  checkIndex(i, shift);
+  return !std::isnan(values_[4*(i*shifts_.size() + shift) + 3]);
+}
+
+PATObjectShifts::LorentzVector
+PATObjectShifts::p4(size_t i, size_t shift) const {
+  if (!hasP4(i, shift)) {
+    throw cms::Exception("MissingShift")
+      << "PATObjectShifts: shift " << shifts_[shift]
+      << " of object " << i << " was never set" << std::endl;
+  }
+  std::vector<float>::const_iterator entry =
+    values_.begin() + 4*(i*shifts_.size() + shift);
+  return LorentzVector(entry[0], entry[1], entry[2], entry[3]);
+}
+
+bool PATObjectShifts::p4(size_t i, const std::string& name,
+    LorentzVector& output) const {
+  int shift = index(name);
+  if (shift < 0 || i >= nObjects_ || !hasP4(i, shift))
+    return false;
+  output = p4(i, shift);
+  return true;
+}
+
+const reco::Candidate* PATObjectShifts::candidate(size_t i,
+    const std::string& name, const reco::Candidate& object) const {
+  int shift = index(name);
+  if (shift < 0 || i >= nObjects_ || !hasP4(i, shift))
+    return NULL;
+  unsigned int entry = i*shifts_.size() + shift;
+  std::map<unsigned int, reco::LeafCandidate>::iterator cached =
+    candidates_.find(entry);
+  if (cached == candidates_.end()) {
+    reco::LeafCandidate shifted(object);
+    shifted.setP4(p4(i, shift));
+    cached = candidates_.insert(std::make_pair(entry, shifted)).first;
+  }
+  return &cached->second;
+}
@@ -8,6 +8,10 @@
 
 #include "FinalStateAnalysis/DataFormats/interface/PATFinalStateEvent.h"
 
+#include "FinalStateAnalysis/DataFormats/interface/PATCompactFinalStateCollection.h"
+#include "FinalStateAnalysis/DataFormats/interface/PATFinalStateAssociation.h"
+#include "FinalStateAnalysis/DataFormats/interface/PATObjectShifts.h"
+
 #include "FinalStateAnalysis/DataFormats/interface/PATFinalStateLS.h"
 
 #include "FinalStateAnalysis/DataFormats/interface/PATDiLeptonFinalStates.h"
@@ -51,6 +55,25 @@ namespace {
     FWD_CLASSDECL(PATFinalStateEvent)
     FWD_CLASSDECL(PATFinalStateLS)
 
+    // compact (columnar) final states
+    PATCompactFinalStateCollection dummyCompactFinalStates;
+    edm::Wrapper<PATCompactFinalStateCollection> dummyCompactFinalStatesW;
+    std::vector<std::vector<reco::CandidatePtr> > dummyCandPtrColumns;
+    std::vector<std::vector<unsigned char> > dummyPresenceColumns;
+
+    // final state user data associations
+    PATFinalStateAssociation dummyFinalStateAssociation;
+    edm::Wrapper<PATFinalStateAssociation> dummyFinalStateAssociationW;
+    std::vector<reco::CandidatePtrVector> dummyCandPtrVectorColumn;
+    std::vector<std::vector<reco::CandidatePtrVector> > dummyCandPtrVectorColumns;
+
+    // compact systematic shifts of PAT objects
+    PATObjectShifts dummyObjectShifts;
+    edm::Wrapper<PATObjectShifts> dummyObjectShiftsW;
+    edm::RefProd<PATObjectShifts> dummyObjectShiftsRefProd;
+    pat::UserHolder<edm::RefProd<PATObjectShifts> > dummyObjectShiftsHolder;
+    pat::UserHolder<PATObjectShifts> dummyEmbeddedObjectShiftsHolder;
+
     // n-cand state
     FWD_CLASSDECL(PATMultiCandFinalState)
 
@@ -4,12 +4,22 @@
 
 #include <cppunit/extensions/HelperMacros.h>
 #include <Utilities/Testing/interface/CppUnit_testdriver.icpp>
+#include <cmath>
+#include <limits>
 #include <vector>
+#include <map>
+#include <memory>
+#include <typeinfo>
+#include <boost/shared_ptr.hpp>
 
 #include "FinalStateAnalysis/DataFormats/interface/PATFinalStateEvent.h"
 
 #include "FinalStateAnalysis/DataFormats/interface/PATDiLeptonFinalStates.h"
 #include "FinalStateAnalysis/DataFormats/interface/PATTriLeptonFinalStates.h"
+#include "FinalStateAnalysis/DataFormats/interface/PATCompactFinalStateCollection.h"
+#include "FinalStateAnalysis/DataFormats/interface/PATFinalStateAssociation.h"
+#include "FinalStateAnalysis/DataFormats/interface/PATObjectShifts.h"
+#include "FinalStateAnalysis/DataFormats/interface/PATMETShifts.h"
 
 #include "DataFormats/Math/interface/Vector3D.h"
 
@@ -24,6 +34,27 @@
 
 using namespace edm;
 
+// Resolves Ptrs that only know their (ProductID, key), like the legs rebuilt
+// by a PATCompactFinalStateCollection.
+class MockProductGetter : public EDProductGetter {
+  public:
+    template<typename T>
+    void add(const ProductID& id, const std::vector<T>& coll) {
+      std::auto_ptr<std::vector<T> > copy(new std::vector<T>(coll));
+      products_[id] = boost::shared_ptr<EDProduct>(
+          new Wrapper<std::vector<T> >(copy));
+    }
+    virtual EDProduct const* getIt(ProductID const& id) const {
+      std::map<ProductID, boost::shared_ptr<EDProduct> >::const_iterator
+        found = products_.find(id);
+      if (found == products_.end())
+        return 0;
+      return found->second.get();
+    }
+  private:
+    std::map<ProductID, boost::shared_ptr<EDProduct> > products_;
+};
+
 class testFinalState: public CppUnit::TestFixture {
   CPPUNIT_TEST_SUITE(testFinalState);
   CPPUNIT_TEST(checkSetup);
@@ -31,6 +62,12 @@ class testFinalState: public CppUnit::TestFixture {
   CPPUNIT_TEST(testTriLepton);
   CPPUNIT_TEST(testOverlaps);
   CPPUNIT_TEST(testIndexGetter);
+  CPPUNIT_TEST(testCompact);
+  CPPUNIT_TEST(testCompactRebuild);
+  CPPUNIT_TEST(testAssociation);
+  CPPUNIT_TEST(testShifts);
+  CPPUNIT_TEST(testShiftModes);
+  CPPUNIT_TEST(testMETShift);
   CPPUNIT_TEST_SUITE_END();
   public:
     void setUp();
@@ -42,6 +79,12 @@ class testFinalState: public CppUnit::TestFixture {
     void testTriLepton();
     void testOverlaps();
     void testIndexGetter();
+    void testCompact();
+    void testCompactRebuild();
+    void testAssociation();
+    void testShifts();
+    void testShiftModes();
+    void testMETShift();
 
     ProductID electronPID;
     std::vector<pat::Electron> mockElectronColl_;
@@ -471,4 +514,351 @@ void testFinalState::testIndexGetter() {
 
 }
 
+void testFinalState::testCompact() {
+  PATElecMuFinalState first(mockElectronPtr_, mockMuonPtr1_, mockEventPtr_);
+  first.addUserFloat("vtxChi2", 1.5);
+  PATElecMuFinalState second(mockElectronPtr_, mockMuonPtr2_, mockEventPtr_);
+  second.addUserFloat("vtxChi2", 2.5);
+  second.addUserFloat("massErr", 0.5);
+
+  PATCompactFinalStateCollection compact(2, mockEventPtr_);
+  CPPUNIT_ASSERT(compact.empty());
+  compact.push_back(first);
+  compact.push_back(second);
+  CPPUNIT_ASSERT(compact.size() == 2);
+  CPPUNIT_ASSERT(compact.numberOfDaughters() == 2);
+  CPPUNIT_ASSERT(compact.evt() == mockEventPtr_);
+
+  // Legs are stored as product + key
+  CPPUNIT_ASSERT(compact.daughterKey(0, 1) == mockMuonPtr1_.key());
+  CPPUNIT_ASSERT(compact.daughterKey(1, 1) == mockMuonPtr2_.key());
+  CPPUNIT_ASSERT(compact.daughterPtr(1, 0).id() == mockElectronPtr_.id());
+  CPPUNIT_ASSERT(compact.daughterPtr(1, 1).id() == mockMuonPtr2_.id());
+  CPPUNIT_ASSERT_THROW(compact.daughterKey(0, 2), cms::Exception);
+  CPPUNIT_ASSERT_THROW(compact.daughterKey(2, 0), cms::Exception);
+
+  // Columns are padded when a name appears late
+  CPPUNIT_ASSERT(compact.userFloatNames().size() == 2);
+  CPPUNIT_ASSERT(compact.userFloatColumn("vtxChi2").size() == 2);
+  CPPUNIT_ASSERT(compact.userFloatColumn("massErr").size() == 2);
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(compact.userFloat(0, "vtxChi2"), 1.5, 1e-6);
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(compact.userFloat(1, "vtxChi2"), 2.5, 1e-6);
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(compact.userFloat(1, "massErr"), 0.5, 1e-6);
+  CPPUNIT_ASSERT(!compact.hasUserFloat(0, "massErr"));
+  CPPUNIT_ASSERT(compact.hasUserFloat(1, "massErr"));
+  CPPUNIT_ASSERT_THROW(compact.userFloat(0, "notAColumn"), cms::Exception);
+  CPPUNIT_ASSERT(compact.userCand(0, "notAColumn").isNull());
+
+  // Wrong number of legs
+  const PATElecMuMuFinalState triple(mockElectronPtr_, mockMuonPtr1_,
+      mockMuonPtr2_, mockEventPtr_);
+  CPPUNIT_ASSERT_THROW(compact.push_back(triple), cms::Exception);
+  // Wrong type
+  const PATMuMuFinalState dimuon(mockMuonPtr1_, mockMuonPtr2_, mockEventPtr_);
+  CPPUNIT_ASSERT_THROW(compact.push_back(dimuon), cms::Exception);
+}
+
+void testFinalState::testCompactRebuild() {
+  // The rebuilt legs are resolved through the product getter
+  MockProductGetter getter;
+  getter.add(electronPID, mockElectronColl_);
+  getter.add(muonPID, mockMuonColl_);
+  Ptr<pat::Electron> electron(electronPID, 0, &getter);
+  Ptr<pat::Muon> muon1(muonPID, 0, &getter);
+  Ptr<pat::Muon> muon2(muonPID, 1, &getter);
+
+  PATElecMuFinalState first(electron, muon1, mockEventPtr_);
+  first.addUserFloat("vtxChi2", 1.5);
+  first.setOverlaps("jets", mockJetEdmPtrVector_);
+  PATElecMuFinalState second(electron, muon2, mockEventPtr_);
+  second.addUserCand("aCand", mockUserCandPtr1_);
+  // A NaN userFloat is still a userFloat
+  second.addUserFloat("massErr", std::numeric_limits<float>::quiet_NaN());
+
+  PATCompactFinalStateCollection compact(2, mockEventPtr_);
+  compact.push_back(first);
+  compact.push_back(second);
+  CPPUNIT_ASSERT(!compact.hasUserFloat(0, "massErr"));
+  CPPUNIT_ASSERT(compact.hasUserFloat(1, "massErr"));
+  CPPUNIT_ASSERT(!compact.hasUserFloat(1, "vtxChi2"));
+
+  // Overlaps are kept per row
+  CPPUNIT_ASSERT(compact.overlapLabels().size() == 1);
+  CPPUNIT_ASSERT(compact.overlaps(0, "jets") == mockJetEdmPtrVector_);
+  CPPUNIT_ASSERT(compact.overlaps(1, "jets").empty());
+  CPPUNIT_ASSERT(compact.overlaps(0, "notAColumn").empty());
+
+  for (size_t i = 0; i < compact.size(); ++i) {
+    const PATFinalState& original = (i == 0) ? first : second;
+    PATFinalStateProxy rebuilt = compact.finalState(i);
+    // The concrete type is kept
+    CPPUNIT_ASSERT(typeid(*rebuilt.get()) == typeid(PATElecMuFinalState));
+    CPPUNIT_ASSERT(rebuilt->numberOfDaughters() == 2);
+    CPPUNIT_ASSERT(rebuilt->charge() == original.charge());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(rebuilt->pt(), original.pt(), 1e-6);
+    CPPUNIT_ASSERT(rebuilt->daughterPtr(1).key() ==
+        original.daughterPtr(1).key());
+    // Typed daughter access works, as for the input
+    CPPUNIT_ASSERT(rebuilt->daughterUserCand(0, "aUserCand1") ==
+        original.daughterUserCand(0, "aUserCand1"));
+    CPPUNIT_ASSERT(rebuilt->hasOverlaps("jets") ==
+        original.hasOverlaps("jets"));
+    CPPUNIT_ASSERT(rebuilt->hasUserFloat("vtxChi2") ==
+        original.hasUserFloat("vtxChi2"));
+    CPPUNIT_ASSERT(rebuilt->hasUserFloat("massErr") ==
+        original.hasUserFloat("massErr"));
+    CPPUNIT_ASSERT(rebuilt->userCand("aCand") == original.userCand("aCand"));
+  }
+  CPPUNIT_ASSERT(compact.finalState(0)->overlaps("jets") ==
+      mockJetEdmPtrVector_);
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(
+      compact.finalState(0)->userFloat("vtxChi2"), 1.5, 1e-6);
+  CPPUNIT_ASSERT(std::isnan(compact.finalState(1)->userFloat("massErr")));
+}
+
+void testFinalState::testAssociation() {
+  PATElecMuMuFinalState finalStateNonConst(mockElectronPtr_, mockMuonPtr1_,
+      mockMuonPtr2_, mockEventPtr_);
+  finalStateNonConst.addUserFloat("embedded", 3.0);
+  const PATElecMuMuFinalState finalState(finalStateNonConst);
+
+  PATFinalStateAssociation association(ProductID(1, 5), 2);
+  association.addUserFloat(1, "vtxChi2", 1.5);
+  association.setOverlaps(1, "jets", mockJetEdmPtrVector_);
+  CPPUNIT_ASSERT(association.hasUserFloat(1, "vtxChi2"));
+  CPPUNIT_ASSERT(!association.hasUserFloat(0, "vtxChi2"));
+  CPPUNIT_ASSERT_THROW(association.addUserFloat(2, "vtxChi2", 1.), cms::Exception);
+
+  // Overlaps are per final state
+  CPPUNIT_ASSERT(association.hasOverlaps(1, "jets"));
+  CPPUNIT_ASSERT(!association.hasOverlaps(0, "jets"));
+  CPPUNIT_ASSERT(association.overlaps(0, "jets").empty());
+  CPPUNIT_ASSERT(!association.hasOverlaps(1, "notALabel"));
+
+  // Folding the association into a copy, which all the accessors see
+  std::auto_ptr<PATFinalState> copy(finalState.clone());
+  CPPUNIT_ASSERT(!copy->hasUserFloat("vtxChi2"));
+  association.embedInto(1, *copy);
+  const PATLeafCandidate& base = *copy;
+  CPPUNIT_ASSERT(base.hasUserFloat("vtxChi2"));
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(base.userFloat("vtxChi2"), 1.5, 1e-6);
+  CPPUNIT_ASSERT(base.hasOverlaps("jets"));
+  CPPUNIT_ASSERT(base.overlaps("jets") == mockJetEdmPtrVector_);
+  CPPUNIT_ASSERT(copy->extras("jets", "") == mockJetPtrVector_);
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(copy->userFloat("embedded"), 3.0, 1e-6);
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(copy->eval("userFloat('vtxChi2')"), 1.5, 1e-6);
+
+  // A final state without associated overlaps doesn't get any
+  std::auto_ptr<PATFinalState> other0(finalState.clone());
+  association.embedInto(0, *other0);
+  CPPUNIT_ASSERT(!other0->hasOverlaps("jets"));
+  CPPUNIT_ASSERT(!other0->hasUserFloat("vtxChi2"));
+
+  // Merging, a NaN userFloat is kept as such
+  PATFinalStateAssociation other(ProductID(1, 5), 2);
+  other.addUserFloat(0, "cand_dM", 0.5);
+  other.addUserFloat(1, "cand_dM", std::numeric_limits<float>::quiet_NaN());
+  association.merge(other);
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(association.userFloat(0, "cand_dM"), 0.5, 1e-6);
+  CPPUNIT_ASSERT(association.hasUserFloat(1, "cand_dM"));
+  CPPUNIT_ASSERT(std::isnan(association.userFloat(1, "cand_dM")));
+  std::auto_ptr<PATFinalState> other1(finalState.clone());
+  association.embedInto(1, *other1);
+  CPPUNIT_ASSERT(other1->hasUserFloat("cand_dM"));
+  CPPUNIT_ASSERT(std::isnan(other1->userFloat("cand_dM")));
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(association.userFloat(1, "vtxChi2"), 1.5, 1e-6);
+  PATFinalStateAssociation mismatched(ProductID(1, 6), 2);
+  CPPUNIT_ASSERT_THROW(association.merge(mismatched), cms::Exception);
+}
+
+void testFinalState::testShifts() {
+  std::vector<std::string> names;
+  names.push_back("mes+");
+  names.push_back("mes-");
+  PATObjectShifts shifts(names, 2);
+  CPPUNIT_ASSERT(shifts.index("mes-") == 1);
+  CPPUNIT_ASSERT(shifts.index("tes+") == -1);
+  shifts.setP4(1, 0, reco::Candidate::LorentzVector(
+        math::PtEtaPhiMLorentzVector(13, -1, 0, 0)));
+  CPPUNIT_ASSERT(shifts.hasP4(1, 0));
+  CPPUNIT_ASSERT(!shifts.hasP4(1, 1));
+  CPPUNIT_ASSERT(!shifts.hasP4(0, 0));
+  CPPUNIT_ASSERT_THROW(shifts.p4(0, 0), cms::Exception);
+  CPPUNIT_ASSERT_THROW(shifts.setP4(2, 0, reco::Candidate::LorentzVector()),
+      cms::Exception);
+
+  TestHandle<PATObjectShifts> shiftsHandle(&shifts, ProductID(1, 7));
+  edm::RefProd<PATObjectShifts> shiftsRef(shiftsHandle);
+
+  // Muons which reference the shifts
+  std::vector<pat::Muon> muons(mockMuonColl_);
+  PATObjectShifts::link(muons[0], shiftsRef, 0);
+  PATObjectShifts::link(muons[1], shiftsRef, 1);
+  TestHandle<std::vector<pat::Muon> > muonHandle(&muons, ProductID(1, 8));
+  edm::Ptr<pat::Muon> muon1(muonHandle, 0);
+  edm::Ptr<pat::Muon> muon2(muonHandle, 1);
+
+  reco::Candidate::LorentzVector p4;
+  CPPUNIT_ASSERT(PATObjectShifts::shiftedP4(muons[1], "mes+", p4));
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(p4.pt(), 13, 1e-4);
+  CPPUNIT_ASSERT(!PATObjectShifts::shiftedP4(muons[1], "mes-", p4));
+  // userCands are still found
+  CPPUNIT_ASSERT(PATObjectShifts::shiftedP4(muons[0], "aUserCand2", p4));
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(p4.pt(), 15, 1e-4);
+
+  const PATElecMuMuFinalState finalState(mockElectronPtr_, muon1, muon2,
+      mockEventPtr_);
+  CPPUNIT_ASSERT(finalState.daughterHasUserCand(2, "mes+"));
+  CPPUNIT_ASSERT(!finalState.daughterHasUserCand(1, "mes+"));
+  CPPUNIT_ASSERT(finalState.daughterHasUserCand(0, "aUserCand1"));
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(
+      finalState.daughterUserCandP4(2, "mes+").pt(), 13, 1e-4);
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(
+      finalState.daughterUserCandP4(2, "mes+").eta(), -1, 1e-4);
+  CPPUNIT_ASSERT_THROW(finalState.daughterUserCandP4(1, "mes+"),
+      cms::Exception);
+
+  // MET variations embedded in the MET itself
+  CPPUNIT_ASSERT(metshifts::index("jes+") == metshifts::kJESUp);
+  CPPUNIT_ASSERT(metshifts::name(metshifts::kUESDown) == "ues-");
+  CPPUNIT_ASSERT(metshifts::index("foo") == -1);
+  PATObjectShifts metShifts(metshifts::names(), 1);
+  metShifts.setP4(0, metshifts::kJESUp, reco::Candidate::LorentzVector(
+        math::PtEtaPhiMLorentzVector(25, 0, -1, 0)));
+  pat::MET met(mockMETColl_[0]);
+  PATObjectShifts::embed(met, metShifts);
+  CPPUNIT_ASSERT(PATObjectShifts::embedded(met));
+  CPPUNIT_ASSERT(PATObjectShifts::shiftedP4(met, "jes+", p4));
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(p4.pt(), 25, 1e-4);
+  CPPUNIT_ASSERT(!PATObjectShifts::shiftedP4(met, "jes-", p4));
+}
+
+void testFinalState::testShiftModes() {
+  // The same muon scale shifts, as userCands and as compact shifts
+  std::vector<reco::Candidate::LorentzVector> mesUp;
+  mesUp.push_back(reco::Candidate::LorentzVector(
+        math::PtEtaPhiMLorentzVector(14, 1, 0, 0)));
+  mesUp.push_back(reco::Candidate::LorentzVector(
+        math::PtEtaPhiMLorentzVector(9, -1, 0, 0)));
+
+  std::vector<reco::LeafCandidate> userCands;
+  for (size_t i = 0; i < mesUp.size(); ++i) {
+    reco::LeafCandidate userCand(mockMuonColl_[i]);
+    userCand.setP4(mesUp[i]);
+    userCands.push_back(userCand);
+  }
+  TestHandle<std::vector<reco::LeafCandidate> > userCandHandle(
+      &userCands, ProductID(1, 9));
+  std::vector<pat::Muon> userCandMuons(mockMuonColl_);
+  for (size_t i = 0; i < userCandMuons.size(); ++i)
+    userCandMuons[i].addUserCand("mes+",
+        Ptr<reco::LeafCandidate>(userCandHandle, i));
+  TestHandle<std::vector<pat::Muon> > userCandMuonHandle(
+      &userCandMuons, ProductID(1, 10));
+
+  PATObjectShifts shifts(std::vector<std::string>(1, "mes+"), mesUp.size());
+  for (size_t i = 0; i < mesUp.size(); ++i)
+    shifts.setP4(i, 0, mesUp[i]);
+  TestHandle<PATObjectShifts> shiftsHandle(&shifts, ProductID(1, 11));
+  edm::RefProd<PATObjectShifts> shiftsRef(shiftsHandle);
+  std::vector<pat::Muon> compactMuons(mockMuonColl_);
+  for (size_t i = 0; i < compactMuons.size(); ++i)
+    PATObjectShifts::link(compactMuons[i], shiftsRef, i);
+  TestHandle<std::vector<pat::Muon> > compactMuonHandle(
+      &compactMuons, ProductID(1, 12));
+
+  const PATElecMuMuFinalState userCandState(mockElectronPtr_,
+      Ptr<pat::Muon>(userCandMuonHandle, 0),
+      Ptr<pat::Muon>(userCandMuonHandle, 1), mockEventPtr_);
+  const PATElecMuMuFinalState compactState(mockElectronPtr_,
+      Ptr<pat::Muon>(compactMuonHandle, 0),
+      Ptr<pat::Muon>(compactMuonHandle, 1), mockEventPtr_);
+
+  const std::string tags = "@,mes+,mes+";
+  for (size_t i = 1; i < 3; ++i) {
+    CPPUNIT_ASSERT(compactState.daughterHasUserCand(i, "mes+"));
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(userCandState.daughterUserCandP4(i, "mes+").pt(),
+        compactState.daughterUserCandP4(i, "mes+").pt(), 1e-4);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(compactState.daughterUserCand(i, "mes+")->pt(),
+        mesUp[i-1].pt(), 1e-4);
+    CPPUNIT_ASSERT(compactState.daughterUserCand(i, "mes+")->charge() ==
+        mockMuonColl_[i-1].charge());
+  }
+  CPPUNIT_ASSERT_THROW(compactState.daughterUserCand(1, "mes-"),
+      cms::Exception);
+
+  std::vector<const reco::Candidate*> userCandDaus =
+    userCandState.daughters(tags);
+  std::vector<const reco::Candidate*> compactDaus = compactState.daughters(tags);
+  CPPUNIT_ASSERT(compactDaus.size() == userCandDaus.size());
+  for (size_t i = 0; i < compactDaus.size(); ++i)
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(userCandDaus[i]->pt(), compactDaus[i]->pt(),
+        1e-4);
+  // The shifted candidate is only built once
+  CPPUNIT_ASSERT(compactState.daughters(tags)[1] == compactDaus[1]);
+
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(userCandState.visP4(tags).pt(),
+      compactState.visP4(tags).pt(), 1e-4);
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(userCandState.visP4("#,mes+,mes+").pt(),
+      compactState.visP4("#,mes+,mes+").pt(), 1e-4);
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(userCandState.totalP4(tags, "").pt(),
+      compactState.totalP4(tags, "").pt(), 1e-4);
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(userCandState.ht(tags), compactState.ht(tags),
+      1e-4);
+  CPPUNIT_ASSERT(userCandState.indicesByPt(tags) ==
+      compactState.indicesByPt(tags));
+  // The shift reorders the muons
+  CPPUNIT_ASSERT(compactState.indicesByPt()[0] == 2);
+  CPPUNIT_ASSERT(compactState.indicesByPt(tags)[0] == 1);
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(userCandState.subcand("#,mes+,mes+")->pt(),
+      compactState.subcand("#,mes+,mes+")->pt(), 1e-4);
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(
+      compactState.eval("subcand('#,mes+,mes+').get.mass"),
+      userCandState.eval("subcand('#,mes+,mes+').get.mass"), 1e-4);
+}
+
+void testFinalState::testMETShift() {
+  // One MET with compact shifts, one with userCands
+  PATObjectShifts metShifts(metshifts::names(), 1);
+  metShifts.setP4(0, metshifts::kType1, reco::Candidate::LorentzVector(
+        math::PtEtaPhiMLorentzVector(22, 0, -1, 0)));
+  metShifts.setP4(0, metshifts::kJESUp, reco::Candidate::LorentzVector(
+        math::PtEtaPhiMLorentzVector(25, 0, -1, 0)));
+  std::vector<pat::MET> mets(2, mockMETColl_[0]);
+  PATObjectShifts::embed(mets[0], metShifts);
+
+  std::vector<reco::LeafCandidate> userCands(1,
+      reco::LeafCandidate(mockMETColl_[0]));
+  userCands[0].setP4(math::PtEtaPhiMLorentzVector(25, 0, -1, 0));
+  TestHandle<std::vector<reco::LeafCandidate> > userCandHandle(
+      &userCands, ProductID(1, 13));
+  mets[1].addUserCand("jes+", Ptr<reco::LeafCandidate>(userCandHandle, 0));
+
+  TestHandle<std::vector<pat::MET> > metHandle(&mets, ProductID(1, 14));
+  std::map<std::string, edm::Ptr<pat::MET> > metMap;
+  metMap["pfmet"] = Ptr<pat::MET>(metHandle, 0);
+  metMap["mvamet"] = Ptr<pat::MET>(metHandle, 1);
+  const PATFinalStateEvent evt(nullVtx_, metMap["pfmet"], metMap);
+
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(
+      evt.metShift("pfmet", metshifts::kJESUp).pt(), 25, 1e-4);
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(
+      evt.metShift("pfmet", metshifts::kType1).phi(), -1, 1e-4);
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(evt.metShift("pfmet", metshifts::kJESUp).pt(),
+      evt.met4vector("pfmet", "jes+").pt(), 1e-6);
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(evt.metShift("pfmet", metshifts::kType1).phi(),
+      evt.met4vector("pfmet", "type1").phi(), 1e-6);
+  // Falls back to the userCands
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(
+      evt.metShift("mvamet", metshifts::kJESUp).pt(), 25, 1e-4);
+  // Missing shifts and unknown METs
+  CPPUNIT_ASSERT_THROW(evt.metShift("pfmet", metshifts::kJESDown),
+      cms::Exception);
+  CPPUNIT_ASSERT_THROW(evt.metShift("mvamet", metshifts::kType1),
+      cms::Exception);
+  CPPUNIT_ASSERT_THROW(evt.metShift("pfmet", metshifts::kNShifts),
+      cms::Exception);
+  CPPUNIT_ASSERT(evt.metShift("tcmet", metshifts::kJESUp).pt() == 0);
+}
+
 CPPUNIT_TEST_SUITE_REGISTRATION(testFinalState);
@@ -78,6 +78,9 @@ class PATFinalStateAnalysis : public edm::BasicAnalyzer {
     Float_t treeIntLumi_; // The estimated integrated luminosity
 
     bool filter_;
+    // Read the final states from a PATCompactFinalStateCollection
+    bool compact_;
+    edm::InputTag associationSrc_;
 };
 
 #endif /* end of include guard: PATFINALSTATEANALYSIS_FRM3UCVB */
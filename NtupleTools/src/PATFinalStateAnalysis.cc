@@ -7,8 +7,11 @@
 
 #include "FinalStateAnalysis/DataFormats/interface/PATFinalStateEvent.h"
 #include "FinalStateAnalysis/DataFormats/interface/PATFinalStateLS.h"
+#include "FinalStateAnalysis/DataFormats/interface/PATCompactFinalStateCollection.h"
+#include "FinalStateAnalysis/DataFormats/interface/PATFinalStateAssociation.h"
 
 #include "FWCore/Common/interface/LuminosityBlockBase.h"
+#include "FWCore/Utilities/interface/Exception.h"
 #include "CommonTools/Utils/interface/TFileDirectory.h"
 #include "DataFormats/Common/interface/MergeableCounter.h"
 #include "TH1F.h"
@@ -32,6 +35,19 @@ PATFinalStateAnalysis::PATFinalStateAnalysis(
 
   analysisCfg_ = pset.getParameterSet("analysis");
   filter_ = pset.exists("filter") ? pset.getParameter<bool>("filter") : false;
+  // Check if the src is a PATCompactFinalStateCollection
+  compact_ = pset.exists("compact") ? pset.getParameter<bool>("compact") : false;
+  // Optional PATFinalStateAssociation to the src final states
+  if (pset.exists("association"))
+    associationSrc_ = pset.getParameter<edm::InputTag>("association");
+  // The association is keyed to a PATFinalStateCollection, the compact rows
+  // must have it folded in by the PATFinalStateCompactor.
+  if (compact_ && associationSrc_.label() != "") {
+    throw cms::Exception("Configuration")
+      << "PATFinalStateAnalysis: an association can't be used with a "
+      << "compact src, give it to the PATFinalStateCompactor instead"
+      << std::endl;
+  }
   // Build the analyzer
   analysis_.reset(new PATFinalStateSelection(analysisCfg_, fs_));
   // Check if we want to make a sub analyzer for each run (use w/ caution!)
@@ -100,16 +116,47 @@ bool PATFinalStateAnalysis::filter(const edm::EventBase& evt) {
   eventWeights_->Fill(eventWeight);
 
   // Get the final states to analyze
-  edm::Handle<PATFinalStateCollection> finalStates;
-  evt.getByLabel(src_, finalStates);
-
   std::vector<const PATFinalState*> finalStatePtrs;
-  finalStatePtrs.reserve(finalStates->size());
+  // Owns the final states rebuilt from a compact collection, or copied to
+  // fold in an association
+  std::vector<PATFinalStateProxy> rebuiltFinalStates;
 
-  //Normal running
   bool mustCleanupFinalStates = false;
-  for (size_t i = 0; i < finalStates->size(); ++i) {
-    finalStatePtrs.push_back( &( (*finalStates)[i] ) );
+  if (compact_) {
+    edm::Handle<PATCompactFinalStateCollection> compactStates;
+    evt.getByLabel(src_, compactStates);
+    rebuiltFinalStates.reserve(compactStates->size());
+    finalStatePtrs.reserve(compactStates->size());
+    for (size_t i = 0; i < compactStates->size(); ++i) {
+      rebuiltFinalStates.push_back(compactStates->finalState(i));
+      finalStatePtrs.push_back(rebuiltFinalStates.back().get());
+    }
+  } else {
+    //Normal running
+    edm::Handle<PATFinalStateCollection> finalStates;
+    evt.getByLabel(src_, finalStates);
+    finalStatePtrs.reserve(finalStates->size());
+    for (size_t i = 0; i < finalStates->size(); ++i) {
+      finalStatePtrs.push_back( &( (*finalStates)[i] ) );
+    }
+    // Fold the associated user data into a (transient) copy of each final
+    // state, so all the usual accessors see it.
+    if (associationSrc_.label() != "") {
+      edm::Handle<PATFinalStateAssociation> association;
+      evt.getByLabel(associationSrc_, association);
+      if (association->src() != finalStates.id()) {
+        throw cms::Exception("MismatchedAssociation")
+          << "PATFinalStateAnalysis: the association " << associationSrc_
+          << " is not associated to the final states " << src_ << std::endl;
+      }
+      rebuiltFinalStates.reserve(finalStatePtrs.size());
+      for (size_t i = 0; i < finalStatePtrs.size(); ++i) {
+        PATFinalState* copy = finalStatePtrs[i]->clone();
+        association->embedInto(i, *copy);
+        rebuiltFinalStates.push_back(PATFinalStateProxy(copy));
+        finalStatePtrs[i] = copy;
+      }
+    }
   }
 
   // Hack workarounds into ntuple here
@@ -17,6 +17,9 @@
 #include "TrackingTools/TransientTrack/interface/TransientTrackBuilder.h"
 #include "TMVA/Tools.h"
 #include "TMVA/Reader.h"
+#include "FinalStateAnalysis/PatTools/interface/TMVAForest.h"
+
+#include <vector>
 
 class ElectronIDMVA {
   public:
@@ -55,6 +58,21 @@ class ElectronIDMVA {
         const edm::InputTag& ebRecHits,
         const edm::InputTag& eeRecHits);
 
+    // Evaluate several electrons at once.  The electrons in each MVA bin are
+    // evaluated in one pass over the trees.
+    void MVAValues(const std::vector<const reco::GsfElectron*>& eles,
+                   EcalClusterLazyTools& myEcalCluster,
+                   std::vector<double>& output);
+
+    // Build the lazy tools internally (once for all the electrons)
+    void MVAValues(
+        const std::vector<const reco::GsfElectron*>& eles,
+        const edm::Event& evt,
+        const edm::EventSetup& es,
+        const edm::InputTag& ebRecHits,
+        const edm::InputTag& eeRecHits,
+        std::vector<double>& output);
+
     double MVAValue(double ElePt , double EleSCEta,
                     double EleSigmaIEtaIEta,
                     double EleDEtaIn,
@@ -74,6 +92,18 @@ class ElectronIDMVA {
 
 
   protected:
+    // The MVA bin (subdet, pt bin) of an electron
+    Int_t  MVABin(Double_t ElePt, Double_t EleSCEta) const;
+    // Evaluate the given bin with the current input variables
+    Double_t Evaluate(Int_t bin);
+    // Set the input variables of the IP independent MVA types
+    void   SetVariables(const reco::GsfElectron *ele,
+                        EcalClusterLazyTools& myEcalCluster);
+    void   AddVariable(const std::string& name, Float_t* variable);
+
+    // The weights are evaluated with a TMVAForest if possible, else with a
+    // TMVA::Reader (only built in that case).
+    TMVAForest                fForest[6];
     TMVA::Reader             *fTMVAReader[6];
     std::string               fMethodname;
     MVAType                   fMVAType;
@@ -95,6 +125,17 @@ class ElectronIDMVA {
     Float_t                   fMVAVar_EleIP3d;
     Float_t                   fMVAVar_EleIP3dSig;
 
+    // The input variables of the MVA type, in order
+    std::vector<std::string>  fVariableNames;
+    std::vector<Float_t*>     fVariables;
+    std::vector<float>        fInputs;
+    // Batch evaluation buffers
+    std::vector<Int_t>        fBatchBins;
+    std::vector<float>        fBatchInputs;
+    std::vector<size_t>       fBinIndices;
+    std::vector<float>        fBinInputs;
+    std::vector<double>       fBinOutputs;
+
 };
 
 #endif
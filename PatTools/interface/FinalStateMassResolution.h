@@ -31,7 +31,7 @@ class EcalClusterFunctionBaseClass;
 #include <vector>
 #include "FWCore/Framework/interface/ESHandle.h"
 #include "MagneticField/Engine/interface/MagneticField.h"
-#include <TMatrixDSym.h>
+#include "DataFormats/Math/interface/AlgebraicROOTObjects.h"
 
 /* Mutuated from
    /UserCode/Mangano/WWAnalysis/AnalysisStep/src/CompositeCandMassResolution.cc
@@ -49,30 +49,22 @@ class FinalStateMassResolution  {
 					 std::vector<double> &errI) const;
  private:
   void   fillP3Covariance(const reco::Candidate &c,
-			  TMatrixDSym &bigCov,
-			  int offset) const ;
+			  AlgebraicSymMatrix33 &cov) const;
   void   fillP3Covariance(const reco::GsfElectron &c,
-			  TMatrixDSym &bigCov,
-			  int offset) const ;
+			  AlgebraicSymMatrix33 &cov) const;
   void   fillP3Covariance(const reco::Photon &c,
-			  TMatrixDSym &bigCov,
-			  int offset) const;
+			  AlgebraicSymMatrix33 &cov) const;
   void   fillP3Covariance(const reco::Muon &c,
-			  TMatrixDSym &bigCov,
-			  int offset) const ;
+			  AlgebraicSymMatrix33 &cov) const;
   void   fillP3Covariance(const reco::PFCandidate &c,
-			  TMatrixDSym &bigCov,
-			  int offset) const ;
+			  AlgebraicSymMatrix33 &cov) const;
   void   fillP3Covariance(const pat::Jet &c,
-			  TMatrixDSym &bigCov,
-			  int offset) const ;
+			  AlgebraicSymMatrix33 &cov) const;
   void   fillP3Covariance(const reco::Candidate &c,
 			  const reco::Track &t,
-			  TMatrixDSym &bigCov,
-			  int offset) const ;
+			  AlgebraicSymMatrix33 &cov) const;
   void   fillP3Covariance(const reco::LeafCandidate &c,
-			  TMatrixDSym &bigCov,
-			  int offset) const ;
+			  AlgebraicSymMatrix33 &cov) const;
 
   edm::ESHandle<MagneticField> magfield_;
   EcalClusterFunctionBaseClass* uncertainty_;
@@ -85,6 +77,19 @@ class FinalStateMassResolution  {
   double getMassResolution_(const reco::Candidate &c,
 			    std::vector<double> &errI,
 			    bool doComponents) const;
+
+  // Propagation for a fixed number of leaves, using stack allocated
+  // SMatrix types instead of TMatrixDSym.
+  template<unsigned int N>
+  double getMassResolutionFixed_(const reco::Candidate &c,
+				 const std::vector<const reco::Candidate *> &leaves,
+				 std::vector<double> &errI,
+				 bool doComponents) const;
+  // Propagation for any number of leaves
+  double getMassResolutionGeneral_(const reco::Candidate &c,
+				   const std::vector<const reco::Candidate *> &leaves,
+				   std::vector<double> &errI,
+				   bool doComponents) const;
 };
 
 #endif
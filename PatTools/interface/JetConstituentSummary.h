@@ -0,0 +1,105 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  JetConstituentSummary.h
+ *
+ *    Description:  Per-jet summary of the leptons among the PF constituents,
+ *                  and of the tracks of the positive and negative secondary
+ *                  vertex tag infos, for the jet embedders
+ *                  (PATMuonInJetEmbedder, PATSSVJetEmbedder).
+ *
+ *                  Each part is filled with a single pass: one loop over the
+ *                  constituents for the leptons, and one loop over the vertex
+ *                  tracks of each tag info, which the positive and negative
+ *                  tag infos share.
+ *
+ *                  The members default to the values the embedders store
+ *                  when nothing is found.
+ *
+ * =====================================================================================
+ */
+
+#ifndef JETCONSTITUENTSUMMARY_H_6TRN2WQ9
+#define JETCONSTITUENTSUMMARY_H_6TRN2WQ9
+
+#include "DataFormats/PatCandidates/interface/Jet.h"
+#include "DataFormats/VertexReco/interface/VertexFwd.h"
+#include "DataFormats/BTauReco/interface/SecondaryVertexTagInfo.h"
+
+#include <string>
+
+/// The highest ptrel lepton among the constituents of a jet
+struct LeptonInJetSummary {
+  LeptonInJetSummary();
+
+  double pt;
+  double eta;
+  double phi;
+  double charge;
+  // Signed with the charge
+  double ptRel;
+  // Muons only: impact parameter w.r.t. the first vertex, and the absolute
+  // R03 isolation
+  double dxy;
+  double dz;
+  double dxyError;
+  double dzError;
+  double isoAbs;
+};
+
+/// Vertices and vertex tracks of a secondary vertex tag info
+struct SecondaryVertexSummary {
+  SecondaryVertexSummary();
+
+  // Only the first vertices and tracks are kept
+  static const unsigned maxVertices = 2;
+  static const unsigned maxTracks = 3;
+
+  unsigned nVertices;
+  unsigned nTracks[maxVertices];
+  double flightDistance[maxVertices];
+  double errorFlightDistance[maxVertices];
+
+  // The tracks of all the vertices
+  unsigned nVertexTracks;
+  int charge;
+  double trackPx[maxTracks];
+  double trackPy[maxTracks];
+  double trackPz[maxTracks];
+  int trackCharge[maxTracks];
+
+  // Invariant mass of the vertex tracks, as pions (mass), as a D+ to
+  // K pi pi (massD), and as a D0 to K pi (massD0)
+  double mass;
+  double massD;
+  double massD0;
+
+  /// The simple secondary vertex discriminator of the [isv]th vertex,
+  /// requiring [minTracks] tracks (2 for high efficiency, 3 for high
+  /// purity), or -777.  [negative] is for the negative tag info.
+  double discriminator(unsigned isv, unsigned minTracks, bool negative) const;
+};
+
+class JetConstituentSummary {
+  public:
+    /// Find the highest ptrel muon (passing the quality cuts, with respect
+    /// to the first of the [vertices]) and electron among the PF
+    /// constituents of [jet].
+    void fillLeptons(const pat::Jet& jet,
+        const reco::VertexCollection& vertices);
+
+    /// Summarize the "secondaryVertex" and "secondaryVertexNegative" tag
+    /// infos of [jet].
+    void fillSecondaryVertices(const pat::Jet& jet);
+
+    LeptonInJetSummary muon;
+    LeptonInJetSummary electron;
+    SecondaryVertexSummary positive;
+    SecondaryVertexSummary negative;
+
+  private:
+    static void fill(const reco::SecondaryVertexTagInfo* info,
+        SecondaryVertexSummary& output);
+};
+
+#endif /* end of include guard: JETCONSTITUENTSUMMARY_H_6TRN2WQ9 */
@@ -36,15 +36,25 @@ namespace pattools {
       int ea_type;
       int ea_target;      
     };
-    typedef std::map<std::string,ea_info> map_type;
-    map_type _eamap;
-    std::string _eatype;
+    std::vector<ea_info> _eas;
+    std::map<std::string,size_t> _eaindex;
+    // The EAs selected by setEAType(s)(..), -1 if unset
+    int _eatype;
+    std::vector<size_t> _eatypes;
+
+    size_t index(const std::string& type) const;
   public:
     PATElectronEACalculator(const edm::VParameterSet&);    
 
-    double operator() (const pat::Electron&);
+    double operator() (const pat::Electron&) const;
+
+    /// Fill [output] with the effective areas of all the types given to
+    /// setEATypes(..), in the same order.
+    void operator() (const pat::Electron&, std::vector<double>& output) const;
 
-    void setEAType(const std::string& type) { _eatype = type; }
+    /// Throw an exception if [type] is not configured
+    void setEAType(const std::string& type);
+    void setEATypes(const std::vector<std::string>& types);
   };
 }
 
@@ -46,11 +46,20 @@ namespace pattools {
     typedef ElectronEnergyCalibrator eCalib;
     typedef eCalib* pCalib;
     typedef std::map<std::string,pCalib>      calib_map;
-    typedef std::map<std::string,std::pair<int,pRegCalc> > reg_map;
+    // version, regression
+    typedef std::vector<std::pair<int,pRegCalc> > reg_list;
     // calib : regression
     typedef std::map<std::string,std::string> apply_map;
     typedef std::auto_ptr<pat::Electron> value_type;
 
+    // An applied calibration, resolved at construction
+    struct Variation {
+      std::string p4Label, errLabel; // user data names
+      pCalib calib;
+      int reg; // index in _regs, -1 for none
+    };
+    typedef std::vector<Variation> variation_list;
+
   private:
     const std::string _errPostfix;
 
@@ -71,9 +80,20 @@ namespace pattools {
     edm::Handle< EcalRecHitCollection > _recHitCollectionEE;
     edm::Handle< EcalRecHitCollection > _recHitCollectionEB;
 
-    apply_map _apply;
     calib_map _calibs;
-    reg_map   _regs;
+    reg_list  _regs;
+    // regressions used by any variation
+    std::vector<bool> _regUsed;
+    // in the (sorted) order of the applied calibrations
+    variation_list _variations;
+
+    // per electron regression energies and errors, by regression
+    std::vector<double> _regEnergies, _regErrors;
+    // per electron corrected p4 and error, by variation
+    std::vector<math::XYZTLorentzVector> _p4s;
+    std::vector<float> _p4Errors;
+    // working copy of the electron, reset for each variation
+    pat::Electron _work;
 
   public:
     PATElectronEnergyCorrection(const edm::ParameterSet&,
@@ -82,6 +102,9 @@ namespace pattools {
     ~PATElectronEnergyCorrection();
 
     value_type operator() (const pat::ElectronRef&);
+    // Same, embedding the corrections in [out], which must be a copy
+    // of the electron.  Only the user data of [out] is changed.
+    void operator() (const pat::ElectronRef&, pat::Electron& out);
 
     void setES(const edm::EventSetup& es);
     void setEvent(const edm::Event& ev);
@@ -36,12 +36,19 @@ class PATMuonIdSelectorImp
 
   void select(const edm::Handle<collection>&, edm::Event&, const edm::EventSetup&);
 
+  // Find the point the impact parameters are computed w.r.t. in this event.
+  // Must be called before passes(..)
+  void setReferencePoint(const edm::Event&);
+  // Check if a single muon passes the ID
+  bool passes(const pat::Muon&) const;
+
   size_t size() const { return selected_.size(); }
 
  private:
   void print();
 
   std::vector<const pat::Muon*> selected_;
+  reco::TrackBase::Point IPrefPoint_;
 
 //--- configuration parameters
   edm::InputTag srcBeamSpot_;
@@ -3,6 +3,12 @@
  * This class wrangles the Rochester Corrections
  * into a usable state within CMSSW for embedding.
  *
+ * A whole muon collection can be corrected at once: each correction
+ * is then run over plain arrays of all the muons.  The random
+ * deviates for the MC smearing are drawn up front, in the same order
+ * as when the muons are corrected one at a time, so the results do
+ * not depend on which interface is used.
+ *
  * \author Lindsey Gray, UW Madison
  *
  *
@@ -15,6 +21,7 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <algorithm>
 
 #include "TLorentzVector.h"
 
@@ -43,10 +50,16 @@ namespace pattools {
       CorrectionBase() {}
       virtual ~CorrectionBase() {}
 
-      virtual std::pair<math::XYZTLorentzVector,float> 
-	correct(const math::XYZTLorentzVector& pin,
-		float charge,
-		float sysdev ) = 0;
+      // correct n muons, given as (px, py, pz, E) arrays, in place;
+      // [normals] are the smearing deviates (only used for MC)
+      virtual void correct(size_t n,
+			   double* px, double* py, double* pz, double* e,
+			   const float* charge,
+			   float sysdev,
+			   float* err,
+			   const double* normals) = 0;
+      // draw the deviates used by the MC smearing
+      virtual void drawNormals(size_t n, double* output) = 0;
     };
 
     // define a wrapper class to make the corrs not suck
@@ -60,24 +73,21 @@ namespace pattools {
       Correction(bool isMC): _corr(new T(doSyst)), _isMC(isMC) {}
       virtual ~Correction() { delete _corr;}
 
-      virtual std::pair<math::XYZTLorentzVector,float> 
-	correct(const math::XYZTLorentzVector& pin,
-		float charge,
-		float sysdev ) {
-	math::XYZTLorentzVector result = pin;
-	float the_err = 0.0;
-	TLorentzVector input(pin.x(),pin.y(),pin.z(),pin.t());
-
-	if( doSyst ){
-	  if( _isMC ) _corr->momcor_mc(input,charge,sysdev,runopt,the_err);
-	  else        _corr->momcor_data(input,charge,sysdev,runopt,the_err);
-	} else {
-	  if( _isMC ) _corr->momcor_mc(input,charge,0.0,runopt,the_err);
-	  else        _corr->momcor_data(input,charge,0.0,runopt,the_err);
-	}
-	
-	result.SetXYZT(input.X(),input.Y(),input.Z(),input.T());
-	return std::make_pair(result,the_err);
+      virtual void correct(size_t n,
+			   double* px, double* py, double* pz, double* e,
+			   const float* charge,
+			   float sysdev,
+			   float* err,
+			   const double* normals) {
+	std::fill(err, err + n, 0.0);
+	if( !doSyst ) sysdev = 0.0;
+
+	if( _isMC ) _corr->momcor_mc(n,px,py,pz,e,charge,sysdev,runopt,err,normals);
+	else        _corr->momcor_data(n,px,py,pz,e,charge,sysdev,runopt,err);
+      }
+
+      virtual void drawNormals(size_t n, double* output) {
+	_corr->drawNormals(n, output);
       }
 	
     };
@@ -103,6 +113,18 @@ namespace pattools {
     std::string _userP4Prefix;
     std::vector<std::string> _apply;    
     calib_map _calibs;    
+    bool _isMC;
+    // the calibrations in _apply, resolved once
+    std::vector<const calib_container*> _applied;
+
+    // per event work space, reused
+    struct corrected_p4s {
+      std::vector<double> px, py, pz, e;
+      std::vector<float> err;
+    };
+    std::vector<float> _charge;
+    std::vector<double> _normals, _calibNormals;
+    std::vector<corrected_p4s> _corrected; // [calib][central, up, down]
     
   public:
     PATMuonRochesterCorrection(const edm::ParameterSet&,
@@ -110,6 +132,10 @@ namespace pattools {
     ~PATMuonRochesterCorrection();
     
     pat::Muon operator() (const pat::MuonRef&);    
+
+    // correct all [muons], in order, appending them to [output]
+    void operator() (const pat::MuonCollection& muons,
+		     pat::MuonCollection& output);
     
   };
 
@@ -31,21 +31,34 @@ namespace pat {
 namespace pattools {
   class PATPhotonEACalculator {    
   private:    
-    struct ea_info {  
+    // The bins of one EA type, flattened at configuration time
+    struct ea_table {  
       bool   needs_pfneut,needs_pfpho;
-      double eta_max,eta_min;      
-      double eff_area;
       double cone_size;
+      // Upper eta edge and effective area of each bin
+      std::vector<double> eta_max;
+      std::vector<double> eff_area;
     };
-    typedef std::map<std::string,std::vector<ea_info> > map_type;
-    map_type _eamap;
-    std::string _eatype;
+    std::vector<ea_table> _tables;
+    std::map<std::string,size_t> _eaindex;
+    // The tables selected by setEAType(s)(..), -1 if unset
+    int _eatype;
+    std::vector<size_t> _eatypes;
+
+    size_t index(const std::string& type) const;
+    double lookup(const ea_table&, double abseta) const;
   public:
     PATPhotonEACalculator(const edm::VParameterSet&);    
 
-    double operator() (const pat::Photon&);
+    double operator() (const pat::Photon&) const;
+
+    /// Fill [output] with the effective areas of all the types given to
+    /// setEATypes(..), in the same order.
+    void operator() (const pat::Photon&, std::vector<double>& output) const;
 
-    void setEAType(const std::string& type) { _eatype = type; }
+    /// Throw an exception if [type] is not configured
+    void setEAType(const std::string& type);
+    void setEATypes(const std::vector<std::string>& types);
   };
 }
 
@@ -0,0 +1,106 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  PFCandidateIndex.h
+ *
+ *    Description:  Per-event index of a PF candidate collection for the
+ *                  isolation computations.  The candidates are split by
+ *                  particle type, and each type is bucketed in eta-phi, so
+ *                  the candidates in an isolation cone can be found without
+ *                  scanning the whole collection.
+ *
+ *                  The vertex association (findVertex(..)) of the charged
+ *                  candidates is computed on demand and kept, so it is only
+ *                  done once per candidate per event, no matter how many
+ *                  leptons it is near.  The vertex tracks are hashed once
+ *                  (see VertexTrackMatcher), and shared by all lookups.
+ *
+ *                  Lookups return candidates in the order of the source
+ *                  collection, so sums over them are identical to sums over
+ *                  the full collection.
+ *
+ * =====================================================================================
+ */
+
+#ifndef PFCANDIDATEINDEX_H_3KQ8TV2W
+#define PFCANDIDATEINDEX_H_3KQ8TV2W
+
+#include "DataFormats/Candidate/interface/Particle.h"
+#include "DataFormats/ParticleFlowCandidate/interface/PFCandidate.h"
+#include "DataFormats/ParticleFlowCandidate/interface/PFCandidateFwd.h"
+#include "DataFormats/VertexReco/interface/Vertex.h"
+#include "DataFormats/VertexReco/interface/VertexFwd.h"
+#include "DataFormats/BeamSpot/interface/BeamSpot.h"
+
+#include "FinalStateAnalysis/DataAlgos/interface/EtaPhiIndex.h"
+#include "FinalStateAnalysis/PatTools/interface/pfCandAuxFunctions.h"
+
+#include <vector>
+
+class PFCandidateIndex {
+  public:
+    explicit PFCandidateIndex(double cellSize=0.5);
+
+    /// Index [pfCandidates].  Clears the previous content and the cached
+    /// vertex associations.  The collection must outlive the index content.
+    void fill(const reco::PFCandidateCollection& pfCandidates);
+
+    /// All candidates of [type], in collection order
+    const std::vector<const reco::PFCandidate*>& candidates(
+        reco::PFCandidate::ParticleType type) const;
+
+    /// Get the candidates of [type] which may be within [radius] of [axis],
+    /// in collection order.  This is a superset of the candidates in the
+    /// cone; it includes all the candidates whose direction is not finite,
+    /// which a deltaR cut can't reject.  The output is cleared first.
+    void near(reco::PFCandidate::ParticleType type,
+        const reco::Particle::Vector& axis, double radius,
+        std::vector<const reco::PFCandidate*>& output) const;
+
+    /// Same as above, giving the positions in candidates(type)
+    void near(reco::PFCandidate::ParticleType type,
+        const reco::Particle::Vector& axis, double radius,
+        std::vector<size_t>& output) const;
+
+    /// findVertex(..) for the track of the [i]th candidate of [type].  The
+    /// result is cached until the next fill(..), or until it is called with
+    /// different vertices, deltaZ or beamspot.
+    const reco::Vertex* vertex(reco::PFCandidate::ParticleType type, size_t i,
+        const reco::VertexCollection& vertices, double deltaZ,
+        const reco::BeamSpot& bs) const;
+
+    /// findVertex(..) for any [track] (i.e. the signal tracks of a lepton),
+    /// using the same hashed vertex tracks.  Not cached.
+    const reco::Vertex* trackVertex(const reco::Track* track,
+        const reco::VertexCollection& vertices, double deltaZ,
+        const reco::BeamSpot& bs) const;
+
+  private:
+    struct Bucket {
+      Bucket(double cellSize):index(cellSize){}
+      std::vector<const reco::PFCandidate*> candidates;
+      EtaPhiIndex index;
+      // Positions of the candidates with a non-finite direction
+      std::vector<size_t> unindexed;
+      // Cached vertex association, by position
+      mutable std::vector<const reco::Vertex*> vertices;
+      mutable std::vector<char> vertexDone;
+    };
+
+    const Bucket& bucket(reco::PFCandidate::ParticleType type) const;
+    // Reset the cached vertex associations if the arguments changed
+    void useVertices(const reco::VertexCollection& vertices, double deltaZ,
+        const reco::BeamSpot& bs) const;
+
+    std::vector<Bucket> buckets_;
+
+    // What the cached vertex associations were computed for
+    mutable const reco::VertexCollection* cachedVertices_;
+    mutable double cachedDeltaZ_;
+    mutable const reco::BeamSpot* cachedBeamSpot_;
+    mutable VertexTrackMatcher vertexMatcher_;
+
+    mutable std::vector<size_t> positions_;
+};
+
+#endif /* end of include guard: PFCANDIDATEINDEX_H_3KQ8TV2W */
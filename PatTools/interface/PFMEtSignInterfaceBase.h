@@ -32,31 +32,34 @@
 #include "DataFormats/ParticleFlowCandidate/interface/PFCandidate.h"
 #include "DataFormats/TrackReco/interface/Track.h"
 #include "DataFormats/Candidate/interface/Candidate.h"
+#include "DataFormats/Math/interface/Error.h"
 
-#include <TMatrixD.h>
-
-#include <list>
+#include <vector>
 
 class PFMEtSignInterfaceBase
 {
  public:
 
+  // (PF)MEt covariance matrix in the x-y plane
+  typedef math::Error<2>::type Covariance;
+
   PFMEtSignInterfaceBase(const edm::ParameterSet&);
   ~PFMEtSignInterfaceBase();
 
-  TMatrixD operator()(const std::list<const reco::Candidate*>&) const;
+  Covariance operator()(const std::vector<const reco::Candidate*>&) const;
 
  protected:
 
-  TMatrixD operator()(const std::vector<metsig::SigInputObj>&) const;
+  Covariance operator()(const std::vector<metsig::SigInputObj>&) const;
 
   template <typename T>
   void addPFMEtSignObjects(std::vector<metsig::SigInputObj>& metSignObjects,
-			   const std::list<const T*>& particles) const
+			   const std::vector<const T*>& particles) const
   {
     if ( this->verbosity_ ) std::cout << "<PFMEtSignInterfaceBase::addPFMEtSignObjects>:" << std::endl;
 
-    for ( typename std::list<const T*>::const_iterator particle = particles.begin();
+    metSignObjects.reserve(metSignObjects.size() + particles.size());
+    for ( typename std::vector<const T*>::const_iterator particle = particles.begin();
 	  particle != particles.end(); ++particle ) {
       double pt   = (*particle)->pt();
       double eta  = (*particle)->eta();
@@ -123,6 +126,9 @@ class PFMEtSignInterfaceBase
 
   metsig::SignAlgoResolutions* pfMEtResolution_;
 
+  // Reused between calls, to avoid reallocating it for every event
+  mutable std::vector<metsig::SigInputObj> pfMEtSignObjects_;
+
   int verbosity_;
 };
 
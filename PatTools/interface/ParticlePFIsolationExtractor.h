@@ -10,6 +10,9 @@
  *
  * Originally in TauAnalysis/RecoTools
  *
+ * The candidates can be given as a PFCandidateIndex, filled once per event.
+ * Only the candidates near the cone axis are then considered, with one
+ * lookup per particle type for all the configured cones.
  *
  */
 
@@ -31,6 +34,7 @@
 
 #include "FinalStateAnalysis/PatTools/interface/PATLeptonTrackVectorExtractor.h"
 #include "FinalStateAnalysis/PatTools/interface/pfCandAuxFunctions.h"
+#include "FinalStateAnalysis/PatTools/interface/PFCandidateIndex.h"
 
 #include <TMath.h>
 
@@ -57,7 +61,8 @@ class ParticlePFIsolationExtractor
     methodPUcorr_(kNone),
     trackExtractor_(0),
     pfNeutralHadronIsoPUcorr_(0),
-    pfPhotonIsoPUcorr_(0)
+    pfPhotonIsoPUcorr_(0),
+    searchRadius_(0.)
   {
     if( cfg.exists("chargedHadronIso") ) {
       edm::ParameterSet cfgChargedHadronIso = cfg.getParameter<edm::ParameterSet>("chargedHadronIso");
@@ -122,6 +127,10 @@ class ParticlePFIsolationExtractor
 	}
       }
     }
+
+    // The PU corrections use the same cones
+    searchRadius_ = TMath::Max(pfChargedHadronIsoConeSize_,
+      TMath::Max(pfNeutralHadronIsoConeSize_, pfPhotonIsoConeSize_));
   }
   ~ParticlePFIsolationExtractor()
   {
@@ -139,32 +148,47 @@ class ParticlePFIsolationExtractor
 		    const reco::PFCandidateCollection& pfCandidates,
 		    const reco::VertexCollection* vertices = 0, const reco::BeamSpot* beamSpot = 0, double rhoFastJetCorrection = 0.)
   {
-    reco::Particle::Vector coneAxis;
-    if      ( direction == kDirP4    ) coneAxis = lepton.momentum();
-    else if ( direction == kDirTrack ) {
-      const reco::Track* leadingTrack = 0;
-      std::vector<const reco::Track*> signalTracks = (*trackExtractor_)(lepton);
-      for ( std::vector<const reco::Track*>::const_iterator signalTrack = signalTracks.begin();
-	    signalTrack != signalTracks.end(); ++signalTrack ) {
-	if ( leadingTrack == 0 || (*signalTrack)->pt() > leadingTrack->pt() ) leadingTrack = (*signalTrack);
-      }
-      if ( leadingTrack ) coneAxis = leadingTrack->momentum();
-      else                coneAxis = lepton.momentum();
-    } else throw cms::Exception("ParticlePFIsolationExtractor")
-	<< "Invalid function argument 'direction' = " << direction << " !!\n";
-
-    return this->operator()(lepton, coneAxis, pfCandidates, vertices, beamSpot, rhoFastJetCorrection);
+    return this->operator()(lepton, getConeAxis(lepton, direction), pfCandidates, vertices, beamSpot, rhoFastJetCorrection);
   }
 
   double operator()(const T& lepton, const reco::Particle::Vector& coneAxis,
 		    const reco::PFCandidateCollection& pfCandidates,
 		    const reco::VertexCollection* vertices = 0, const reco::BeamSpot* beamSpot = 0, double rhoFastJetCorrection = 0.)
   {
-    std::vector<const reco::PFCandidate*> pfChargedHadrons, pfNeutralHadrons, pfPhotons;
+    ownIndex_.fill(pfCandidates);
+    return this->operator()(lepton, coneAxis, ownIndex_, vertices, beamSpot, rhoFastJetCorrection);
+  }
+
+  double operator()(const T& lepton, int direction,
+		    const PFCandidateIndex& pfCandidates,
+		    const reco::VertexCollection* vertices = 0, const reco::BeamSpot* beamSpot = 0, double rhoFastJetCorrection = 0.)
+  {
+    return this->operator()(lepton, getConeAxis(lepton, direction), pfCandidates, vertices, beamSpot, rhoFastJetCorrection);
+  }
+
+  double operator()(const T& lepton, const reco::Particle::Vector& coneAxis,
+		    const PFCandidateIndex& pfCandidates,
+		    const reco::VertexCollection* vertices = 0, const reco::BeamSpot* beamSpot = 0, double rhoFastJetCorrection = 0.)
+  {
+    // Only the candidates near the axis can pass the largest cone;
+    // they are kept in collection order, so the sums don't change.
+    std::vector<const reco::PFCandidate*>& pfChargedHadrons = pfChargedHadrons_;
+    std::vector<const reco::PFCandidate*>& pfNeutralHadrons = pfNeutralHadrons_;
+    std::vector<const reco::PFCandidate*>& pfPhotons = pfPhotons_;
+    pfChargedHadrons.clear();
+    pfNeutralHadrons.clear();
+    pfPhotons.clear();
+    chargedHadronPositions_.clear();
     if ( addChargedHadronIso_   ||
-	 methodPUcorr_ != kNone ) pfChargedHadrons = getPFCandidatesOfType(pfCandidates, reco::PFCandidate::h);
-    if ( addNeutralHadronIso_   ) pfNeutralHadrons = getPFCandidatesOfType(pfCandidates, reco::PFCandidate::h0);
-    if ( addPhotonIso_          ) pfPhotons        = getPFCandidatesOfType(pfCandidates, reco::PFCandidate::gamma);
+	 methodPUcorr_ != kNone ) {
+      pfCandidates.near(reco::PFCandidate::h, coneAxis, searchRadius_, chargedHadronPositions_);
+      const std::vector<const reco::PFCandidate*>& allChargedHadrons = pfCandidates.candidates(reco::PFCandidate::h);
+      for ( size_t iPosition = 0; iPosition < chargedHadronPositions_.size(); ++iPosition ) {
+	pfChargedHadrons.push_back(allChargedHadrons[chargedHadronPositions_[iPosition]]);
+      }
+    }
+    if ( addNeutralHadronIso_   ) pfCandidates.near(reco::PFCandidate::h0, coneAxis, searchRadius_, pfNeutralHadrons);
+    if ( addPhotonIso_          ) pfCandidates.near(reco::PFCandidate::gamma, coneAxis, searchRadius_, pfPhotons);
 
     double sumPt = 0.;
 
@@ -179,8 +203,28 @@ class ParticlePFIsolationExtractor
       std::vector<const reco::Track*> signalTracks = (*trackExtractor_)(lepton);
       //std::cout << " #signalTracks = " << signalTracks.size() << std::endl;
 
+      // Split the charged hadrons into those from the vertices of the
+      // signal tracks and pile-up.  The vertex association of the
+      // PFCandidates is cached in the index, and the vertex tracks are
+      // hashed once per event.
+      std::vector<const reco::Vertex*> signalVertices;
+      for ( std::vector<const reco::Track*>::const_iterator signalTrack = signalTracks.begin();
+	    signalTrack != signalTracks.end(); ++signalTrack ) {
+	const reco::Vertex* signalVertex = pfCandidates.trackVertex(*signalTrack, *vertices, deltaZ_, *beamSpot);
+	if ( signalVertex != 0 ) signalVertices.push_back(signalVertex);
+      }
       std::vector<const reco::PFCandidate*> pfNoPileUpChargedHadrons, pfPileUpChargedHadrons;
-      getPileUpPFCandidates(pfChargedHadrons, signalTracks, *vertices, deltaZ_, *beamSpot, pfNoPileUpChargedHadrons, pfPileUpChargedHadrons);
+      for ( size_t iPosition = 0; iPosition < chargedHadronPositions_.size(); ++iPosition ) {
+	const reco::PFCandidate* pfChargedHadron = pfChargedHadrons[iPosition];
+	if ( pfChargedHadron->trackRef().isNull() ) continue;
+	const reco::Vertex* pfChargedHadronVertex = pfCandidates.vertex(
+	  reco::PFCandidate::h, chargedHadronPositions_[iPosition], *vertices, deltaZ_, *beamSpot);
+	if ( isSignalVertexAssociated(pfChargedHadronVertex, signalVertices) ) {
+	  pfNoPileUpChargedHadrons.push_back(pfChargedHadron);
+	} else {
+	  pfPileUpChargedHadrons.push_back(pfChargedHadron);
+	}
+      }
       //std::cout << " #pfNoPileUpChargedHadrons = " << pfNoPileUpChargedHadrons.size() << std::endl;
       //std::cout << " #pfPileUpChargedHadrons = " << pfPileUpChargedHadrons.size() << std::endl;
 
@@ -240,6 +284,24 @@ class ParticlePFIsolationExtractor
 
  private:
 
+  reco::Particle::Vector getConeAxis(const T& lepton, int direction)
+  {
+    reco::Particle::Vector coneAxis;
+    if      ( direction == kDirP4    ) coneAxis = lepton.momentum();
+    else if ( direction == kDirTrack ) {
+      const reco::Track* leadingTrack = 0;
+      std::vector<const reco::Track*> signalTracks = (*trackExtractor_)(lepton);
+      for ( std::vector<const reco::Track*>::const_iterator signalTrack = signalTracks.begin();
+	    signalTrack != signalTracks.end(); ++signalTrack ) {
+	if ( leadingTrack == 0 || (*signalTrack)->pt() > leadingTrack->pt() ) leadingTrack = (*signalTrack);
+      }
+      if ( leadingTrack ) coneAxis = leadingTrack->momentum();
+      else                coneAxis = lepton.momentum();
+    } else throw cms::Exception("ParticlePFIsolationExtractor")
+	<< "Invalid function argument 'direction' = " << direction << " !!\n";
+    return coneAxis;
+  }
+
   struct pfIsoConfigType
   {
     pfIsoConfigType(reco::PFCandidate::ParticleType pfParticleType, const edm::ParameterSet& cfg)
@@ -344,6 +406,14 @@ class ParticlePFIsolationExtractor
   pfIsoConfigType* pfPhotonIsoPUcorr_;
 
   double ueRhoOffset_;
+
+  // Largest of the configured cones
+  double searchRadius_;
+  // Used when called with a PFCandidateCollection
+  PFCandidateIndex ownIndex_;
+  // Reused between calls
+  std::vector<size_t> chargedHadronPositions_;
+  std::vector<const reco::PFCandidate*> pfChargedHadrons_, pfNeutralHadrons_, pfPhotons_;
 };
 
 }
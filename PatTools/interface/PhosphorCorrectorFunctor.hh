@@ -77,16 +77,34 @@ namespace zgamma{
 	       Pt3
     };
     
-    // string MapKey;//fotmat Year_DataType_DetType_CorrType_PtBin
-    map < string, double > CorrMap;
-    map < string, double > ErrMap;
+    //Dimensions of the correction table
+    enum TableDims {nYears = 2,
+                    nDataTypes = 3,//mc, data, mc_fit
+                    nDetTypes = 2,
+                    nR9Cats = 3,//Inc, high, low
+                    nCorrTypes = 2,
+                    nPtBins = 4,
+                    nTableCells = nYears*nDataTypes*nDetTypes*nR9Cats*nCorrTypes*nPtBins
+    };
+
+    //Dense correction table, filled once from the MAP FILE and indexed by TableCell(..)
+    double CorrTable[nTableCells];
+    double ErrTable[nTableCells];
+    bool InTable[nTableCells];
+    int TableEntries;//Number of filled cells
+    bool R9Table;//The table has R9 categories (inclusive only otherwise)
     map < int, int > CatMap;
     ifstream MapFile;
     const char* filename;
 
     //Private Methods
-    std::string CreateMapKey(int Year, int DataType, int DetType, int CorrType, int PtBin);// Creates key in inclusive R9 categories
-    std::string CreateMapKey(int Year, int DataType, int DetType,int R9Cat, int CorrType, int PtBin);// Creates key including R9 categories
+    void ClearTable();
+    int TableCell(int Year, int DataType, int DetType, int R9Cat, int CorrType, int PtBin) const;// Cell index, -1 if out of the table range
+    void FillTable(int Year, int DataType, int DetType, int R9Cat, int CorrType, int PtBin, double Corr, double Err);
+    int TableIndex(int Year, int DataType, int DetType, int CorrType, int PtBin) const;// Filled cell in inclusive R9 categories, -1 if none
+    int TableIndex(int Year, int DataType, int DetType,int R9Cat, int CorrType, int PtBin) const;// Filled cell including R9 categories, -1 if none
+    inline double TableCorr(int index) const {return index < 0 ? 0. : CorrTable[index];};//0 if missing
+    inline double TableErr(int index) const {return index < 0 ? 0. : ErrTable[index];};//0 if missing
 
     TRandom3* rand;
     
@@ -28,6 +28,19 @@ namespace rochcor {
     
     void momcor_mc(TLorentzVector&, float, float, int, float&);
     void momcor_data(TLorentzVector&, float, float, int, float&);
+
+    // Batch versions: correct n muons, given as (px, py, pz, E) arrays, in
+    // place.  The MC smearing uses the standard normal deviates in
+    // [normals], one per muon, instead of drawing them; with deviates from
+    // drawNormals(..) in the same order, the results are identical to calling
+    // the single muon versions on each muon in turn.
+    void momcor_mc(size_t n, double* px, double* py, double* pz, double* e,
+		   const float* charge, float sysdev, int runopt, float* qter,
+		   const double* normals);
+    void momcor_data(size_t n, double* px, double* py, double* pz, double* e,
+		     const float* charge, float sysdev, int runopt, float* qter);
+    // Draw n standard normal deviates from the smearing random stream
+    void drawNormals(size_t n, double* output);
     
     void musclefit_data(TLorentzVector& , TLorentzVector&);
     
@@ -36,6 +49,8 @@ namespace rochcor {
     int phibin(float);
     
   private:
+    // momcor_mc with the given standard normal deviate for the smearing
+    void momcor_mc(TLorentzVector&, float, float, int, float&, double);
     
     edm::Service<edm::RandomNumberGenerator> rng;  
     
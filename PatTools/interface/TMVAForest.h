@@ -0,0 +1,75 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  TMVAForest.h
+ *
+ *    Description:  Native evaluator for the boosted decision trees trained
+ *                  with TMVA (MethodBDT).  The trees are read from the TMVA
+ *                  weight xml file (optionally gzipped) into one flat array
+ *                  of nodes, so evaluating doesn't need a TMVA::Reader, and
+ *                  many objects can be evaluated in one call.
+ *
+ *                  The response is identical to TMVA::Reader::EvaluateMVA:
+ *                  the cuts and leaf values are kept with the (float)
+ *                  precision TMVA uses, the same cut direction is applied,
+ *                  and the trees are summed in the same order.
+ *
+ *                  Only the gradient (Grad), AdaBoost and Bagging forests
+ *                  without input variable transformations are supported.
+ *                  load(..) returns false for anything else, so the caller
+ *                  can fall back on TMVA.
+ *
+ * =====================================================================================
+ */
+
+#ifndef TMVAFOREST_H_7WQ2LP4D
+#define TMVAFOREST_H_7WQ2LP4D
+
+#include <string>
+#include <vector>
+
+class TMVAForest {
+  public:
+    TMVAForest();
+
+    /// Load the BDT in the weight file [path].  The [variables] are the
+    /// expressions of the input variables, in the order they are given to
+    /// evaluate(..); they must match the weight file, as for a TMVA::Reader.
+    /// Returns false, and leaves the forest empty, if the file can't be
+    /// evaluated by this class.
+    bool load(const std::string& path,
+        const std::vector<std::string>& variables);
+
+    bool isLoaded() const { return !roots_.empty(); }
+    size_t nVariables() const { return nVariables_; }
+
+    /// Evaluate one object.  [inputs] holds nVariables() values.
+    double evaluate(const float* inputs) const;
+
+    /// Evaluate [n] objects.  [inputs] holds nVariables() values for each
+    /// object, one object after the other.
+    void evaluate(size_t n, const float* inputs, double* output) const;
+
+  private:
+    struct Node {
+      // Index of the cut variable, -1 for a leaf
+      int variable;
+      // The cut value, or the response of a leaf
+      float value;
+      // The next node if the value is below/at or above the cut
+      unsigned children[2];
+    };
+
+    void clear();
+
+    size_t nVariables_;
+    // Combine the trees as a gradient boost (as opposed to a weighted
+    // average)
+    bool gradBoost_;
+    std::vector<Node> nodes_;
+    std::vector<unsigned> roots_;
+    // Weight of each tree in the average
+    std::vector<double> treeWeights_;
+};
+
+#endif /* end of include guard: TMVAFOREST_H_7WQ2LP4D */
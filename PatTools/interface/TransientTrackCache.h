@@ -0,0 +1,58 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  TransientTrackCache.h
+ *
+ *    Description:  Per-event cache of the reco::TransientTracks built from
+ *                  the lepton tracks, so each track is only built (with the
+ *                  magnetic field lookup) once per event in a module, no
+ *                  matter how many final states use it
+ *                  (PATFinalStateVertexFitter).
+ *
+ *                  Tracks are identified by the address of the referenced
+ *                  track, which is unique within the event (unlike the Ref
+ *                  of a track embedded in a PAT object), and by whether they
+ *                  are built as GSF tracks.
+ *
+ * =====================================================================================
+ */
+
+#ifndef TRANSIENTTRACKCACHE_H_8DPV3KX5
+#define TRANSIENTTRACKCACHE_H_8DPV3KX5
+
+#include "DataFormats/TrackReco/interface/Track.h"
+#include "DataFormats/TrackReco/interface/TrackFwd.h"
+#include "DataFormats/GsfTrackReco/interface/GsfTrackFwd.h"
+
+#include "TrackingTools/TransientTrack/interface/TransientTrack.h"
+
+#include <map>
+#include <utility>
+
+class TransientTrackBuilder;
+
+class TransientTrackCache {
+  public:
+    TransientTrackCache();
+
+    /// Forget the tracks of the previous event, and build the new ones
+    /// with [builder].  Must be called at the start of each event.
+    void reset(const TransientTrackBuilder* builder);
+
+    /// The transient track of [track], built on the first call in the event
+    const reco::TransientTrack& get(const reco::TrackRef& track);
+    const reco::TransientTrack& get(const reco::GsfTrackRef& track);
+
+    /// Number of tracks built in the current event
+    size_t size() const { return tracks_.size(); }
+
+  private:
+    enum Kind { kTrack, kGsfTrack };
+    typedef std::pair<const reco::Track*, int> Key;
+    typedef std::map<Key, reco::TransientTrack> TrackMap;
+
+    const TransientTrackBuilder* builder_;
+    TrackMap tracks_;
+};
+
+#endif /* end of include guard: TRANSIENTTRACKCACHE_H_8DPV3KX5 */
@@ -0,0 +1,52 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  VertexFitLegs.h
+ *
+ *    Description:  The lepton tracks used to fit the vertex of a final state
+ *                  (PATFinalStateVertexFitter).
+ *
+ *                  Muons use the inner track, electrons the GSF track, and
+ *                  taus the track of the leading signal charged hadron.
+ *
+ *                  The legs are identified by the daughter Ptr, not by the
+ *                  track Ref: tracks embedded in the PAT objects
+ *                  (embedTrack = True) all have a null ProductID and key 0.
+ *
+ * =====================================================================================
+ */
+
+#ifndef VERTEXFITLEGS_H_4QZW8XNC
+#define VERTEXFITLEGS_H_4QZW8XNC
+
+#include "DataFormats/Candidate/interface/CandidateFwd.h"
+#include "DataFormats/TrackReco/interface/TrackFwd.h"
+#include "DataFormats/GsfTrackReco/interface/GsfTrackFwd.h"
+
+#include <vector>
+
+class PATFinalState;
+
+/// The track used in the fit for a given leg
+struct VertexFitLeg {
+  VertexFitLeg():valid(false){}
+  bool valid;
+  // The daughter the track belongs to
+  reco::CandidatePtr cand;
+  // Only one of them is set
+  reco::TrackRef track;
+  reco::GsfTrackRef gsfTrack;
+  bool operator<(const VertexFitLeg& other) const {
+    return cand < other.cand;
+  }
+};
+
+/// Get the fit track of [cand].  The leg is not valid if it has none.
+VertexFitLeg vertexFitLeg(const reco::CandidatePtr& cand);
+
+/// Get the fit tracks of all the daughters of [finalState], sorted by
+/// daughter, so the fit doesn't depend on the order of the daughters.
+/// Empty if any daughter has no track.
+std::vector<VertexFitLeg> vertexFitLegs(const PATFinalState& finalState);
+
+#endif /* end of include guard: VERTEXFITLEGS_H_4QZW8XNC */
@@ -9,12 +9,47 @@
 #include "DataFormats/VertexReco/interface/VertexFwd.h"
 #include "DataFormats/BeamSpot/interface/BeamSpot.h"
 
+#include <boost/unordered_map.hpp>
+
 #include <vector>
 
+// Per-event lookup of the vertex tracks matched by findVertex(..).  The
+// tracks of all vertices are hashed by their (eta, phi), so the match for a
+// track is found without scanning every track of every vertex.  The result
+// is the same as the scan: the first vertex with a matching track.
+class VertexTrackMatcher
+{
+ public:
+  VertexTrackMatcher();
+  explicit VertexTrackMatcher(const reco::VertexCollection&);
+
+  void fill(const reco::VertexCollection&);
+  // The vertices the matcher was filled with (0 if none)
+  const reco::VertexCollection* vertices() const { return vertices_; }
+  // The first vertex with a track matching [track] in eta, phi and pt, or 0
+  const reco::Vertex* match(const reco::Track*) const;
+
+ private:
+  struct TrackEntry
+  {
+    double eta_;
+    double phi_;
+    double pt_;
+    size_t vertex_;
+  };
+  typedef boost::unordered_map<long long, std::vector<TrackEntry> > CellMap;
+  static long long cellKey(long long, long long);
+  const reco::VertexCollection* vertices_;
+  // Entries in the order of the scan over vertices and tracks
+  CellMap cells_;
+};
+
+
 std::vector<const reco::PFCandidate*> getPFCandidatesOfType(const reco::PFCandidateCollection&, reco::PFCandidate::ParticleType);
-void getPileUpPFCandidates(const std::vector<const reco::PFCandidate*>&, const std::vector<const reco::Track*>&,
-			   const reco::VertexCollection&, double, const reco::BeamSpot&,
-			   std::vector<const reco::PFCandidate*>&, std::vector<const reco::PFCandidate*>&);
+// Whether a PFCandidate associated to the given vertex is from the same vertex as the lepton
+bool isSignalVertexAssociated(const reco::Vertex*, const std::vector<const reco::Vertex*>&);
 const reco::Vertex* findVertex(const reco::Track*, const reco::VertexCollection&, double, const reco::BeamSpot&);
+// Same as above, using the hashed vertex tracks
+const reco::Vertex* findVertex(const reco::Track*, const VertexTrackMatcher&, double, const reco::BeamSpot&);
 
 #endif
@@ -0,0 +1,113 @@
+/*
+ * Run a list of embedders on a single copy of a PAT object collection.
+ *
+ * See PATObjectEmbedFunctor.h.  Example:
+ *
+ * patMuonsEmbedded = cms.EDProducer(
+ *     "PATMuonCompositeEmbedder",
+ *     src = cms.InputTag("selectedPatMuons"),
+ *     embedders = cms.VPSet(
+ *         cms.PSet(
+ *             type = cms.string("MuonRhoOverloader"),
+ *             srcRho = cms.InputTag("kt6PFJetsForRhoComputationVoronoi", "rho"),
+ *         ),
+ *         cms.PSet(
+ *             type = cms.string("PATMuonIpEmbedder"),
+ *             vtxSrc = cms.InputTag("selectedPrimaryVertex"),
+ *         ),
+ *     )
+ * )
+ *
+ * The python helper FinalStateAnalysis.PatTools.compositeEmbedders can fuse
+ * the embedders in an existing sequence.
+ *
+ */
+
+#include "FinalStateAnalysis/PatTools/plugins/PATObjectEmbedFunctor.h"
+
+#include "FinalStateAnalysis/PatTools/plugins/PATObjectEmbedRho.h"
+#include "FinalStateAnalysis/PatTools/plugins/PATObjectValueMapEmbedder.h"
+#include "FinalStateAnalysis/PatTools/plugins/PATLeptonIpEmbedder.h"
+#include "FinalStateAnalysis/PatTools/plugins/PATMuonIdEmbedder.h"
+#include "FinalStateAnalysis/PatTools/plugins/PATMuonEAEmbedder.h"
+#include "FinalStateAnalysis/PatTools/plugins/PATJetIdEmbedder.h"
+#include "FinalStateAnalysis/PatTools/plugins/PATJetPUIDEmbedder.h"
+
+#include "DataFormats/PatCandidates/interface/Muon.h"
+#include "DataFormats/PatCandidates/interface/Electron.h"
+#include "DataFormats/PatCandidates/interface/Tau.h"
+#include "DataFormats/PatCandidates/interface/Photon.h"
+#include "DataFormats/PatCandidates/interface/Jet.h"
+
+template<>
+PATObjectEmbedFunctor<pat::Muon>* makeEmbedFunctor<pat::Muon>(
+    const std::string& type, const edm::ParameterSet& pset) {
+  if (type == "MuonRhoOverloader")
+    return new PATRhoEmbedFunctor<pat::Muon>(pset);
+  if (type == "PATMuonValueMapEmbedder")
+    return new PATValueMapEmbedFunctor<pat::Muon>(pset);
+  if (type == "PATMuonIpEmbedder")
+    return new PATLeptonIpEmbedFunctor<pat::Muon>(pset);
+  if (type == "PATMuonIdEmbedder")
+    return new PATMuonIdEmbedFunctor(pset);
+  if (type == "PATMuonEAEmbedder")
+    return new PATMuonEAEmbedFunctor(pset);
+  return NULL;
+}
+
+template<>
+PATObjectEmbedFunctor<pat::Electron>* makeEmbedFunctor<pat::Electron>(
+    const std::string& type, const edm::ParameterSet& pset) {
+  if (type == "ElectronRhoOverloader")
+    return new PATRhoEmbedFunctor<pat::Electron>(pset);
+  if (type == "PATElectronValueMapEmbedder")
+    return new PATValueMapEmbedFunctor<pat::Electron>(pset);
+  if (type == "PATElectronIpEmbedder")
+    return new PATLeptonIpEmbedFunctor<pat::Electron>(pset);
+  return NULL;
+}
+
+template<>
+PATObjectEmbedFunctor<pat::Tau>* makeEmbedFunctor<pat::Tau>(
+    const std::string& type, const edm::ParameterSet& pset) {
+  if (type == "TauRhoOverloader")
+    return new PATRhoEmbedFunctor<pat::Tau>(pset);
+  if (type == "PATTauValueMapEmbedder")
+    return new PATValueMapEmbedFunctor<pat::Tau>(pset);
+  if (type == "PATTauIpEmbedder")
+    return new PATLeptonIpEmbedFunctor<pat::Tau>(pset);
+  return NULL;
+}
+
+template<>
+PATObjectEmbedFunctor<pat::Photon>* makeEmbedFunctor<pat::Photon>(
+    const std::string& type, const edm::ParameterSet& pset) {
+  if (type == "PhotonRhoOverloader")
+    return new PATRhoEmbedFunctor<pat::Photon>(pset);
+  return NULL;
+}
+
+template<>
+PATObjectEmbedFunctor<pat::Jet>* makeEmbedFunctor<pat::Jet>(
+    const std::string& type, const edm::ParameterSet& pset) {
+  if (type == "PATJetValueMapEmbedder")
+    return new PATValueMapEmbedFunctor<pat::Jet>(pset);
+  if (type == "PATJetIdEmbedder")
+    return new PATJetIdEmbedFunctor(pset);
+  if (type == "PATJetPUIDEmbedder")
+    return new PATJetPUIDEmbedFunctor(pset);
+  return NULL;
+}
+
+typedef PATCompositeEmbedder<pat::Muon> PATMuonCompositeEmbedder;
+typedef PATCompositeEmbedder<pat::Electron> PATElectronCompositeEmbedder;
+typedef PATCompositeEmbedder<pat::Tau> PATTauCompositeEmbedder;
+typedef PATCompositeEmbedder<pat::Photon> PATPhotonCompositeEmbedder;
+typedef PATCompositeEmbedder<pat::Jet> PATJetCompositeEmbedder;
+
+#include "FWCore/Framework/interface/MakerMacros.h"
+DEFINE_FWK_MODULE(PATMuonCompositeEmbedder);
+DEFINE_FWK_MODULE(PATElectronCompositeEmbedder);
+DEFINE_FWK_MODULE(PATTauCompositeEmbedder);
+DEFINE_FWK_MODULE(PATPhotonCompositeEmbedder);
+DEFINE_FWK_MODULE(PATJetCompositeEmbedder);
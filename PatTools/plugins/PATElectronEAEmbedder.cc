@@ -42,6 +42,7 @@ private:
   InputTag _src,;
   vstring _eas_to_get;  
   PATElectronEACalculator _eacalc;
+  std::vector<double> _eas;
   
 };
 
@@ -50,6 +51,7 @@ PATElectronEAEmbedder::PATElectronEAEmbedder(const
   :_eacalc(PATElectronEACalculator(pset.getParameterSetVector("effective_areas"))){
   _eas_to_get = pset.getParameter<vstring>("applied_effective_areas");
   _src = pset.getParameter<InputTag>("src");  
+  _eacalc.setEATypes(_eas_to_get);
   produces<ElectronCollection>();
 }
 
@@ -62,24 +64,16 @@ void PATElectronEAEmbedder::produce(Event& evt,
   edm::Handle<ElectronCollection> handle;
   evt.getByLabel(_src, handle);
   
-  vstring::const_iterator i;
-  vstring::const_iterator e = _eas_to_get.end();
-
   // Check if our inputs are in our outputs
   for (size_t iEle = 0; iEle < handle->size(); ++iEle) {
     const Electron* currentElectron = &(handle->at(iEle));   
     Electron newElectron = *currentElectron;    
-      
-    for( i = _eas_to_get.begin(); i != e; ++i ) {
-      
-      _eacalc.setEAType(*i);
 
-      double the_ea = _eacalc(*currentElectron);
-
-      //std::cout << "electron effective area = " << the_ea << std::endl;
-
-      newElectron.addUserFloat(*i,the_ea);    
-    }
+    // all the requested effective areas at once
+    _eacalc(*currentElectron, _eas);
+      
+    for( size_t i = 0; i < _eas_to_get.size(); ++i ) 
+      newElectron.addUserFloat(_eas_to_get[i],_eas[i]);    
     output->push_back(newElectron);
   }
 
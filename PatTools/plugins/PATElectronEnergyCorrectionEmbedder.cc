@@ -64,15 +64,16 @@ void PATElectronEnergyCorrectionEmbedder::produce(Event& evt,
   edm::Handle<ElectronCollection> eles;
   evt.getByLabel(_src,eles);
 
+  out->reserve(eles->size());
+
   ElectronCollection::const_iterator b = eles->begin();
   ElectronCollection::const_iterator i = b;
   ElectronCollection::const_iterator e = eles->end();
 
   for( ; i != e; ++i ) {
     ElectronRef ref(eles,i - b);
-    std::auto_ptr<pat::Electron> cEle = _corr(ref);
-
-    out->push_back(*cEle);
+    out->push_back(*i);
+    _corr(ref,out->back());
   }
   
   evt.put(out);
@@ -31,6 +31,8 @@ class PATElectronMVAIDEmbedder : public edm::EDProducer {
     ElectronIDMVA mva_;
     double maxDB_;
     double maxDZ_;
+    std::vector<const reco::GsfElectron*> mvaInputs_;
+    std::vector<double> mvaValues_;
 };
 
 PATElectronMVAIDEmbedder::PATElectronMVAIDEmbedder(const edm::ParameterSet& pset) {
@@ -78,6 +80,12 @@ void PATElectronMVAIDEmbedder::produce(edm::Event& evt, const edm::EventSetup& e
   edm::Handle<reco::ConversionCollection> hConversions;
   evt.getByLabel("allConversions", hConversions);
 
+  // Evaluate the MVA for all the electrons at once
+  mvaInputs_.clear();
+  for (size_t i = 0; i < electrons->size(); ++i)
+    mvaInputs_.push_back(&electrons->at(i));
+  mva_.MVAValues(mvaInputs_, evt, es, ebRecHits_, eeRecHits_, mvaValues_);
+
   std::auto_ptr<pat::ElectronCollection> output(new pat::ElectronCollection);
   output->reserve(electrons->size());
 
@@ -121,9 +129,7 @@ void PATElectronMVAIDEmbedder::produce(edm::Event& evt, const edm::EventSetup& e
       dz = electron.gsfTrack()->dz(vtxHandle->at(0).position());
     electron.addUserFloat("idDZ", dz);
 
-    // Compute the mva value
-    double mvaV = mva_.MVAValue(
-        &electron, evt, es, ebRecHits_, eeRecHits_);
+    double mvaV = mvaValues_[i];
     // Add it as a user float
     electron.addUserFloat("MVA", mvaV);
 
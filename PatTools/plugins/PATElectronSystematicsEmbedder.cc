@@ -10,12 +10,15 @@
 
 #include "DataFormats/Candidate/interface/LeafCandidate.h"
 
+#include "FinalStateAnalysis/DataFormats/interface/PATObjectShifts.h"
+
 class PATElectronSystematicsEmbedder : public edm::EDProducer {
   public:
     // Our dataformat for storing shifted candidates
     typedef reco::LeafCandidate ShiftedCand;
     typedef std::vector<ShiftedCand> ShiftedCandCollection;
     typedef reco::CandidatePtr CandidatePtr;
+    typedef reco::Candidate::LorentzVector LorentzVector;
 
     // Muscle fit DB object
     PATElectronSystematicsEmbedder(const edm::ParameterSet& pset);
@@ -23,6 +26,8 @@ class PATElectronSystematicsEmbedder : public edm::EDProducer {
     void produce(edm::Event& evt, const edm::EventSetup& es);
   private:
     edm::InputTag src_;
+    // Store the shifts in a single PATObjectShifts
+    bool compact_;
     double nominal_;
     double eScaleUp_;
     double eScaleDown_;
@@ -34,59 +39,90 @@ PATElectronSystematicsEmbedder::PATElectronSystematicsEmbedder(
   nominal_ = pset.getParameter<double>("nominal");
   eScaleUp_ = pset.getParameter<double>("eScaleUp");
   eScaleDown_ = pset.getParameter<double>("eScaleDown");
+  compact_ = pset.exists("compact") ? pset.getParameter<bool>("compact") : false;
 
   // Embedded output collection
   produces<pat::ElectronCollection>();
-  // Collections of shifted candidates
-  produces<ShiftedCandCollection>("p4OutUncorr");
-  produces<ShiftedCandCollection>("p4OutUp");
-  produces<ShiftedCandCollection>("p4OutDown");
+  if (compact_) {
+    produces<PATObjectShifts>("shifts");
+  } else {
+    // Collections of shifted candidates
+    produces<ShiftedCandCollection>("p4OutUncorr");
+    produces<ShiftedCandCollection>("p4OutUp");
+    produces<ShiftedCandCollection>("p4OutDown");
+  }
 }
 
 void PATElectronSystematicsEmbedder::produce(edm::Event& evt, const edm::EventSetup& es) {
   std::auto_ptr<pat::ElectronCollection> output(new pat::ElectronCollection);
-  std::auto_ptr<ShiftedCandCollection> p4OutNom(new ShiftedCandCollection);
-  std::auto_ptr<ShiftedCandCollection> p4OutUp(new ShiftedCandCollection);
-  std::auto_ptr<ShiftedCandCollection> p4OutDown(new ShiftedCandCollection);
 
   edm::Handle<edm::View<pat::Electron> > electrons;
   evt.getByLabel(src_, electrons);
+  size_t nElectrons = electrons->size();
 
-  output->reserve(electrons->size());
-  p4OutNom->reserve(electrons->size());
-  p4OutUp->reserve(electrons->size());
-  p4OutDown->reserve(electrons->size());
+  output->reserve(nElectrons);
 
-  for (size_t i = 0; i < electrons->size(); ++i) {
-    pat::Electron electron = electrons->at(i); // make a local copy
+  std::auto_ptr<ShiftedCandCollection> p4OutNom(new ShiftedCandCollection);
+  std::auto_ptr<ShiftedCandCollection> p4OutUp(new ShiftedCandCollection);
+  std::auto_ptr<ShiftedCandCollection> p4OutDown(new ShiftedCandCollection);
 
-    double pt = electron.pt();
-    ShiftedCand uncorr(electron);
+  std::auto_ptr<PATObjectShifts> shifts;
+  if (compact_) {
+    std::vector<std::string> names;
+    names.push_back("uncorr");
+    names.push_back("ees-");
+    names.push_back("ees+");
+    shifts.reset(new PATObjectShifts(names, nElectrons));
+  } else {
+    p4OutNom->reserve(nElectrons);
+    p4OutUp->reserve(nElectrons);
+    p4OutDown->reserve(nElectrons);
+  }
 
-    double correctedPt = nominal_*pt;
-    double correctedPtUp = eScaleUp_*pt;
-    double correctedPtDown = eScaleDown_*pt;
+  // The shifts are computed once, and stored either way
+  for (size_t i = 0; i < nElectrons; ++i) {
+    pat::Electron electron = electrons->at(i); // make a local copy
 
+    double pt = electron.pt();
     double eta = electron.eta();
     double phi = electron.phi();
     double mass = electron.mass();
 
-    electron.setP4(reco::Particle::PolarLorentzVector(
-          correctedPt, eta, phi, mass));
+    LorentzVector uncorr = electron.p4();
+    LorentzVector eesUp(reco::Particle::PolarLorentzVector(
+          eScaleUp_*pt, eta, phi, mass));
+    LorentzVector eesDown(reco::Particle::PolarLorentzVector(
+          eScaleDown_*pt, eta, phi, mass));
 
-    ShiftedCand mesUp(electron);
-    ShiftedCand mesDown(electron);
-
-    mesUp.setP4(reco::Particle::PolarLorentzVector(
-          correctedPtUp, eta, phi, mass));
+    electron.setP4(reco::Particle::PolarLorentzVector(
+          nominal_*pt, eta, phi, mass));
+    output->push_back(electron);
 
-    mesDown.setP4(reco::Particle::PolarLorentzVector(
-          correctedPtDown, eta, phi, mass));
+    if (compact_) {
+      shifts->setP4(i, 0, uncorr);
+      shifts->setP4(i, 1, eesDown);
+      shifts->setP4(i, 2, eesUp);
+      continue;
+    }
+
+    ShiftedCand candUncorr(electron);
+    candUncorr.setP4(uncorr);
+    ShiftedCand candUp(electron);
+    candUp.setP4(eesUp);
+    ShiftedCand candDown(electron);
+    candDown.setP4(eesDown);
+
+    p4OutNom->push_back(candUncorr);
+    p4OutUp->push_back(candUp);
+    p4OutDown->push_back(candDown);
+  }
 
-    output->push_back(electron);
-    p4OutNom->push_back(uncorr);
-    p4OutUp->push_back(mesUp);
-    p4OutDown->push_back(mesDown);
+  if (compact_) {
+    edm::RefProd<PATObjectShifts> shiftsRef(evt.put(shifts, "shifts"));
+    for (size_t i = 0; i < output->size(); ++i)
+      PATObjectShifts::link(output->at(i), shiftsRef, i);
+    evt.put(output);
+    return;
   }
 
   // Put the shifted collections in the event
@@ -96,16 +132,11 @@ void PATElectronSystematicsEmbedder::produce(edm::Event& evt, const edm::EventSe
   PutHandle p4OutDownH = evt.put(p4OutDown, "p4OutDown");
 
   // Now embed the shifted collections into the output electron collection
-  for (size_t i = 0; i < electrons->size(); ++i) {
-    CandidatePtr nomPtr(p4OutDownH, i);
-    CandidatePtr upPtr(p4OutDownH, i);
-    CandidatePtr downPtr(p4OutDownH, i);
-
+  for (size_t i = 0; i < output->size(); ++i) {
     pat::Electron& electron = output->at(i);
-
-    electron.addUserCand("uncorr", nomPtr);
-    electron.addUserCand("ees-", downPtr);
-    electron.addUserCand("ees+", upPtr);
+    electron.addUserCand("uncorr", CandidatePtr(p4OutNomH, i));
+    electron.addUserCand("ees-", CandidatePtr(p4OutDownH, i));
+    electron.addUserCand("ees+", CandidatePtr(p4OutUpH, i));
   }
 
   evt.put(output);
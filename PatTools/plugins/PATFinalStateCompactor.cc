@@ -0,0 +1,97 @@
+/*
+ * Convert a collection of PATFinalStates into a PATCompactFinalStateCollection
+ *
+ * The legs are stored as indices into their input collections, and the user
+ * data embedded by the previous steps is stored in columns.
+ *
+ * Any PATFinalStateAssociations given in [associations] (which must be
+ * associated to [src]) are folded into the final states before compacting.
+ *
+ */
+
+#include "FWCore/Framework/interface/Frameworkfwd.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/EventSetup.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/Framework/interface/EDProducer.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include "FinalStateAnalysis/DataFormats/interface/PATFinalState.h"
+#include "FinalStateAnalysis/DataFormats/interface/PATFinalStateFwd.h"
+#include "FinalStateAnalysis/DataFormats/interface/PATFinalStateEvent.h"
+#include "FinalStateAnalysis/DataFormats/interface/PATCompactFinalStateCollection.h"
+#include "FinalStateAnalysis/DataFormats/interface/PATFinalStateAssociation.h"
+
+class PATFinalStateCompactor : public edm::EDProducer {
+  public:
+    PATFinalStateCompactor(const edm::ParameterSet& pset);
+    virtual ~PATFinalStateCompactor(){}
+    void produce(edm::Event& evt, const edm::EventSetup& es);
+  private:
+    edm::InputTag src_;
+    edm::InputTag evtSrc_;
+    unsigned int nLegs_;
+    std::vector<edm::InputTag> associations_;
+};
+
+PATFinalStateCompactor::PATFinalStateCompactor(
+    const edm::ParameterSet& pset) {
+  src_ = pset.getParameter<edm::InputTag>("src");
+  evtSrc_ = pset.getParameter<edm::InputTag>("evtSrc");
+  nLegs_ = pset.getParameter<unsigned int>("nLegs");
+  if (pset.exists("associations"))
+    associations_ =
+      pset.getParameter<std::vector<edm::InputTag> >("associations");
+  produces<PATCompactFinalStateCollection>();
+}
+
+void PATFinalStateCompactor::produce(
+    edm::Event& evt, const edm::EventSetup& es) {
+  edm::Handle<edm::View<PATFinalStateEvent> > fsEvent;
+  evt.getByLabel(evtSrc_, fsEvent);
+  if (fsEvent->empty()) {
+    throw cms::Exception("MissingFinalStateEvent")
+      << "PATFinalStateCompactor: no PATFinalStateEvent in "
+      << evtSrc_ << std::endl;
+  }
+  edm::Ptr<PATFinalStateEvent> evtPtr = fsEvent->ptrAt(0);
+  if (evtPtr.isNull()) {
+    throw cms::Exception("MissingFinalStateEvent")
+      << "PATFinalStateCompactor: the PATFinalStateEvent in "
+      << evtSrc_ << " is null" << std::endl;
+  }
+
+  std::auto_ptr<PATCompactFinalStateCollection> output(
+      new PATCompactFinalStateCollection(nLegs_, evtPtr));
+
+  edm::Handle<edm::View<PATFinalState> > finalStates;
+  evt.getByLabel(src_, finalStates);
+
+  std::vector<const PATFinalStateAssociation*> associations;
+  for (size_t a = 0; a < associations_.size(); ++a) {
+    edm::Handle<PATFinalStateAssociation> associationH;
+    evt.getByLabel(associations_[a], associationH);
+    if (associationH->src() != finalStates.id()) {
+      throw cms::Exception("MismatchedAssociation")
+        << "PATFinalStateCompactor: the association " << associations_[a]
+        << " is not associated to the final states " << src_ << std::endl;
+    }
+    associations.push_back(associationH.product());
+  }
+
+  for (size_t i = 0; i < finalStates->size(); ++i) {
+    if (associations.empty()) {
+      output->push_back(finalStates->at(i));
+      continue;
+    }
+    std::auto_ptr<PATFinalState> withAssociations(finalStates->at(i).clone());
+    for (size_t a = 0; a < associations.size(); ++a) {
+      associations[a]->embedInto(i, *withAssociations);
+    }
+    output->push_back(*withAssociations);
+  }
+  evt.put(output);
+}
+
+#include "FWCore/Framework/interface/MakerMacros.h"
+DEFINE_FWK_MODULE(PATFinalStateCompactor);
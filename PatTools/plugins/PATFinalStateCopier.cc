@@ -3,6 +3,12 @@
  *
  * For process naming purposes.
  *
+ * Any PATFinalStateAssociations given in [associations] (which must be
+ * associated to [src]) are folded into the single copy of each final state.
+ *
+ * If [associate] is true, no copy is made.  Instead the [associations] are
+ * merged into a single PATFinalStateAssociation to [src].
+ *
  * Author: Evan K. Friis, UW Madison
  *
  */
@@ -16,6 +22,7 @@
 #include <string>
 #include "FinalStateAnalysis/DataFormats/interface/PATFinalState.h"
 #include "FinalStateAnalysis/DataFormats/interface/PATFinalStateFwd.h"
+#include "FinalStateAnalysis/DataFormats/interface/PATFinalStateAssociation.h"
 #include "DataFormats/Candidate/interface/Candidate.h"
 #include "CommonTools/Utils/interface/StringCutObjectSelector.h"
 
@@ -27,21 +34,55 @@ class PATFinalStateCopier : public edm::EDProducer {
   private:
     edm::InputTag src_;
     std::string name_;
+    std::vector<edm::InputTag> associations_;
+    bool associate_;
 };
 
 PATFinalStateCopier::PATFinalStateCopier(
     const edm::ParameterSet& pset) {
   src_ = pset.getParameter<edm::InputTag>("src");
-  produces<PATFinalStateCollection>();
+  if (pset.exists("associations"))
+    associations_ =
+      pset.getParameter<std::vector<edm::InputTag> >("associations");
+  associate_ = pset.exists("associate") ?
+    pset.getParameter<bool>("associate") : false;
+  if (associate_)
+    produces<PATFinalStateAssociation>();
+  else
+    produces<PATFinalStateCollection>();
 }
 void PATFinalStateCopier::produce(edm::Event& evt, const edm::EventSetup& es) {
-  std::auto_ptr<PATFinalStateCollection> output(new PATFinalStateCollection);
-
   edm::Handle<edm::View<PATFinalState> > finalStatesH;
   evt.getByLabel(src_, finalStatesH);
 
+  std::vector<const PATFinalStateAssociation*> associations;
+  for (size_t a = 0; a < associations_.size(); ++a) {
+    edm::Handle<PATFinalStateAssociation> associationH;
+    evt.getByLabel(associations_[a], associationH);
+    if (associationH->src() != finalStatesH.id()) {
+      throw cms::Exception("MismatchedAssociation")
+        << "PATFinalStateCopier: the association " << associations_[a]
+        << " is not associated to the final states " << src_ << std::endl;
+    }
+    associations.push_back(associationH.product());
+  }
+
+  if (associate_) {
+    std::auto_ptr<PATFinalStateAssociation> output(
+        new PATFinalStateAssociation(finalStatesH.id(), finalStatesH->size()));
+    for (size_t a = 0; a < associations.size(); ++a) {
+      output->merge(*associations[a]);
+    }
+    evt.put(output);
+    return;
+  }
+
+  std::auto_ptr<PATFinalStateCollection> output(new PATFinalStateCollection);
   for (size_t i = 0; i < finalStatesH->size(); ++i) {
     PATFinalState* embedInto = finalStatesH->ptrAt(i)->clone();
+    for (size_t a = 0; a < associations.size(); ++a) {
+      associations[a]->embedInto(i, *embedInto);
+    }
     output->push_back(embedInto); // takes ownership
   }
   evt.put(output);
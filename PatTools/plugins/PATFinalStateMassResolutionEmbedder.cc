@@ -16,6 +16,7 @@
 #include <string>
 #include "FinalStateAnalysis/DataFormats/interface/PATFinalState.h"
 #include "FinalStateAnalysis/DataFormats/interface/PATFinalStateFwd.h"
+#include "FinalStateAnalysis/DataFormats/interface/PATFinalStateAssociation.h"
 #include "DataFormats/Candidate/interface/Candidate.h"
 #include "FinalStateAnalysis/PatTools/interface/FinalStateMassResolution.h"
 
@@ -27,6 +28,7 @@ public:
 private:
   const bool debug_;
   edm::InputTag src_;    
+  bool associate_;
   FinalStateMassResolution* resoCalc_;  
   
 };
@@ -34,28 +36,39 @@ private:
 PATFinalStateMassResolutionEmbedder::
 PATFinalStateMassResolutionEmbedder(const edm::ParameterSet& pset):
   debug_(pset.getParameter<bool>("debug")),
-  src_(pset.getParameter<edm::InputTag>("src"))
+  src_(pset.getParameter<edm::InputTag>("src")),
+  associate_(pset.exists("associate") ?
+      pset.getParameter<bool>("associate") : false)
 {  
   resoCalc_ = new FinalStateMassResolution();    
-  produces<PATFinalStateCollection>();
+  if (associate_)
+    produces<PATFinalStateAssociation>();
+  else
+    produces<PATFinalStateCollection>();
 }
 void 
 PATFinalStateMassResolutionEmbedder::
 produce(edm::Event& evt, const edm::EventSetup& es) {
-  std::auto_ptr<PATFinalStateCollection> output(new PATFinalStateCollection);
-
   resoCalc_->init(es);
 
   edm::Handle<edm::View<PATFinalState> > finalStatesH;
   evt.getByLabel(src_, finalStatesH);
+
+  std::auto_ptr<PATFinalStateCollection> output;
+  std::auto_ptr<PATFinalStateAssociation> association;
+  if (associate_)
+    association.reset(new PATFinalStateAssociation(
+          finalStatesH.id(), finalStatesH->size()));
+  else
+    output.reset(new PATFinalStateCollection);
   
   for (size_t i = 0; i < finalStatesH->size(); ++i) {
-    PATFinalState* embedInto = finalStatesH->ptrAt(i)->clone();    
+    const PATFinalState& finalState = finalStatesH->at(i);
     std::vector<double> components;
     double dM = 0;
     
     try {
-      dM = resoCalc_->getMassResolutionWithComponents(*embedInto,
+      dM = resoCalc_->getMassResolutionWithComponents(finalState,
 						      components);
     } catch (std::bad_cast& e) {
       dM = -1;
@@ -71,13 +84,22 @@ produce(edm::Event& evt, const edm::EventSetup& es) {
       std::cout << std::endl;
     }
 
-    embedInto->addUserFloat("cand_dM", dM);
-    for( size_t k = 0; k < components.size(); ++k )
-      embedInto->addUserFloat(Form("cand_dM_%lu",k), components[k]);
-    
-    output->push_back(embedInto); // takes ownership
+    if (associate_) {
+      association->addUserFloat(i, "cand_dM", dM);
+      for( size_t k = 0; k < components.size(); ++k )
+        association->addUserFloat(i, Form("cand_dM_%lu",k), components[k]);
+    } else {
+      PATFinalState* embedInto = finalState.clone();
+      embedInto->addUserFloat("cand_dM", dM);
+      for( size_t k = 0; k < components.size(); ++k )
+        embedInto->addUserFloat(Form("cand_dM_%lu",k), components[k]);
+      output->push_back(embedInto); // takes ownership
+    }
   }
-  evt.put(output);
+  if (associate_)
+    evt.put(association);
+  else
+    evt.put(output);
 }
 
 #include "FWCore/Framework/interface/MakerMacros.h"
@@ -5,6 +5,15 @@
  * The input collection is filtered w/ an optional string cut, and a minimum
  * deltaR to any candidate.
  *
+ * The string cut is evaluated once per event.  The candidates passing it are
+ * put in an eta-phi index, so the minimum deltaR veto for each final state
+ * only looks at the candidates near its daughters.  The embedded overlaps are
+ * identical (and in the same order) as a full loop over the collection.
+ *
+ * If [associate] is true, the overlaps are stored in a
+ * PATFinalStateAssociation to the input final states, instead of a copy of
+ * the final state collection.
+ *
  * Author: Evan K. Friis, UW Madison
  *
  */
@@ -18,11 +27,17 @@
 #include <string>
 #include "FinalStateAnalysis/DataFormats/interface/PATFinalState.h"
 #include "FinalStateAnalysis/DataFormats/interface/PATFinalStateFwd.h"
+#include "FinalStateAnalysis/DataFormats/interface/PATFinalStateAssociation.h"
 #include "DataFormats/Candidate/interface/Candidate.h"
 #include "CommonTools/Utils/interface/StringCutObjectSelector.h"
 
+#include "FinalStateAnalysis/DataAlgos/interface/EtaPhiIndex.h"
 #include "DataFormats/Math/interface/deltaR.h"
 
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
 class PATFinalStateOverlapEmbedder : public edm::EDProducer {
   public:
     PATFinalStateOverlapEmbedder(const edm::ParameterSet& pset);
@@ -35,7 +50,14 @@ class PATFinalStateOverlapEmbedder : public edm::EDProducer {
     StringCutObjectSelector<reco::Candidate> cut_;
     double minDeltaR_;
     double maxDeltaR_;
-
+    bool associate_;
+    // Per-event working space, kept to reuse the allocations
+    EtaPhiIndex index_;
+    std::vector<size_t> passing_;
+    std::vector<double> absEtas_;
+    std::vector<char> vetoed_;
+    std::vector<size_t> near_;
+    std::vector<size_t> touched_;
 };
 
 PATFinalStateOverlapEmbedder::PATFinalStateOverlapEmbedder(
@@ -46,40 +68,106 @@ PATFinalStateOverlapEmbedder::PATFinalStateOverlapEmbedder(
   name_ = pset.getParameter<std::string>("name");
   minDeltaR_ = pset.getParameter<double>("minDeltaR");
   maxDeltaR_ = pset.getParameter<double>("maxDeltaR");
-  produces<PATFinalStateCollection>();
+  associate_ = pset.exists("associate") ?
+    pset.getParameter<bool>("associate") : false;
+  if (associate_)
+    produces<PATFinalStateAssociation>();
+  else
+    produces<PATFinalStateCollection>();
 }
 void PATFinalStateOverlapEmbedder::produce(edm::Event& evt, const edm::EventSetup& es) {
-  std::auto_ptr<PATFinalStateCollection> output(new PATFinalStateCollection);
-
   edm::Handle<edm::View<PATFinalState> > finalStatesH;
   evt.getByLabel(src_, finalStatesH);
 
+  std::auto_ptr<PATFinalStateCollection> output;
+  std::auto_ptr<PATFinalStateAssociation> association;
+  if (associate_)
+    association.reset(new PATFinalStateAssociation(
+          finalStatesH.id(), finalStatesH->size()));
+  else
+    output.reset(new PATFinalStateCollection);
+
   edm::Handle<edm::View<reco::Candidate> > toEmbedH;
   evt.getByLabel(toEmbedSrc_, toEmbedH);
 
+  // Apply the cut once, and index the survivors
+  index_.clear();
+  passing_.clear();
+  absEtas_.assign(toEmbedH->size(), 0.);
+  vetoed_.assign(toEmbedH->size(), 0);
+  for (size_t j = 0; j < toEmbedH->size(); ++j) {
+    const reco::Candidate& toTest = toEmbedH->at(j);
+    if (!cut_(toTest))
+      continue;
+    passing_.push_back(j);
+    absEtas_[j] = std::abs(toTest.p4().eta());
+    index_.insert(toTest.p4().eta(), toTest.p4().phi(), j);
+  }
+
   for (size_t i = 0; i < finalStatesH->size(); ++i) {
-    PATFinalState* embedInto = finalStatesH->ptrAt(i)->clone();
+    const PATFinalState& finalState = finalStatesH->at(i);
+
+    // Veto the candidates too close to any daughter.  Only the candidates in
+    // the cells around each daughter can be within minDeltaR.
+    touched_.clear();
+    double maxDauAbsEta = 0;
+    for (size_t d = 0; d < finalState.numberOfDaughters(); ++d) {
+      const reco::Candidate* dau = finalState.daughter(d);
+      maxDauAbsEta = std::max(maxDauAbsEta, std::abs(dau->p4().eta()));
+      // NaN/inf eta: always do the explicit maxDeltaR check
+      if (!(std::abs(dau->p4().eta()) < 1e100))
+        maxDauAbsEta = std::numeric_limits<double>::infinity();
+      index_.neighbours(dau->p4().eta(), dau->p4().phi(), minDeltaR_, near_);
+      for (size_t n = 0; n < near_.size(); ++n) {
+        size_t j = near_[n];
+        if (vetoed_[j])
+          continue;
+        if (reco::deltaR(dau->p4(), toEmbedH->at(j).p4()) < minDeltaR_) {
+          vetoed_[j] = 1;
+          touched_.push_back(j);
+        }
+      }
+    }
+
     reco::CandidatePtrVector overlaps;
-    for (size_t j = 0; j < toEmbedH->size(); ++j) {
-      const reco::CandidatePtr toTest = toEmbedH->ptrAt(j);
-      if (!cut_(*toTest))
+    for (size_t p = 0; p < passing_.size(); ++p) {
+      size_t j = passing_[p];
+      if (vetoed_[j])
         continue;
+      // The deltaR can't be larger than this for any daughter.  The usual
+      // configuration (maxDeltaR = 1e9) never needs the explicit check.
+      double dEta = absEtas_[j] + maxDauAbsEta;
+      bool checkMax = !(std::sqrt(dEta*dEta + M_PI*M_PI) < 0.999*maxDeltaR_);
       bool passes = true;
-      for (size_t i = 0; i < embedInto->numberOfDaughters(); ++i) {
-        const reco::Candidate* dau = embedInto->daughter(i);
-        double deltaR = reco::deltaR(dau->p4(), toTest->p4());
-        if (deltaR < minDeltaR_ || deltaR > maxDeltaR_) {
-          passes = false;
-          break;
+      if (checkMax) {
+        const reco::Candidate& toTest = toEmbedH->at(j);
+        for (size_t d = 0; d < finalState.numberOfDaughters(); ++d) {
+          const reco::Candidate* dau = finalState.daughter(d);
+          if (reco::deltaR(dau->p4(), toTest.p4()) > maxDeltaR_) {
+            passes = false;
+            break;
+          }
         }
       }
       if (passes)
-        overlaps.push_back(toTest);
+        overlaps.push_back(toEmbedH->ptrAt(j));
+    }
+    for (size_t t = 0; t < touched_.size(); ++t) {
+      vetoed_[touched_[t]] = 0;
+    }
+
+    if (associate_) {
+      association->setOverlaps(i, name_, overlaps);
+    } else {
+      PATFinalState* embedInto = finalState.clone();
+      embedInto->setOverlaps(name_, overlaps);
+      output->push_back(embedInto); // takes ownership
     }
-    embedInto->setOverlaps(name_, overlaps);
-    output->push_back(embedInto); // takes ownership
   }
-  evt.put(output);
+  if (associate_)
+    evt.put(association);
+  else
+    evt.put(output);
 }
 
 #include "FWCore/Framework/interface/MakerMacros.h"
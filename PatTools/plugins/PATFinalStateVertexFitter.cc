@@ -6,9 +6,10 @@
 
 #include "FinalStateAnalysis/DataFormats/interface/PATFinalState.h"
 #include "FinalStateAnalysis/DataFormats/interface/PATFinalStateFwd.h"
-#include "DataFormats/PatCandidates/interface/Electron.h"
-#include "DataFormats/PatCandidates/interface/Muon.h"
-#include "DataFormats/PatCandidates/interface/Tau.h"
+#include "FinalStateAnalysis/DataFormats/interface/PATFinalStateAssociation.h"
+
+#include "FinalStateAnalysis/PatTools/interface/TransientTrackCache.h"
+#include "FinalStateAnalysis/PatTools/interface/VertexFitLegs.h"
 
 #include "TrackingTools/TransientTrack/interface/TransientTrackBuilder.h"
 #include "RecoVertex/KalmanVertexFit/interface/KalmanVertexFitter.h"
@@ -17,28 +18,22 @@
 #include "TrackingTools/Records/interface/TransientTrackRecord.h"
 
 
+/*
+ * Within an event, the TransientTrack for each lepton track is only built
+ * once, and the vertex fit for a given set of legs is only done once.
+ * The fits are done with the tracks in a fixed (sorted) order, so the result
+ * doesn't depend on which final state asked for it first.  See
+ * VertexFitLegs.h for how the legs are identified.
+ */
+
+#include <map>
+
 namespace {
-  reco::TransientTrack getTracks(
-      const reco::Candidate* cand, const TransientTrackBuilder* builder) {
-    const pat::Muon* muon = dynamic_cast<const pat::Muon*>(cand);
-    const pat::Electron* electron = dynamic_cast<const pat::Electron*>(cand);
-    const pat::Tau* tau = dynamic_cast<const pat::Tau*>(cand);
-    if (muon) {
-      if (muon->innerTrack().isNonnull())
-        return (builder->build(muon->innerTrack()));
-    } else if (electron) {
-      if (electron->gsfTrack().isNonnull())
-        return (builder->build(electron->gsfTrack()));
-    } else if (tau && tau->signalPFChargedHadrCands().size()) {
-      if (tau->signalPFChargedHadrCands()[0]->trackRef().isNonnull())
-        return (builder->build(
-              tau->signalPFChargedHadrCands()[0]->trackRef()));
-      else
-        if (tau->signalPFChargedHadrCands()[0]->gsfTrackRef().isNonnull())
-          return (builder->build(
-                tau->signalPFChargedHadrCands()[0]->gsfTrackRef()));
-    }
-    return reco::TransientTrack();
+  const reco::TransientTrack& buildTrack(
+      const VertexFitLeg& leg, TransientTrackCache& cache) {
+    if (leg.track.isNonnull())
+      return cache.get(leg.track);
+    return cache.get(leg.gsfTrack);
   }
 }
 
@@ -50,50 +45,99 @@ class PATFinalStateVertexFitter : public edm::EDProducer {
   private:
     edm::InputTag src_;
     bool enable_;
+    // Store the fit results in a PATFinalStateAssociation, instead of copying
+    // the final states.
+    bool associate_;
+
+    // Per-event caches
+    typedef std::map<std::vector<reco::CandidatePtr>,
+            std::pair<double, double> > FitCache;
+    TransientTrackCache trackCache_;
+    FitCache fitCache_;
 };
 
 PATFinalStateVertexFitter::PATFinalStateVertexFitter(const edm::ParameterSet& pset) {
   src_ = pset.getParameter<edm::InputTag>("src");
   enable_ = pset.getParameter<bool>("enable");
-  produces<PATFinalStateCollection>();
+  associate_ = pset.exists("associate") ?
+    pset.getParameter<bool>("associate") : false;
+  if (associate_)
+    produces<PATFinalStateAssociation>();
+  else
+    produces<PATFinalStateCollection>();
 }
 void PATFinalStateVertexFitter::produce(edm::Event& evt, const edm::EventSetup& es) {
-  std::auto_ptr<PATFinalStateCollection> output(new PATFinalStateCollection);
-
   edm::Handle<edm::View<PATFinalState> > finalStates;
   evt.getByLabel(src_, finalStates);
 
+  std::auto_ptr<PATFinalStateCollection> output;
+  std::auto_ptr<PATFinalStateAssociation> association;
+  if (associate_)
+    association.reset(new PATFinalStateAssociation(
+          finalStates.id(), finalStates->size()));
+  else
+    output.reset(new PATFinalStateCollection);
+
   edm::ESHandle<TransientTrackBuilder> trackBuilderHandle;
   if (enable_) {
     es.get<TransientTrackRecord>().get("TransientTrackBuilder", trackBuilderHandle);
   }
 
+  trackCache_.reset(trackBuilderHandle.isValid() ?
+      trackBuilderHandle.product() : 0);
+  fitCache_.clear();
+
   for (size_t i = 0; i < finalStates->size(); ++i) {
-    PATFinalState * clone = finalStates->at(i).clone();
-    assert(clone);
+    const PATFinalState& finalState = finalStates->at(i);
+    double vtxChi2 = -1;
+    double vtxNDOF = -1;
     if (enable_) {
-      std::vector<reco::TransientTrack> tracks;
-      for (size_t d = 0; d < clone->numberOfDaughters(); ++d) {
-	reco::TransientTrack transtrack = getTracks(clone->daughter(d),
-	      trackBuilderHandle.product());
-	if (transtrack.isValid())
-	  tracks.push_back(transtrack);
-      }
-      double vtxChi2 = -1;
-      double vtxNDOF = -1;
+      std::vector<VertexFitLeg> legs = vertexFitLegs(finalState);
       // Make sure all legs have a track
-      if (tracks.size() >= clone->numberOfDaughters()) {
-	KalmanVertexFitter kvf(true);
-	TransientVertex vtx = kvf.vertex(tracks);
-	vtxChi2 = vtx.totalChiSquared();
-	vtxNDOF = vtx.degreesOfFreedom();
+      if (legs.size() && legs.size() >= finalState.numberOfDaughters()) {
+        std::vector<reco::CandidatePtr> keys;
+        for (size_t l = 0; l < legs.size(); ++l)
+          keys.push_back(legs[l].cand);
+        FitCache::const_iterator fit = fitCache_.find(keys);
+        if (fit == fitCache_.end()) {
+          std::vector<reco::TransientTrack> tracks;
+          for (size_t l = 0; l < legs.size(); ++l) {
+            const reco::TransientTrack& track = buildTrack(legs[l], trackCache_);
+            if (track.isValid())
+              tracks.push_back(track);
+          }
+          std::pair<double, double> result(-1, -1);
+          if (tracks.size() >= finalState.numberOfDaughters()) {
+            KalmanVertexFitter kvf(true);
+            TransientVertex vtx = kvf.vertex(tracks);
+            result.first = vtx.totalChiSquared();
+            result.second = vtx.degreesOfFreedom();
+          }
+          fit = fitCache_.insert(std::make_pair(keys, result)).first;
+        }
+        vtxChi2 = fit->second.first;
+        vtxNDOF = fit->second.second;
+      }
+    }
+    if (associate_) {
+      if (enable_) {
+        association->addUserFloat(i, "vtxChi2", vtxChi2);
+        association->addUserFloat(i, "vtxNDOF", vtxNDOF);
+      }
+    } else {
+      PATFinalState * clone = finalState.clone();
+      assert(clone);
+      if (enable_) {
+        clone->addUserFloat("vtxChi2", vtxChi2);
+        clone->addUserFloat("vtxNDOF", vtxNDOF);
       }
-      clone->addUserFloat("vtxChi2", vtxChi2);
-      clone->addUserFloat("vtxNDOF", vtxNDOF);
+      output->push_back(clone);
     }
-    output->push_back(clone);
   }
-  evt.put(output);
+  if (associate_)
+    evt.put(association);
+  else
+    evt.put(output);
 }
 
 #include "FWCore/Framework/interface/MakerMacros.h"
@@ -0,0 +1,20 @@
+/*
+ * Embed PF Jet IDs (see https://twiki.cern.ch/twiki/bin/view/CMS/JetID)
+ * into pat::Jets
+ *
+ * Author: Evan K. Friis, UW Madison
+ */
+
+#ifndef PATJETIDEMBEDDER_H
+#define PATJETIDEMBEDDER_H
+
+#include "FinalStateAnalysis/PatTools/plugins/PATObjectEmbedFunctor.h"
+#include "DataFormats/PatCandidates/interface/Jet.h"
+
+class PATJetIdEmbedFunctor : public PATObjectEmbedFunctor<pat::Jet> {
+  public:
+    PATJetIdEmbedFunctor(const edm::ParameterSet& pset){}
+    void embed(pat::Jet& jet, size_t index);
+};
+
+#endif
@@ -12,45 +12,16 @@
  * =====================================================================================
  */
 
-#include "FWCore/Framework/interface/Frameworkfwd.h"
-#include "FWCore/Framework/interface/Event.h"
-#include "FWCore/Framework/interface/EventSetup.h"
-#include "FWCore/ParameterSet/interface/ParameterSet.h"
-#include "FWCore/Framework/interface/EDProducer.h"
-
-#include "DataFormats/PatCandidates/interface/Jet.h"
+#include "FinalStateAnalysis/PatTools/plugins/PATJetPUIDEmbedder.h"
 #include "DataFormats/JetReco/interface/PileupJetIdentifier.h"
 
-class PATJetPUIDEmbedder : public edm::EDProducer {
-  public:
-    PATJetPUIDEmbedder(const edm::ParameterSet& pset);
-    virtual ~PATJetPUIDEmbedder(){}
-    void produce(edm::Event& evt, const edm::EventSetup& es);
-  private:
-    typedef std::vector<edm::InputTag> VInputTag;
-    edm::InputTag src_;
-    VInputTag discriminants_;
-    VInputTag ids_;
-
-};
-PATJetPUIDEmbedder::PATJetPUIDEmbedder(const edm::ParameterSet& pset) {
-  src_ = pset.getParameter<edm::InputTag>("src");
+PATJetPUIDEmbedFunctor::PATJetPUIDEmbedFunctor(const edm::ParameterSet& pset) {
   discriminants_ = pset.getParameter<VInputTag>("discriminants");
   ids_ = pset.getParameter<VInputTag>("ids");
-  produces<pat::JetCollection>();
 }
-void PATJetPUIDEmbedder::produce(edm::Event& evt, const edm::EventSetup& es) {
-  std::auto_ptr<pat::JetCollection> output(new pat::JetCollection);
-
-  edm::Handle<edm::View<pat::Jet> > inputs;
-  evt.getByLabel(src_, inputs);
-
-  // Build our output collection
-  output->reserve(inputs->size());
-  for (size_t ijet = 0; ijet < inputs->size(); ++ijet) {
-    output->push_back(inputs->at(ijet));
-  }
 
+void PATJetPUIDEmbedFunctor::beginEvent(const edm::Event& evt,
+    const edm::EventSetup& es, const edm::Handle<edm::View<pat::Jet> >& src) {
   /*  Stuff to embed (from twiki):
       edm::ValueMap<StoredPileupJetIdentifier> "puJetId" "" "PAT"
       edm::ValueMap<float> "puJetMva" "fullDiscriminant" "PAT"
@@ -60,47 +31,42 @@ void PATJetPUIDEmbedder::produce(edm::Event& evt, const edm::EventSetup& es) {
       edm::ValueMap<int> "puJetMva" "cutbased" "PAT"
       edm::ValueMap<int> "puJetMva" "simpleId" "PAT"
    *  */
+  discHandles_.resize(discriminants_.size());
+  for (size_t iMVA = 0; iMVA < discriminants_.size(); ++iMVA) {
+    evt.getByLabel(discriminants_[iMVA], discHandles_[iMVA]);
+  }
+  idHandles_.resize(ids_.size());
+  for (size_t iDisc = 0; iDisc < ids_.size(); ++iDisc) {
+    evt.getByLabel(ids_[iDisc], idHandles_[iDisc]);
+  }
+}
 
+void PATJetPUIDEmbedFunctor::embed(pat::Jet& jet, size_t ijet) {
   // Embed MVA outputs (the ValueMap<float>s)
   for (size_t iMVA = 0; iMVA < discriminants_.size(); ++iMVA) {
-    // Get the discriminator
-    edm::Handle<edm::ValueMap<float> > disc;
-    evt.getByLabel(discriminants_[iMVA], disc);
     const std::string& mvaName = discriminants_.at(iMVA).instance();
-
-    // Embed in each pat jet
-    for (size_t ijet = 0; ijet < inputs->size(); ++ijet) {
-      float mva = (*disc)[inputs->refAt(ijet)->originalObjectRef()];
-      output->at(ijet).addUserFloat(mvaName, mva);
-    }
+    float mva = (*discHandles_[iMVA])[jet.originalObjectRef()];
+    jet.addUserFloat(mvaName, mva);
   }
 
   // Embed IDs - these come in loose, medium and tight
   for (size_t iDisc = 0; iDisc < ids_.size(); ++iDisc) {
-    edm::Handle<edm::ValueMap<int> > id;
-    evt.getByLabel(ids_[iDisc], id);
     const std::string& idName = ids_.at(iDisc).instance();
-
-    // Embed in each pat jet
-    for (size_t ijet = 0; ijet < inputs->size(); ++ijet) {
-      int idflag = (*id)[inputs->refAt(ijet)->originalObjectRef()];
-      bool passesLoose = PileupJetIdentifier::passJetId(
-          idflag, PileupJetIdentifier::kLoose);
-      bool passesMedium = PileupJetIdentifier::passJetId(
-          idflag, PileupJetIdentifier::kMedium);
-      bool passesTight = PileupJetIdentifier::passJetId(
-          idflag, PileupJetIdentifier::kTight);
-      output->at(ijet).addUserInt(idName, idflag);
-      output->at(ijet).addUserInt(idName + "Loose", passesLoose);
-      output->at(ijet).addUserInt(idName + "Medium", passesMedium);
-      output->at(ijet).addUserInt(idName + "Tight", passesTight);
-    }
+    int idflag = (*idHandles_[iDisc])[jet.originalObjectRef()];
+    bool passesLoose = PileupJetIdentifier::passJetId(
+        idflag, PileupJetIdentifier::kLoose);
+    bool passesMedium = PileupJetIdentifier::passJetId(
+        idflag, PileupJetIdentifier::kMedium);
+    bool passesTight = PileupJetIdentifier::passJetId(
+        idflag, PileupJetIdentifier::kTight);
+    jet.addUserInt(idName, idflag);
+    jet.addUserInt(idName + "Loose", passesLoose);
+    jet.addUserInt(idName + "Medium", passesMedium);
+    jet.addUserInt(idName + "Tight", passesTight);
   }
-
-  // Store the jets in the event
-  evt.put(output);
 }
 
+typedef PATObjectEmbedder<pat::Jet, PATJetPUIDEmbedFunctor> PATJetPUIDEmbedder;
+
 #include "FWCore/Framework/interface/MakerMacros.h"
 DEFINE_FWK_MODULE(PATJetPUIDEmbedder);
-
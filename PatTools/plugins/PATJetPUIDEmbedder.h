@@ -0,0 +1,42 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  PATJetPUIDEmbedder.h
+ *
+ *    Description:  Embeds PAT Jet PU ID
+ *                  https://twiki.cern.ch/twiki/bin/view/CMS/PileupJetID
+ *
+ *                  The ID value maps are keyed to the reco jets, and are
+ *                  looked up with the original object ref of each jet, so
+ *                  it doesn't matter which copy of the jets is the src.
+ *
+ *         Author:  Evan Friis, evan.friis@cern.ch
+ *        Company:  UW Madison
+ *
+ * =====================================================================================
+ */
+
+#ifndef PATJETPUIDEMBEDDER_H
+#define PATJETPUIDEMBEDDER_H
+
+#include "FinalStateAnalysis/PatTools/plugins/PATObjectEmbedFunctor.h"
+
+#include "DataFormats/PatCandidates/interface/Jet.h"
+#include "DataFormats/Common/interface/ValueMap.h"
+
+class PATJetPUIDEmbedFunctor : public PATObjectEmbedFunctor<pat::Jet> {
+  public:
+    PATJetPUIDEmbedFunctor(const edm::ParameterSet& pset);
+    void beginEvent(const edm::Event& evt, const edm::EventSetup& es,
+        const edm::Handle<edm::View<pat::Jet> >& src);
+    void embed(pat::Jet& jet, size_t index);
+  private:
+    typedef std::vector<edm::InputTag> VInputTag;
+    VInputTag discriminants_;
+    VInputTag ids_;
+    // Current event
+    std::vector<edm::Handle<edm::ValueMap<float> > > discHandles_;
+    std::vector<edm::Handle<edm::ValueMap<int> > > idHandles_;
+};
+
+#endif
@@ -32,11 +32,19 @@
 #include "DataFormats/JetReco/interface/GenJetCollection.h"
 #include "DataFormats/Math/interface/deltaR.h"
 
+#include "FinalStateAnalysis/DataAlgos/interface/EtaPhiIndex.h"
+
 #include <TMath.h>
 #include <TFile.h>
 #include <TH2.h>
 
+#include <algorithm>
+#include <memory>
+#include <vector>
+
 namespace {
+  // Matches all the jets of an event to the gen-jets, which are fetched and
+  // indexed once per event.
   template <typename T>
   class GenJetMatcherT
   {
@@ -48,26 +56,24 @@ namespace {
      {}
      ~GenJetMatcherT() {}
 
-     const reco::GenJet* operator()(const T& jet, edm::Event* evt = 0) const
+     // Fill [matches] with the closest gen-jet within dRmaxGenJetMatch of each
+     // of the [jets], or NULL
+     void operator()(const std::vector<T>& jets, const edm::Event& evt,
+         std::vector<const reco::GenJet*>& matches)
      {
-       assert(evt);
-
        edm::Handle<reco::GenJetCollection> genJets;
-       evt->getByLabel(srcGenJets_, genJets);
-
-       const reco::GenJet* retVal = 0;
-
-       double dRbestMatch = dRmaxGenJetMatch_;
-       for ( reco::GenJetCollection::const_iterator genJet = genJets->begin();
-	     genJet != genJets->end(); ++genJet ) {
-	 double dR = deltaR(jet.p4(), genJet->p4());
-	 if ( dR < dRbestMatch ) {
-	   retVal = &(*genJet);
-	   dRbestMatch = dR;
-	 }
+       evt.getByLabel(srcGenJets_, genJets);
+       genJetIndex_.fill(*genJets);
+
+       matches.assign(jets.size(), 0);
+       for ( size_t iJet = 0; iJet < jets.size(); ++iJet ) {
+         double eta = jets[iJet].eta();
+         double phi = jets[iJet].phi();
+         // A jet with a NaN direction matches nothing
+         if ( TMath::IsNaN(eta) || TMath::IsNaN(phi) ) continue;
+         int match = genJetIndex_.closest(eta, phi, dRmaxGenJetMatch_);
+         if ( match >= 0 ) matches[iJet] = &(*genJets)[match];
        }
-
-       return retVal;
      }
 
     private:
@@ -76,6 +82,62 @@ namespace {
      edm::InputTag srcGenJets_;
 
      double dRmaxGenJetMatch_;
+
+     EtaPhiIndex genJetIndex_;
+  };
+
+  // Flat copy of the bin contents and errors of a TH2, looked up the same way
+  // as TH2::FindBin(x, y) (including the under/overflow bins).
+  class FlatLUT2D
+  {
+    public:
+
+     explicit FlatLUT2D(const TH2& lut)
+     {
+       copyEdges(*lut.GetXaxis(), xEdges_);
+       copyEdges(*lut.GetYaxis(), yEdges_);
+       nx_ = xEdges_.size() + 1;
+       size_t ny = yEdges_.size() + 1;
+       contents_.resize(nx_*ny);
+       errors_.resize(nx_*ny);
+       for ( size_t iy = 0; iy < ny; ++iy ) {
+         for ( size_t ix = 0; ix < nx_; ++ix ) {
+           int bin = lut.GetBin(ix, iy);
+           contents_[iy*nx_ + ix] = lut.GetBinContent(bin);
+           errors_[iy*nx_ + ix] = lut.GetBinError(bin);
+         }
+       }
+     }
+
+     size_t bin(double x, double y) const
+     {
+       return findBin(yEdges_, y)*nx_ + findBin(xEdges_, x);
+     }
+     double content(size_t bin) const { return contents_[bin]; }
+     double error(size_t bin) const { return errors_[bin]; }
+
+    private:
+
+     static void copyEdges(const TAxis& axis, std::vector<double>& edges)
+     {
+       for ( int i = 1; i <= axis.GetNbins() + 1; ++i ) {
+         edges.push_back(axis.GetBinLowEdge(i));
+       }
+     }
+
+     // 0 is the underflow, edges.size() the overflow.  Like TAxis::FindBin,
+     // NaN goes to the overflow.
+     static size_t findBin(const std::vector<double>& edges, double x)
+     {
+       if ( TMath::IsNaN(x) ) return edges.size();
+       return std::upper_bound(edges.begin(), edges.end(), x) - edges.begin();
+     }
+
+     std::vector<double> xEdges_;
+     std::vector<double> yEdges_;
+     size_t nx_;
+     std::vector<double> contents_;
+     std::vector<double> errors_;
   };
 }
 
@@ -103,10 +165,11 @@ class PATJetSmearEmbedder : public edm::EDProducer
         << " Failed to find File = " << inputFileName << " !!\n";
 
     inputFile_ = new TFile(inputFileName.fullPath().data());
-    lut_ = dynamic_cast<TH2*>(inputFile_->Get(lutName.data()));
-    if ( !lut_ )
+    TH2* lut = dynamic_cast<TH2*>(inputFile_->Get(lutName.data()));
+    if ( !lut )
       throw cms::Exception("SmearedJetProducer")
         << " Failed to load LUT = " << lutName.data() << " from file = " << inputFileName.fullPath().data() << " !!\n";
+    lut_.reset(new FlatLUT2D(*lut));
 
     smearBy_ = ( cfg.exists("smearBy") ) ? cfg.getParameter<double>("smearBy") : 1.0;
 
@@ -137,6 +200,11 @@ class PATJetSmearEmbedder : public edm::EDProducer
     edm::Handle<JetCollection> jets;
     evt.getByLabel(src_, jets);
 
+    // Only smear MC
+    genJetMatches_.assign(jets->size(), 0);
+    if (!evt.isRealData())
+      genJetMatcher_(*jets, evt, genJetMatches_);
+
     for (JetCollection::const_iterator jet = jets->begin();
 	  jet != jets->end(); ++jet ) {
       reco::Candidate::LorentzVector jetP4 = jet->p4();
@@ -151,31 +219,28 @@ class PATJetSmearEmbedder : public edm::EDProducer
       ShiftedCand smearUpCand(outputJet);
       ShiftedCand smearDownCand(outputJet);
 
-      // Only smear MC
-      if (!evt.isRealData()) {
-        const reco::GenJet* genJet = genJetMatcher_(*jet, &evt);
-        if ( genJet ) {
-          int binIndex = lut_->FindBin(TMath::Abs(jetP4.eta()), jetP4.pt());
-          double smearFactor = lut_->GetBinContent(binIndex);
-          double smearFactorErr = lut_->GetBinError(binIndex);
+      const reco::GenJet* genJet = genJetMatches_[jet - jets->begin()];
+      if ( genJet ) {
+        size_t binIndex = lut_->bin(TMath::Abs(jetP4.eta()), jetP4.pt());
+        double smearFactor = lut_->content(binIndex);
+        double smearFactorErr = lut_->error(binIndex);
 
-          smearFactor = TMath::Power(smearFactor, smearBy_);
+        smearFactor = TMath::Power(smearFactor, smearBy_);
 
-          smearedP4 = jet->p4() - genJet->p4();
-          smearedP4 *= smearFactor;
-          smearedP4 += genJet->p4();
+        smearedP4 = jet->p4() - genJet->p4();
+        smearedP4 *= smearFactor;
+        smearedP4 += genJet->p4();
 
-          double smearFactorUp = smearFactor + 3*smearFactorErr;
-          smearUpP4 = jet->p4() - genJet->p4();
-          smearUpP4 *= smearFactorUp;
-          smearUpP4 += genJet->p4();
+        double smearFactorUp = smearFactor + 3*smearFactorErr;
+        smearUpP4 = jet->p4() - genJet->p4();
+        smearUpP4 *= smearFactorUp;
+        smearUpP4 += genJet->p4();
 
-          double smearFactorDown = smearFactor - 3*smearFactorErr;
-          smearDownP4 = jet->p4() - genJet->p4();
-          smearDownP4 *= smearFactorDown;
-          smearDownP4 += genJet->p4();
+        double smearFactorDown = smearFactor - 3*smearFactorErr;
+        smearDownP4 = jet->p4() - genJet->p4();
+        smearDownP4 *= smearFactorDown;
+        smearDownP4 += genJet->p4();
 
-        }
       }
       outputJets->push_back(outputJet);
 
@@ -213,7 +278,9 @@ class PATJetSmearEmbedder : public edm::EDProducer
   edm::InputTag src_;
 
   TFile* inputFile_;
-  TH2* lut_;
+  std::auto_ptr<FlatLUT2D> lut_;
+
+  std::vector<const reco::GenJet*> genJetMatches_;
 
   double smearBy_; // option to "smear" jet energy by N standard-deviations, useful for template morphing
 
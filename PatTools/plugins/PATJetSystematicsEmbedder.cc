@@ -9,6 +9,8 @@
 #include "DataFormats/PatCandidates/interface/Jet.h"
 #include "DataFormats/Candidate/interface/LeafCandidate.h"
 
+#include "FinalStateAnalysis/DataFormats/interface/PATObjectShifts.h"
+
 #include "JetMETCorrections/Objects/interface/JetCorrector.h"
 #include "JetMETCorrections/Objects/interface/JetCorrectionsRecord.h"
 #include "CondFormats/JetMETObjects/interface/JetCorrectorParameters.h"
@@ -28,17 +30,24 @@ class PATJetSystematicsEmbedder : public edm::EDProducer {
     edm::InputTag src_;
     std::string label_;
     double unclusteredEnergyScale_;
+    // Store the shifts in a single PATObjectShifts
+    bool compact_;
 };
 
 PATJetSystematicsEmbedder::PATJetSystematicsEmbedder(const edm::ParameterSet& pset) {
   src_ = pset.getParameter<edm::InputTag>("src");
   label_ = pset.getParameter<std::string>("corrLabel");
   unclusteredEnergyScale_ = pset.getParameter<double>("unclusteredEnergyScale");
+  compact_ = pset.exists("compact") ? pset.getParameter<bool>("compact") : false;
   produces<pat::JetCollection>();
-  produces<ShiftedCandCollection>("p4OutJESUpJets");
-  produces<ShiftedCandCollection>("p4OutJESDownJets");
-  produces<ShiftedCandCollection>("p4OutUESUpJets");
-  produces<ShiftedCandCollection>("p4OutUESDownJets");
+  if (compact_) {
+    produces<PATObjectShifts>("shifts");
+  } else {
+    produces<ShiftedCandCollection>("p4OutJESUpJets");
+    produces<ShiftedCandCollection>("p4OutJESDownJets");
+    produces<ShiftedCandCollection>("p4OutUESUpJets");
+    produces<ShiftedCandCollection>("p4OutUESDownJets");
+  }
 }
 void PATJetSystematicsEmbedder::produce(edm::Event& evt, const edm::EventSetup& es) {
   std::auto_ptr<pat::JetCollection> output(new pat::JetCollection);
@@ -52,10 +61,20 @@ void PATJetSystematicsEmbedder::produce(edm::Event& evt, const edm::EventSetup&
   std::auto_ptr<ShiftedCandCollection> p4OutUESUpJets(new ShiftedCandCollection);
   std::auto_ptr<ShiftedCandCollection> p4OutUESDownJets(new ShiftedCandCollection);
 
-  p4OutJESUpJets->reserve(nJets);
-  p4OutJESDownJets->reserve(nJets);
-  p4OutUESUpJets->reserve(nJets);
-  p4OutUESDownJets->reserve(nJets);
+  std::auto_ptr<PATObjectShifts> shifts;
+  if (compact_) {
+    std::vector<std::string> names;
+    names.push_back("jes+");
+    names.push_back("jes-");
+    names.push_back("ues+");
+    names.push_back("ues-");
+    shifts.reset(new PATObjectShifts(names, nJets));
+  } else {
+    p4OutJESUpJets->reserve(nJets);
+    p4OutJESDownJets->reserve(nJets);
+    p4OutUESUpJets->reserve(nJets);
+    p4OutUESDownJets->reserve(nJets);
+  }
 
   edm::ESHandle<JetCorrectorParametersCollection> JetCorParColl;
   es.get<JetCorrectionsRecord>().get(label_, JetCorParColl);
@@ -82,6 +101,14 @@ void PATJetSystematicsEmbedder::produce(edm::Event& evt, const edm::EventSetup&
     LorentzVector uncUESDown = (1-unclusteredEnergyScale_)*jet.p4();
     LorentzVector uncUESUp = (1+unclusteredEnergyScale_)*jet.p4();
 
+    if (compact_) {
+      shifts->setP4(i, 0, uncUp);
+      shifts->setP4(i, 1, uncDown);
+      shifts->setP4(i, 2, uncUESUp);
+      shifts->setP4(i, 3, uncUESDown);
+      continue;
+    }
+
     ShiftedCand candUncDown(jet);
     candUncDown.setP4(uncDown);
     ShiftedCand candUncUp(jet);
@@ -98,6 +125,14 @@ void PATJetSystematicsEmbedder::produce(edm::Event& evt, const edm::EventSetup&
     p4OutUESDownJets->push_back(candUncUESDown);
   }
 
+  if (compact_) {
+    edm::RefProd<PATObjectShifts> shiftsRef(evt.put(shifts, "shifts"));
+    for (size_t i = 0; i < output->size(); ++i)
+      PATObjectShifts::link(output->at(i), shiftsRef, i);
+    evt.put(output);
+    return;
+  }
+
   typedef edm::OrphanHandle<ShiftedCandCollection> PutHandle;
   PutHandle p4OutJESUpJetsH = evt.put(p4OutJESUpJets, "p4OutJESUpJets");
   PutHandle p4OutJESDownJetsH = evt.put(p4OutJESDownJets, "p4OutJESDownJets");
@@ -0,0 +1,114 @@
+/** \class PATLeptonIpEmbedFunctor
+ *
+ * Embed the track IP w.r.t an input PV as a user float in a pat collection
+ * Also embeds the 3D & 2D IP and significance
+ *
+ * \author Konstantinos A. Petridis, Imperial College;
+ *  modified by Christian Veelken
+ *  modified by Evan Friis
+ *
+ */
+
+#ifndef PATLEPTONIPEMBEDDER_H
+#define PATLEPTONIPEMBEDDER_H
+
+#include "FinalStateAnalysis/PatTools/plugins/PATObjectEmbedFunctor.h"
+
+#include "FinalStateAnalysis/PatTools/interface/PATLeptonTrackVectorExtractor.h"
+#include "DataFormats/VertexReco/interface/Vertex.h"
+#include "DataFormats/VertexReco/interface/VertexFwd.h"
+
+#include "TrackingTools/TransientTrack/interface/TransientTrack.h"
+#include "TrackingTools/TransientTrack/interface/TransientTrackBuilder.h"
+#include "TrackingTools/Records/interface/TransientTrackRecord.h"
+#include "TrackingTools/IPTools/interface/IPTools.h"
+#include "TrackingTools/GeomPropagators/interface/AnalyticalImpactPointExtrapolator.h"
+#include "TrackingTools/GeomPropagators/interface/TransverseImpactPointExtrapolator.h"
+#include "RecoVertex/VertexPrimitives/interface/ConvertToFromReco.h"
+#include "RecoVertex/VertexTools/interface/VertexDistance3D.h"
+#include "RecoVertex/VertexTools/interface/VertexDistanceXY.h"
+
+#include <vector>
+
+template<typename T>
+class PATLeptonIpEmbedFunctor : public PATObjectEmbedFunctor<T> {
+  public:
+    PATLeptonIpEmbedFunctor(const edm::ParameterSet& pset);
+    void beginEvent(const edm::Event& evt, const edm::EventSetup& es,
+        const edm::Handle<edm::View<T> >& src);
+    void embed(T& object, size_t index);
+  private:
+    edm::InputTag vtxSrc_;
+    ek::PATLeptonTrackVectorExtractor<T> trackExtractor_;
+    // Current event
+    edm::ESHandle<TransientTrackBuilder> ttrackBuilder_;
+    edm::Handle<reco::VertexCollection> vertices_;
+};
+
+template<typename T>
+PATLeptonIpEmbedFunctor<T>::PATLeptonIpEmbedFunctor(const edm::ParameterSet& pset) {
+  vtxSrc_ = pset.getParameter<edm::InputTag>("vtxSrc");
+}
+
+template<typename T>
+void PATLeptonIpEmbedFunctor<T>::beginEvent(const edm::Event& evt,
+    const edm::EventSetup& es, const edm::Handle<edm::View<T> >& src) {
+  es.get<TransientTrackRecord>().get(
+      "TransientTrackBuilder", ttrackBuilder_);
+  evt.getByLabel(vtxSrc_, vertices_);
+}
+
+template<typename T>
+void PATLeptonIpEmbedFunctor<T>::embed(T& object, size_t index) {
+  const reco::Vertex& thePV = *vertices_->begin();
+
+  typedef std::pair<bool,Measurement1D> IPResult;
+
+  std::vector<const reco::Track*> tracks = trackExtractor_(object);
+  const reco::Track* track = tracks.size() ? tracks.at(0) : NULL;
+  double ip = -1;
+  double dz = -1;
+  double vz = -999;
+  double ip3D = -1;
+  double ip3DS = -1;
+  double tip = -1;
+  double tipS = -1;
+
+  if (track) {
+    reco::TransientTrack ttrack = ttrackBuilder_->build(track);
+    // Linearized functions
+    ip = track->dxy(thePV.position());
+    dz = track->dz(thePV.position());
+    vz = track->vz();
+    // Same as IPTools::absoluteImpactParameter3D and
+    // absoluteTransverseImpactParameter, but the impact point state and the
+    // PV position are only computed once for both.
+    const TrajectoryStateOnSurface ipState = ttrack.impactPointState();
+    const GlobalPoint pvPos = RecoVertex::convertPos(thePV.position());
+    VertexDistance3D dist3D;
+    IPResult ip3DRes = IPTools::absoluteImpactParameter(
+        AnalyticalImpactPointExtrapolator(ttrack.field()).extrapolate(
+          ipState, pvPos), thePV, dist3D);
+    if (ip3DRes.first) {
+      ip3D = ip3DRes.second.value();
+      ip3DS = ip3DRes.second.significance();
+    }
+    VertexDistanceXY distXY;
+    IPResult tipRes = IPTools::absoluteImpactParameter(
+        TransverseImpactPointExtrapolator(ttrack.field()).extrapolate(
+          ipState, pvPos), thePV, distXY);
+    if (tipRes.first) {
+      tip = tipRes.second.value();
+      tipS = tipRes.second.significance();
+    }
+  }
+  object.addUserFloat("ipDXY", ip);
+  object.addUserFloat("dz", dz);
+  object.addUserFloat("vz", vz);
+  object.addUserFloat("ip3D", ip3D);
+  object.addUserFloat("ip3DS", ip3DS);
+  object.addUserFloat("tip", tip);
+  object.addUserFloat("tipS", tipS);
+}
+
+#endif
@@ -3,6 +3,7 @@
 #include "FWCore/Framework/interface/EventSetup.h"
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 #include "FWCore/Framework/interface/EDProducer.h"
+#include "FWCore/Utilities/interface/Exception.h"
 
 #include "DataFormats/PatCandidates/interface/Electron.h"
 #include "DataFormats/PatCandidates/interface/Muon.h"
@@ -14,6 +15,9 @@
 
 #include "CommonTools/Utils/interface/StringCutObjectSelector.h"
 
+#include "FinalStateAnalysis/DataFormats/interface/PATObjectShifts.h"
+#include "FinalStateAnalysis/DataFormats/interface/PATMETShifts.h"
+
 class PATMETSystematicsEmbedder : public edm::EDProducer {
   public:
     typedef reco::LeafCandidate ShiftedCand;
@@ -29,6 +33,10 @@ class PATMETSystematicsEmbedder : public edm::EDProducer {
     edm::InputTag electronSrc_;
     edm::InputTag metSrc_;
 
+    // Embed the shifts in the output MET as a PATObjectShifts (see
+    // PATMETShifts.h) instead of making a collection for each shift.
+    bool compact_;
+
     bool applyType1ForTaus_;
     bool applyType1ForMuons_;
     bool applyType1ForElectrons_;
@@ -59,6 +67,10 @@ PATMETSystematicsEmbedder::PATMETSystematicsEmbedder(
     electronSrc_ = pset.getParameter<edm::InputTag>("electronSrc");
     metSrc_ = pset.getParameter<edm::InputTag>("src");
 
+    compact_ = pset.exists("compact") ? pset.getParameter<bool>("compact") : false;
+    if (compact_)
+      return;
+
     produces<ShiftedCandCollection>("metsRaw");
     produces<ShiftedCandCollection>("metType1");
     produces<ShiftedCandCollection>("metsMESUp");
@@ -81,9 +93,31 @@ transverse(const reco::Candidate::LorentzVector& input) {
   return outputT;
 }
 
-void embedShift(pat::MET& met, edm::Event& evt,
+// Get the [name] shifted p4 of [object], stored either as a userCand or in
+// the compact PATObjectShifts
+template<typename T>
+reco::Candidate::LorentzVector
+shiftedP4(const T& object, const std::string& name) {
+  reco::Candidate::LorentzVector output;
+  if (!PATObjectShifts::shiftedP4(object, name, output)) {
+    throw cms::Exception("MissingShift")
+      << "PATMETSystematicsEmbedder: object has no " << name
+      << " shift" << std::endl;
+  }
+  return output;
+}
+
+// Embed [met] + [residual] as the [embedName] variation of [met].  If
+// [compact] is given, it is stored there, otherwise in the new collection
+// [branchName].
+void embedShift(pat::MET& met, edm::Event& evt, PATObjectShifts* compact,
     const std::string& branchName, const std::string& embedName,
     const reco::Candidate::LorentzVector& residual) {
+  if (compact) {
+    compact->setP4(0, metshifts::index(embedName),
+        transverse(met.p4() + residual));
+    return;
+  }
 
   typedef reco::LeafCandidate ShiftedCand;
   typedef std::vector<ShiftedCand> ShiftedCandCollection;
@@ -119,8 +153,12 @@ void PATMETSystematicsEmbedder::produce(edm::Event& evt, const edm::EventSetup&
   const pat::MET& inputMET = mets->at(0);
   pat::MET outputMET = inputMET;
 
+  std::auto_ptr<PATObjectShifts> compact;
+  if (compact_)
+    compact.reset(new PATObjectShifts(metshifts::names(), 1));
+
   // Raw MET
-  embedShift(outputMET, evt, "metsRaw", "raw", LorentzVector());
+  embedShift(outputMET, evt, compact.get(), "metsRaw", "raw", LorentzVector());
 
   // Keep track of the type 1 correction
   LorentzVector type1Correction;
@@ -136,13 +174,10 @@ void PATMETSystematicsEmbedder::produce(edm::Event& evt, const edm::EventSetup&
   /*
   for (size_t i = 0; i < muons->size(); ++i) {
     const pat::Muon& muon = muons->at(i);
-    assert(muon.userCand("uncorr").isNonnull());
-    assert(muon.userCand("mes+").isNonnull());
-    assert(muon.userCand("mes-").isNonnull());
-    uncorrMuonP4 += muon.userCand("uncorr")->p4();
+    uncorrMuonP4 += shiftedP4(muon, "uncorr");
     nominalMuonP4 += muon.p4();
-    mesUpMuonP4 += muon.userCand("mes+")->p4();
-    mesDownMuonP4 += muon.userCand("mes-")->p4();
+    mesUpMuonP4 += shiftedP4(muon, "mes+");
+    mesDownMuonP4 += shiftedP4(muon, "mes-");
   }
   */
 
@@ -154,13 +189,10 @@ void PATMETSystematicsEmbedder::produce(edm::Event& evt, const edm::EventSetup&
 
   for (size_t i = 0; i < electrons->size(); ++i) {
     const pat::Electron& electron = electrons->at(i);
-    assert(electron.userCand("uncorr").isNonnull());
-    assert(electron.userCand("ees+").isNonnull());
-    assert(electron.userCand("ees-").isNonnull());
     nominalElectronP4 += electron.p4();
-    uncorrElectronP4 += electron.userCand("uncorr")->p4();
-    eesUpElectronP4 += electron.userCand("ees+")->p4();
-    eesDownElectronP4 += electron.userCand("ees-")->p4();
+    uncorrElectronP4 += shiftedP4(electron, "uncorr");
+    eesUpElectronP4 += shiftedP4(electron, "ees+");
+    eesDownElectronP4 += shiftedP4(electron, "ees-");
   }
 
   LorentzVector uncorrTauP4;
@@ -190,33 +222,24 @@ void PATMETSystematicsEmbedder::produce(edm::Event& evt, const edm::EventSetup&
     const pat::Jet& jet = *seedJet;
     if (tauCut_(tau)) {
       shiftedTaus++;
-      assert(tau.userCand("uncorr").isNonnull());
-      assert(tau.userCand("tes+").isNonnull());
-      assert(tau.userCand("tes-").isNonnull());
-      uncorrTauP4 += tau.userCand("uncorr")->p4();
+      uncorrTauP4 += shiftedP4(tau, "uncorr");
       nominalTauP4 += tau.p4();
-      tesUpTauP4 += tau.userCand("tes+")->p4();
-      tesDownTauP4 += tau.userCand("tes-")->p4();
+      tesUpTauP4 += shiftedP4(tau, "tes+");
+      tesDownTauP4 += shiftedP4(tau, "tes-");
     }
     if (jetCut_(tau)) {
       shiftedJets++;
-      assert(jet.userCand("uncorr").isNonnull());
-      assert(jet.userCand("jes+").isNonnull());
-      assert(jet.userCand("jes-").isNonnull());
-      uncorrJetP4 += jet.userCand("uncorr")->p4();
+      uncorrJetP4 += shiftedP4(jet, "uncorr");
       nominalJetP4 += jet.p4();
-      jesUpJetP4 += jet.userCand("jes+")->p4();
-      jesDownJetP4 += jet.userCand("jes-")->p4();
+      jesUpJetP4 += shiftedP4(jet, "jes+");
+      jesDownJetP4 += shiftedP4(jet, "jes-");
     }
     if (unclusteredCut_(tau)) {
       shiftedUnclustered++;
-      assert(jet.userCand("uncorr").isNonnull());
-      assert(jet.userCand("ues+").isNonnull());
-      assert(jet.userCand("ues-").isNonnull());
-      uncorrUnclusteredP4 += jet.userCand("uncorr")->p4();
+      uncorrUnclusteredP4 += shiftedP4(jet, "uncorr");
       nominalUnclusteredP4 += jet.p4();
-      uesUpUnclusteredP4 += jet.userCand("ues+")->p4();
-      uesDownUnclusteredP4 += jet.userCand("ues-")->p4();
+      uesUpUnclusteredP4 += shiftedP4(jet, "ues+");
+      uesDownUnclusteredP4 += shiftedP4(jet, "ues-");
     }
   }
 
@@ -262,34 +285,37 @@ void PATMETSystematicsEmbedder::produce(edm::Event& evt, const edm::EventSetup&
   metP4Type1 = transverse(metP4Type1);
 
   // Embed the type one corrected MET
-  embedShift(outputMET, evt, "metType1", "type1",
+  embedShift(outputMET, evt, compact.get(), "metType1", "type1",
       metP4Type1 - outputMET.p4());
 
-  embedShift(outputMET, evt, "metsMESUp", "mes+",
+  embedShift(outputMET, evt, compact.get(), "metsMESUp", "mes+",
       nominalMuonP4 - mesUpMuonP4);
-  embedShift(outputMET, evt, "metsMESDown", "mes-",
+  embedShift(outputMET, evt, compact.get(), "metsMESDown", "mes-",
       nominalMuonP4 - mesDownMuonP4);
 
-  embedShift(outputMET, evt, "metsEESUp", "ees+",
+  embedShift(outputMET, evt, compact.get(), "metsEESUp", "ees+",
       nominalElectronP4 - eesUpElectronP4);
-  embedShift(outputMET, evt, "metsEESDown", "ees-",
+  embedShift(outputMET, evt, compact.get(), "metsEESDown", "ees-",
       nominalElectronP4 - eesDownElectronP4);
 
-  embedShift(outputMET, evt, "metsTESUp", "tes+",
+  embedShift(outputMET, evt, compact.get(), "metsTESUp", "tes+",
       nominalTauP4 - tesUpTauP4);
-  embedShift(outputMET, evt, "metsTESDown", "tes-",
+  embedShift(outputMET, evt, compact.get(), "metsTESDown", "tes-",
       nominalTauP4 - tesDownTauP4);
 
-  embedShift(outputMET, evt, "metsJESUp", "jes+",
+  embedShift(outputMET, evt, compact.get(), "metsJESUp", "jes+",
       nominalJetP4 - jesUpJetP4);
-  embedShift(outputMET, evt, "metsJESDown", "jes-",
+  embedShift(outputMET, evt, compact.get(), "metsJESDown", "jes-",
       nominalJetP4 - jesDownJetP4);
 
-  embedShift(outputMET, evt, "metsUESUp", "ues+",
+  embedShift(outputMET, evt, compact.get(), "metsUESUp", "ues+",
       nominalUnclusteredP4 - uesUpUnclusteredP4);
-  embedShift(outputMET, evt, "metsUESDown", "ues-",
+  embedShift(outputMET, evt, compact.get(), "metsUESDown", "ues-",
       nominalUnclusteredP4 - uesDownUnclusteredP4);
 
+  if (compact_)
+    PATObjectShifts::embed(outputMET, *compact);
+
   std::auto_ptr<pat::METCollection> outputColl(new pat::METCollection);
   outputColl->push_back(outputMET);
 
@@ -0,0 +1,27 @@
+/*
+ * Embed effective area corrections into pat::Muons
+ *
+ * Author: Lindsey A. Gray, UW Madison
+ *
+ */
+
+#ifndef PATMUONEAEMBEDDER_H
+#define PATMUONEAEMBEDDER_H
+
+#include "FinalStateAnalysis/PatTools/plugins/PATObjectEmbedFunctor.h"
+#include "FinalStateAnalysis/PatTools/interface/PATMuonEACalculator.h"
+
+#include "DataFormats/PatCandidates/interface/Muon.h"
+
+class PATMuonEAEmbedFunctor : public PATObjectEmbedFunctor<pat::Muon> {
+public:
+  typedef std::vector<std::string> vstring;
+  PATMuonEAEmbedFunctor(const edm::ParameterSet& pset);
+  void embed(pat::Muon& muon, size_t index);
+private:
+  vstring _eas_to_get;
+  pattools::PATMuonEACalculator _eacalc;
+  std::vector<double> _eas;
+};
+
+#endif
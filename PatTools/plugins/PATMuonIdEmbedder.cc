@@ -5,52 +5,24 @@
  *
  */
 
-#include "FinalStateAnalysis/PatTools/interface/PATMuonIdSelector.h"
-#include <algorithm>
+#include "FinalStateAnalysis/PatTools/plugins/PATMuonIdEmbedder.h"
 
-class PATMuonIdEmbedder : public edm::EDProducer {
-  public:
-    PATMuonIdEmbedder(const edm::ParameterSet& pset);
-    virtual ~PATMuonIdEmbedder(){}
-    void produce(edm::Event& evt, const edm::EventSetup& es);
-  private:
-    edm::InputTag src_;
-    std::string userIntLabel_;
-    PATMuonIdSelectorImp selector_;
-};
-
-PATMuonIdEmbedder::PATMuonIdEmbedder(const edm::ParameterSet& pset)
+PATMuonIdEmbedFunctor::PATMuonIdEmbedFunctor(const edm::ParameterSet& pset)
   :selector_(pset) {
-  src_ = pset.getParameter<edm::InputTag>("src");
   userIntLabel_ = pset.getParameter<std::string>("userIntLabel");
-  produces<pat::MuonCollection>();
 }
 
-void PATMuonIdEmbedder::produce(edm::Event& evt, const edm::EventSetup& es) {
-  std::auto_ptr<pat::MuonCollection> output(new pat::MuonCollection());
-
-  edm::Handle<pat::MuonCollection> handle;
-  evt.getByLabel(src_, handle);
-
-  // apply selection
-  selector_.select(handle, evt, es);
-
-  // Check if our inputs are in our outputs
-  for (size_t iMuon = 0; iMuon < handle->size(); ++iMuon) {
-    const pat::Muon* currentMuon = &(handle->at(iMuon));
-    std::vector<const pat::Muon*>::const_iterator find_result =
-      std::find(selector_.begin(), selector_.end(), currentMuon);
-    bool passedId = false;
-    if (find_result != selector_.end()) {
-      passedId = true;
-    }
-    pat::Muon newMuon = *currentMuon;
-    newMuon.addUserInt(userIntLabel_, passedId);
-    output->push_back(newMuon);
-  }
+void PATMuonIdEmbedFunctor::beginEvent(const edm::Event& evt,
+    const edm::EventSetup& es, const edm::Handle<edm::View<pat::Muon> >& src) {
+  selector_.setReferencePoint(evt);
+}
 
-  evt.put(output);
+void PATMuonIdEmbedFunctor::embed(pat::Muon& muon, size_t index) {
+  bool passedId = selector_.passes(muon);
+  muon.addUserInt(userIntLabel_, passedId);
 }
 
+typedef PATObjectEmbedder<pat::Muon, PATMuonIdEmbedFunctor> PATMuonIdEmbedder;
+
 #include "FWCore/Framework/interface/MakerMacros.h"
 DEFINE_FWK_MODULE(PATMuonIdEmbedder);
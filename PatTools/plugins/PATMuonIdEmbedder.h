@@ -0,0 +1,25 @@
+/*
+ * Embed a WW analysis style muon ID into a pat::Muon userInt.
+ *
+ * Author: Evan K. Friis, UW Madison
+ *
+ */
+
+#ifndef PATMUONIDEMBEDDER_H
+#define PATMUONIDEMBEDDER_H
+
+#include "FinalStateAnalysis/PatTools/plugins/PATObjectEmbedFunctor.h"
+#include "FinalStateAnalysis/PatTools/interface/PATMuonIdSelector.h"
+
+class PATMuonIdEmbedFunctor : public PATObjectEmbedFunctor<pat::Muon> {
+  public:
+    PATMuonIdEmbedFunctor(const edm::ParameterSet& pset);
+    void beginEvent(const edm::Event& evt, const edm::EventSetup& es,
+        const edm::Handle<edm::View<pat::Muon> >& src);
+    void embed(pat::Muon& muon, size_t index);
+  private:
+    std::string userIntLabel_;
+    PATMuonIdSelectorImp selector_;
+};
+
+#endif
@@ -20,14 +20,7 @@
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 #include "DataFormats/PatCandidates/interface/Jet.h"
 
-#include "DataFormats/BTauReco/interface/SecondaryVertexTagInfo.h"
-#include "DataFormats/BTauReco/interface/TrackIPTagInfo.h"
-
-#include "DataFormats/MuonReco/interface/Muon.h"
-#include "DataFormats/PatCandidates/interface/Muon.h"
-#include "DataFormats/ParticleFlowCandidate/interface/PFCandidate.h"
-#include "DataFormats/MuonReco/interface/MuonSelectors.h"
-#include "Math/GenVector/VectorUtil.h"
+#include "FinalStateAnalysis/PatTools/interface/JetConstituentSummary.h"
 
 // Looks for a Muon in the Jet, and saves the highest ptrel one. Future improvement: save all...
 // Electron skeleton added, but useless without ID requirements on it
@@ -60,104 +53,34 @@ class PATMuonInJetEmbedder : public edm::EDProducer {
       edm::Handle<reco::VertexCollection> vertexHandle;
       iEvent.getByLabel(srcVertices_, vertexHandle);
 
-      if(iEvent.getByLabel(src_,cands))
+      if(iEvent.getByLabel(src_,cands)) {
+        out->reserve(cands->size());
         for(unsigned int  i=0;i!=cands->size();++i){
           pat::Jet jet = cands->at(i);
 
-          double MuonInJetPt=-10;
-          double MuonInJetCharge=0;
-          double MuonInJetPhi=-10;
-          double MuonInJetEta=-10;
-          double MuonInJetPtRel=0;
-          double MuonInJetDXY=1000;
-          double MuonInJetDZ=1000;
-          double MuonInJetIsoABS=-10;
-          double MuonInJetDXYERR=1000;
-          double MuonInJetDZERR=1000;
-          double ElectronInJetPt=-10;
-          double ElectronInJetCharge=0;
-          double ElectronInJetPhi=-10;
-          double ElectronInJetEta=-10;
-          double ElectronInJetPtRel=0;
-
-          int nConst=jet.nConstituents();
-
-          for(int i=0; i<nConst; i++){
-            reco::PFCandidatePtr leptoncand=jet.getPFConstituent(i);
-
-            if(abs(leptoncand->pdgId())==13)
-            {
-              reco::MuonRef muref = leptoncand->muonRef();
-              if (!muref->isGlobalMuon()) continue;
-              if (!muref->isTrackerMuon()) continue;
-
-              double dxy = 100; double dz=100;  double dxyError=100; double dzError=100;
-              if(vertexHandle->size()>=1){
-                dxy=muref->innerTrack()->dxy(vertexHandle->at(0).position());
-                dz = muref->innerTrack()->dz(vertexHandle->at(0).position());
-                dxyError= muref->innerTrack()->dxyError();
-                dzError = muref->innerTrack()->dzError();
-
-              }
-              if (fabs(dxy)>0.2) continue;
-              if(fabs(dz)>0.2) continue;
-              double normalizedChi2 = muref->globalTrack()->normalizedChi2();
-              if (normalizedChi2>10.) continue;
-              int trackerHits = muref->globalTrack()->hitPattern().numberOfValidTrackerHits();
-              if (trackerHits<11) continue;
-              int pixelHits = muref->globalTrack()->hitPattern().numberOfValidPixelHits();
-              if (pixelHits<1) continue;
-              int muonHits = muref->globalTrack()->hitPattern().numberOfValidMuonHits();
-              if (muonHits<1) continue;
-
-              int nMatches = muref->numberOfMatches();
-              if (nMatches<2) continue;
-
-              double ptrelcand=sqrt(pow(leptoncand->p(),2) - pow(leptoncand->px()*jet.px()+leptoncand->py()*jet.py()+leptoncand->pz()*jet.pz(),2)/pow(jet.p(),2));
-              if(ptrelcand>MuonInJetPtRel){
-                MuonInJetPt=leptoncand->pt();
-                MuonInJetEta=leptoncand->eta();
-                MuonInJetPhi=leptoncand->phi();
-                MuonInJetCharge=leptoncand->charge();
-                MuonInJetPtRel=ptrelcand*leptoncand->charge();
-                MuonInJetDXY=dxy;
-                MuonInJetDZ=dz;
-                MuonInJetDXYERR= dxyError;
-                MuonInJetDZERR= dzError;
-                MuonInJetIsoABS=(muref->isolationR03().sumPt + muref->isolationR03().emEt + muref->isolationR03().hadEt);
-              }
-            }
-            if(abs(leptoncand->pdgId())==11)
-            {
-              double ptrelcand=sqrt(pow(leptoncand->p(),2) - pow(leptoncand->px()*jet.px()+leptoncand->py()*jet.py()+leptoncand->pz()*jet.pz(),2)/pow(jet.p(),2));
-              if(ptrelcand>ElectronInJetPtRel){
-                ElectronInJetPt=leptoncand->pt();
-                ElectronInJetEta=leptoncand->eta();
-                ElectronInJetPhi=leptoncand->phi();
-                ElectronInJetCharge=leptoncand->charge();
-                ElectronInJetPtRel=ptrelcand*leptoncand->charge();
-              }
-            }
-          }
-
-          jet.addUserFloat("MuonInJetPt",MuonInJetPt);
-          jet.addUserFloat("ElectronInJetPt",ElectronInJetPt);
-          jet.addUserFloat("MuonInJetPhi",MuonInJetPhi);
-          jet.addUserFloat("ElectronInJetPhi",ElectronInJetPhi);
-          jet.addUserFloat("MuonInJetEta",MuonInJetEta);
-          jet.addUserFloat("ElectronInJetEta",ElectronInJetEta);
-          jet.addUserFloat("MuonInJetCharge",MuonInJetCharge);
-          jet.addUserFloat("ElectronInJetCharge",ElectronInJetCharge);
-          jet.addUserFloat("MuonInJetPtRel",MuonInJetPtRel);
-          jet.addUserFloat("ElectronInJetPtRel",ElectronInJetPtRel);
-          jet.addUserFloat("MuonInJetDXY",MuonInJetDXY);
-          jet.addUserFloat("MuonInJetDXYERR",MuonInJetDXYERR);
-          jet.addUserFloat("MuonInJetDZ",MuonInJetDZ);
-          jet.addUserFloat("MuonInJetDZERR",MuonInJetDZERR);
-          jet.addUserFloat("MuonInJetIsoABS",MuonInJetIsoABS);
+          summary_.fillLeptons(jet, *vertexHandle);
+          const LeptonInJetSummary& muon = summary_.muon;
+          const LeptonInJetSummary& electron = summary_.electron;
+
+          jet.addUserFloat("MuonInJetPt",muon.pt);
+          jet.addUserFloat("ElectronInJetPt",electron.pt);
+          jet.addUserFloat("MuonInJetPhi",muon.phi);
+          jet.addUserFloat("ElectronInJetPhi",electron.phi);
+          jet.addUserFloat("MuonInJetEta",muon.eta);
+          jet.addUserFloat("ElectronInJetEta",electron.eta);
+          jet.addUserFloat("MuonInJetCharge",muon.charge);
+          jet.addUserFloat("ElectronInJetCharge",electron.charge);
+          jet.addUserFloat("MuonInJetPtRel",muon.ptRel);
+          jet.addUserFloat("ElectronInJetPtRel",electron.ptRel);
+          jet.addUserFloat("MuonInJetDXY",muon.dxy);
+          jet.addUserFloat("MuonInJetDXYERR",muon.dxyError);
+          jet.addUserFloat("MuonInJetDZ",muon.dz);
+          jet.addUserFloat("MuonInJetDZERR",muon.dzError);
+          jet.addUserFloat("MuonInJetIsoABS",muon.isoAbs);
 
           out->push_back(jet);
         }
+      }
 
       iEvent.put(out);
 
@@ -166,6 +89,7 @@ class PATMuonInJetEmbedder : public edm::EDProducer {
     // ----------member data ---------------------------
     edm::InputTag src_;
     edm::InputTag srcVertices_;
+    JetConstituentSummary summary_;
 };
 
 #include "FWCore/Framework/interface/MakerMacros.h"
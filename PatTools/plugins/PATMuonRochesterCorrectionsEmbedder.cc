@@ -45,8 +45,7 @@ private:
 PATMuonRochesterCorrectionEmbedder::
 PATMuonRochesterCorrectionEmbedder(const 
 				    ParameterSet& pset):
-  _corr(PATMuonRochesterCorrection(pset,
-				   pset.getParameter<bool>("isMC"))) {
+  _corr(pset, pset.getParameter<bool>("isMC")) {
 
   _src = pset.getParameter<InputTag>("src");  
   produces<MuonCollection>();
@@ -60,15 +59,8 @@ void PATMuonRochesterCorrectionEmbedder::produce(Event& evt,
   edm::Handle<MuonCollection> mus;
   evt.getByLabel(_src,mus);
 
-  MuonCollection::const_iterator b = mus->begin();
-  MuonCollection::const_iterator i = b;
-  MuonCollection::const_iterator e = mus->end();
-
-  for( ; i != e; ++i ) {
-    MuonRef ref(mus,i - b);
-    pat::Muon cMu = _corr(ref);
-    out->push_back(cMu);
-  }
+  out->reserve(mus->size());
+  _corr(*mus, *out);
   
   evt.put(out);
 }
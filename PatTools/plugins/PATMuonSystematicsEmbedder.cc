@@ -10,6 +10,8 @@
 
 #include "DataFormats/Candidate/interface/LeafCandidate.h"
 
+#include "FinalStateAnalysis/DataFormats/interface/PATObjectShifts.h"
+
 #include "CondFormats/RecoMuonObjects/interface/MuScleFitDBobject.h"
 #include "CondFormats/DataRecord/interface/MuScleFitDBobjectRcd.h"
 #include "MuonAnalysis/MomentumScaleCalibration/interface/MomentumScaleCorrector.h"
@@ -20,6 +22,7 @@ class PATMuonSystematicsEmbedder : public edm::EDProducer {
     typedef reco::LeafCandidate ShiftedCand;
     typedef std::vector<ShiftedCand> ShiftedCandCollection;
     typedef reco::CandidatePtr CandidatePtr;
+    typedef reco::Candidate::LorentzVector LorentzVector;
 
     // Muscle fit DB object
     class CorrectorFromDB {
@@ -55,6 +58,8 @@ class PATMuonSystematicsEmbedder : public edm::EDProducer {
     void produce(edm::Event& evt, const edm::EventSetup& es);
   private:
     edm::InputTag src_;
+    // Store the shifts in a single PATObjectShifts
+    bool compact_;
     CorrectorFromDB corrector_;
     CorrectorFromDB correctorUp_;
     CorrectorFromDB correctorDown_;
@@ -66,13 +71,19 @@ PATMuonSystematicsEmbedder::PATMuonSystematicsEmbedder(
   correctorUp_(pset.getParameter<std::string>("corrTagUp")),
   correctorDown_(pset.getParameter<std::string>("corrTagDown")) {
 
+  compact_ = pset.exists("compact") ? pset.getParameter<bool>("compact") : false;
+
   // Embedded output collection
   produces<pat::MuonCollection>();
-  // Collections of shifted candidates
-  produces<ShiftedCandCollection>("p4OutUncorr");
-  produces<ShiftedCandCollection>("p4OutCorr");
-  produces<ShiftedCandCollection>("p4OutUp");
-  produces<ShiftedCandCollection>("p4OutDown");
+  if (compact_) {
+    produces<PATObjectShifts>("shifts");
+  } else {
+    // Collections of shifted candidates
+    produces<ShiftedCandCollection>("p4OutUncorr");
+    produces<ShiftedCandCollection>("p4OutCorr");
+    produces<ShiftedCandCollection>("p4OutUp");
+    produces<ShiftedCandCollection>("p4OutDown");
+  }
 
   src_ = pset.getParameter<edm::InputTag>("src");
 }
@@ -86,52 +97,79 @@ void PATMuonSystematicsEmbedder::produce(edm::Event& evt, const edm::EventSetup&
   assert(correctorDown_.get());
 
   std::auto_ptr<pat::MuonCollection> output(new pat::MuonCollection);
-  std::auto_ptr<ShiftedCandCollection> p4OutCorr(new ShiftedCandCollection);
-  std::auto_ptr<ShiftedCandCollection> p4OutUncorr(new ShiftedCandCollection);
-  std::auto_ptr<ShiftedCandCollection> p4OutUp(new ShiftedCandCollection);
-  std::auto_ptr<ShiftedCandCollection> p4OutDown(new ShiftedCandCollection);
 
   edm::Handle<edm::View<pat::Muon> > muons;
   evt.getByLabel(src_, muons);
+  size_t nMuons = muons->size();
+
+  output->reserve(nMuons);
 
-  output->reserve(muons->size());
-  p4OutCorr->reserve(muons->size());
-  p4OutUncorr->reserve(muons->size());
-  p4OutUp->reserve(muons->size());
-  p4OutDown->reserve(muons->size());
+  std::auto_ptr<ShiftedCandCollection> p4OutCorr(new ShiftedCandCollection);
+  std::auto_ptr<ShiftedCandCollection> p4OutUncorr(new ShiftedCandCollection);
+  std::auto_ptr<ShiftedCandCollection> p4OutUp(new ShiftedCandCollection);
+  std::auto_ptr<ShiftedCandCollection> p4OutDown(new ShiftedCandCollection);
 
-  for (size_t i = 0; i < muons->size(); ++i) {
-    pat::Muon muon = muons->at(i); // make a local copy
+  std::auto_ptr<PATObjectShifts> shifts;
+  if (compact_) {
+    std::vector<std::string> names;
+    names.push_back("uncorr");
+    names.push_back("corr");
+    names.push_back("mes-");
+    names.push_back("mes+");
+    shifts.reset(new PATObjectShifts(names, nMuons));
+  } else {
+    p4OutCorr->reserve(nMuons);
+    p4OutUncorr->reserve(nMuons);
+    p4OutUp->reserve(nMuons);
+    p4OutDown->reserve(nMuons);
+  }
 
-    double correctedPt = (*corrector_.get())(muon);
-    double correctedPtUp = (*correctorUp_.get())(muon);
-    double correctedPtDown = (*correctorDown_.get())(muon);
+  // The shifts are computed once, and stored either way
+  for (size_t i = 0; i < nMuons; ++i) {
+    const pat::Muon& muon = muons->at(i);
+    // Don't apply the correction by default, no one else does.
+    output->push_back(muon); // make our own copy
 
     double eta = muon.eta();
     double phi = muon.phi();
     double mass = muon.mass();
 
-    ShiftedCand uncorr(muon);
-    ShiftedCand nominal(muon);
-    ShiftedCand mesUp(muon);
-    ShiftedCand mesDown(muon);
-
-    // Don't apply the correction by default, no one else does.
-
-    nominal.setP4(reco::Particle::PolarLorentzVector(
-          correctedPt, eta, phi, mass));
-
-    mesUp.setP4(reco::Particle::PolarLorentzVector(
-          correctedPtUp, eta, phi, mass));
-
-    mesDown.setP4(reco::Particle::PolarLorentzVector(
-          correctedPtDown, eta, phi, mass));
+    LorentzVector uncorr = muon.p4();
+    LorentzVector nominal(reco::Particle::PolarLorentzVector(
+          (*corrector_.get())(muon), eta, phi, mass));
+    LorentzVector mesUp(reco::Particle::PolarLorentzVector(
+          (*correctorUp_.get())(muon), eta, phi, mass));
+    LorentzVector mesDown(reco::Particle::PolarLorentzVector(
+          (*correctorDown_.get())(muon), eta, phi, mass));
+
+    if (compact_) {
+      shifts->setP4(i, 0, uncorr);
+      shifts->setP4(i, 1, nominal);
+      shifts->setP4(i, 2, mesDown);
+      shifts->setP4(i, 3, mesUp);
+      continue;
+    }
+
+    ShiftedCand candUncorr(muon);
+    ShiftedCand candNominal(muon);
+    candNominal.setP4(nominal);
+    ShiftedCand candUp(muon);
+    candUp.setP4(mesUp);
+    ShiftedCand candDown(muon);
+    candDown.setP4(mesDown);
+
+    p4OutUncorr->push_back(candUncorr);
+    p4OutCorr->push_back(candNominal);
+    p4OutUp->push_back(candUp);
+    p4OutDown->push_back(candDown);
+  }
 
-    output->push_back(muon);
-    p4OutUncorr->push_back(uncorr);
-    p4OutCorr->push_back(nominal);
-    p4OutUp->push_back(mesUp);
-    p4OutDown->push_back(mesDown);
+  if (compact_) {
+    edm::RefProd<PATObjectShifts> shiftsRef(evt.put(shifts, "shifts"));
+    for (size_t i = 0; i < output->size(); ++i)
+      PATObjectShifts::link(output->at(i), shiftsRef, i);
+    evt.put(output);
+    return;
   }
 
   // Put the shifted collections in the event
@@ -142,18 +180,12 @@ void PATMuonSystematicsEmbedder::produce(edm::Event& evt, const edm::EventSetup&
   PutHandle p4OutDownH = evt.put(p4OutDown, "p4OutDown");
 
   // Now embed the shifted collections into the output muon collection
-  for (size_t i = 0; i < muons->size(); ++i) {
-    CandidatePtr uncorrPtr(p4OutUncorrH, i);
-    CandidatePtr nomPtr(p4OutCorrH, i);
-    CandidatePtr upPtr(p4OutDownH, i);
-    CandidatePtr downPtr(p4OutDownH, i);
-
+  for (size_t i = 0; i < output->size(); ++i) {
     pat::Muon& muon = output->at(i);
-
-    muon.addUserCand("uncorr", uncorrPtr);
-    muon.addUserCand("corr", nomPtr);
-    muon.addUserCand("mes-", downPtr);
-    muon.addUserCand("mes+", upPtr);
+    muon.addUserCand("uncorr", CandidatePtr(p4OutUncorrH, i));
+    muon.addUserCand("corr", CandidatePtr(p4OutCorrH, i));
+    muon.addUserCand("mes-", CandidatePtr(p4OutDownH, i));
+    muon.addUserCand("mes+", CandidatePtr(p4OutUpH, i));
   }
 
   evt.put(output);
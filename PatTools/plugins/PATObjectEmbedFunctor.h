@@ -0,0 +1,153 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  PATObjectEmbedFunctor.h
+ *
+ *    Description:  Framework for embedding information (userFloats, etc) into
+ *                  copies of PAT objects.
+ *
+ *                  A PATObjectEmbedFunctor<T> embeds into one object at a
+ *                  time.  It is run either:
+ *
+ *                    * alone, by PATObjectEmbedder<T, Functor>, which is how
+ *                      the standalone embedder plugins are defined, or
+ *
+ *                    * as one of a configured list of functors run by a
+ *                      PATCompositeEmbedder<T>.  The input collection is
+ *                      only copied once, and all the functors embed into the
+ *                      same copy.  This replaces a chain of embedder modules
+ *                      which each copy the full collection.
+ *
+ *                  NB that refs given to the functors (i.e. to look up value
+ *                  maps) always point to the [src] collection of the module.
+ *
+ *                  If the [src] is missing, the module puts an empty
+ *                  collection if all its functors allowMissingSrc(), and
+ *                  throws otherwise.
+ *
+ * =====================================================================================
+ */
+
+#ifndef PATOBJECTEMBEDFUNCTOR_H_6RXZ1HQL
+#define PATOBJECTEMBEDFUNCTOR_H_6RXZ1HQL
+
+#include "FWCore/Framework/interface/Frameworkfwd.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/EventSetup.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/Framework/interface/EDProducer.h"
+#include "FWCore/Utilities/interface/Exception.h"
+#include "DataFormats/Common/interface/View.h"
+
+#include <boost/ptr_container/ptr_vector.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+template<typename T>
+class PATObjectEmbedFunctor {
+  public:
+    virtual ~PATObjectEmbedFunctor(){}
+    /// Called once per event, before any objects are embedded.
+    virtual void beginEvent(const edm::Event& evt, const edm::EventSetup& es,
+        const edm::Handle<edm::View<T> >& src) {}
+    /// Embed into [object], which is a copy of src->at(index).
+    virtual void embed(T& object, size_t index) = 0;
+    /// If true, the module can run without its src.
+    virtual bool allowMissingSrc() const { return false; }
+};
+
+/// Build the functor of type [type] (the name of the equivalent standalone
+/// plugin, i.e. "PATMuonIdEmbedder") for objects of type T.  Returns NULL if
+/// the type is unknown.  Implemented for each object type in
+/// PATCompositeEmbedder.cc
+template<typename T>
+PATObjectEmbedFunctor<T>* makeEmbedFunctor(const std::string& type,
+    const edm::ParameterSet& pset);
+
+/// Copy [src] and run a single functor
+template<typename T, typename Functor>
+class PATObjectEmbedder : public edm::EDProducer {
+  public:
+    PATObjectEmbedder(const edm::ParameterSet& pset):functor_(pset) {
+      src_ = pset.getParameter<edm::InputTag>("src");
+      produces<std::vector<T> >();
+    }
+    virtual ~PATObjectEmbedder(){}
+    void produce(edm::Event& evt, const edm::EventSetup& es) {
+      edm::Handle<edm::View<T> > src;
+      std::auto_ptr<std::vector<T> > output(new std::vector<T>());
+      if (!evt.getByLabel(src_, src) && functor_.allowMissingSrc()) {
+        evt.put(output);
+        return;
+      }
+      output->reserve(src->size());
+
+      functor_.beginEvent(evt, es, src);
+      for (size_t i = 0; i < src->size(); ++i) {
+        output->push_back(src->at(i));
+        functor_.embed(output->back(), i);
+      }
+      evt.put(output);
+    }
+  private:
+    edm::InputTag src_;
+    Functor functor_;
+};
+
+/// Copy [src] once and run all the functors in [embedders], in order.  Each
+/// PSet in [embedders] has the parameters of the equivalent standalone
+/// plugin (except src), and the plugin name in [type].
+template<typename T>
+class PATCompositeEmbedder : public edm::EDProducer {
+  public:
+    PATCompositeEmbedder(const edm::ParameterSet& pset):
+      allowMissingSrc_(true) {
+      src_ = pset.getParameter<edm::InputTag>("src");
+      typedef std::vector<edm::ParameterSet> VPSet;
+      const VPSet& embedders = pset.getParameter<VPSet>("embedders");
+      for (size_t i = 0; i < embedders.size(); ++i) {
+        const std::string& type =
+          embedders[i].getParameter<std::string>("type");
+        PATObjectEmbedFunctor<T>* functor =
+          makeEmbedFunctor<T>(type, embedders[i]);
+        if (!functor) {
+          throw cms::Exception("UnknownEmbedder")
+            << "PATCompositeEmbedder: can't run an embedder of type "
+            << type << std::endl;
+        }
+        functors_.push_back(functor); // takes ownership
+        allowMissingSrc_ = allowMissingSrc_ && functor->allowMissingSrc();
+      }
+      produces<std::vector<T> >();
+    }
+    virtual ~PATCompositeEmbedder(){}
+    void produce(edm::Event& evt, const edm::EventSetup& es) {
+      edm::Handle<edm::View<T> > src;
+      std::auto_ptr<std::vector<T> > output(new std::vector<T>());
+      if (!evt.getByLabel(src_, src) && allowMissingSrc_) {
+        evt.put(output);
+        return;
+      }
+      output->reserve(src->size());
+
+      for (size_t f = 0; f < functors_.size(); ++f) {
+        functors_[f].beginEvent(evt, es, src);
+      }
+      for (size_t i = 0; i < src->size(); ++i) {
+        output->push_back(src->at(i));
+        T& object = output->back();
+        for (size_t f = 0; f < functors_.size(); ++f) {
+          functors_[f].embed(object, i);
+        }
+      }
+      evt.put(output);
+    }
+  private:
+    edm::InputTag src_;
+    bool allowMissingSrc_;
+    boost::ptr_vector<PATObjectEmbedFunctor<T> > functors_;
+};
+
+#endif /* end of include guard: PATOBJECTEMBEDFUNCTOR_H_6RXZ1HQL */
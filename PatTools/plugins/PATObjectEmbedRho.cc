@@ -6,10 +6,10 @@
 #include "DataFormats/PatCandidates/interface/Tau.h"
 #include "DataFormats/PatCandidates/interface/Photon.h"
 
-typedef PATRhoOverloader<pat::Muon> MuonRhoOverloader;
-typedef PATRhoOverloader<pat::Tau> TauRhoOverloader;
-typedef PATRhoOverloader<pat::Electron> ElectronRhoOverloader;
-typedef PATRhoOverloader<pat::Photon> PhotonRhoOverloader;
+typedef PATObjectEmbedder<pat::Muon, PATRhoEmbedFunctor<pat::Muon> > MuonRhoOverloader;
+typedef PATObjectEmbedder<pat::Tau, PATRhoEmbedFunctor<pat::Tau> > TauRhoOverloader;
+typedef PATObjectEmbedder<pat::Electron, PATRhoEmbedFunctor<pat::Electron> > ElectronRhoOverloader;
+typedef PATObjectEmbedder<pat::Photon, PATRhoEmbedFunctor<pat::Photon> > PhotonRhoOverloader;
 
 DEFINE_FWK_MODULE(MuonRhoOverloader);
 DEFINE_FWK_MODULE(ElectronRhoOverloader);
@@ -1,67 +1,44 @@
 
 //Ovserloads the lepton with the rho factor
 
+#ifndef PATOBJECTEMBEDRHO_H
+#define PATOBJECTEMBEDRHO_H
 
-// system include files
-#include <memory>
+#include "FinalStateAnalysis/PatTools/plugins/PATObjectEmbedFunctor.h"
 
-// user include files
-#include "FWCore/Framework/interface/Frameworkfwd.h"
-#include "FWCore/Framework/interface/EDProducer.h"
-
-#include "FWCore/Framework/interface/Event.h"
-#include "FWCore/Framework/interface/MakerMacros.h"
-#include "FWCore/ParameterSet/interface/ParameterSet.h"
-
-// class decleration
-//
 template <typename T>
-class PATRhoOverloader : public edm::EDProducer {
+class PATRhoEmbedFunctor : public PATObjectEmbedFunctor<T> {
 
    public:
-     explicit PATRhoOverloader (const edm::ParameterSet& iConfig):
-       src_(iConfig.getParameter<edm::InputTag>("src")),
-       srcRho_(iConfig.getParameter<edm::InputTag>("srcRho"))
+     explicit PATRhoEmbedFunctor (const edm::ParameterSet& iConfig):
+       srcRho_(iConfig.getParameter<edm::InputTag>("srcRho")),
+       rho_(0.0)
        {
          label_ = iConfig.exists("userLabel") ? iConfig.getParameter<std::string>("userLabel") : "rho";
-	 produces<std::vector<T> >();
        }
 
-      ~PATRhoOverloader ()
-	{
-
-	}
-
-   private:
-
-
-      virtual void produce(edm::Event& iEvent, const edm::EventSetup& iSetup)
-	{
-	  //Read the shallow clones of a candidate and save the SECOND Clone
-	  std::auto_ptr<std::vector<T> > out(new std::vector<T> );
-	  edm::Handle<std::vector<T> > src;
-
-	  float rho = 0.0;
-
-	  edm::Handle<double> srcRho;
-	  if(iEvent.getByLabel(srcRho_,srcRho))
-	    rho = *srcRho;
-
-
-	  if(iEvent.getByLabel(src_,src))
-	    for(unsigned int i=0;i<src->size();++i) {
-	      T obj = src->at(i);
-	      obj.addUserFloat(label_, rho );
-	      out->push_back(obj);
-	    }
-
-	  iEvent.put(out);
-	}
+     void beginEvent(const edm::Event& iEvent, const edm::EventSetup& iSetup,
+         const edm::Handle<edm::View<T> >& src)
+       {
+         rho_ = 0.0;
+         edm::Handle<double> srcRho;
+         if(iEvent.getByLabel(srcRho_,srcRho))
+           rho_ = *srcRho;
+       }
 
-      virtual void endJob() { }
+     void embed(T& obj, size_t index)
+       {
+         obj.addUserFloat(label_, rho_);
+       }
 
-      edm::InputTag src_;
-      edm::InputTag srcRho_;
-      std::string label_;
+     // Put an empty collection if the src is missing, as the old
+     // PATRhoOverloader did
+     bool allowMissingSrc() const { return true; }
 
+   private:
+     edm::InputTag srcRho_;
+     std::string label_;
+     float rho_;
 };
+
+#endif
@@ -0,0 +1,77 @@
+/*
+  Embed into a PATObject ValueMap(s) result as user float.
+  Value maps are passed thrugh maps parameter as VPSet each
+  PSet contains and inputTag called src and a string
+  called label
+
+  The value maps must be keyed to the src collection.
+
+  Author: Mauro Verzett (UZH)
+ */
+
+#ifndef PATOBJECTVALUEMAPEMBEDDER_H
+#define PATOBJECTVALUEMAPEMBEDDER_H
+
+#include "FinalStateAnalysis/PatTools/plugins/PATObjectEmbedFunctor.h"
+#include "DataFormats/Common/interface/ValueMap.h"
+
+#include <vector>
+#include <string>
+
+template <typename T>
+class PATValueMapEmbedFunctor : public PATObjectEmbedFunctor<T> {
+
+public:
+  PATValueMapEmbedFunctor(const edm::ParameterSet& iConfig);
+
+  void beginEvent(const edm::Event& evt, const edm::EventSetup& es,
+      const edm::Handle<edm::View<T> >& src);
+  void embed(T& object, size_t index);
+
+private:
+  typedef std::vector<edm::ParameterSet> VPSet;
+  std::vector<edm::InputTag> mapSrcs_;
+  std::vector<std::string> labels_;
+  // Current event
+  edm::Handle<edm::View<T> > src_;
+  std::vector<edm::Handle<edm::ValueMap<float> > > maps_;
+};
+
+template <typename T>
+PATValueMapEmbedFunctor<T>::PATValueMapEmbedFunctor(const edm::ParameterSet& iConfig)
+{
+  VPSet maps = iConfig.getParameter<VPSet>("maps");
+  for (VPSet::const_iterator imap_info = maps.begin(); imap_info != maps.end(); ++imap_info) {
+    mapSrcs_.push_back(imap_info->getParameter<edm::InputTag>("src"));
+    labels_.push_back(imap_info->getParameter<std::string>("label"));
+  }
+}
+
+template <typename T>
+void PATValueMapEmbedFunctor<T>::beginEvent(const edm::Event& evt,
+    const edm::EventSetup& es, const edm::Handle<edm::View<T> >& src)
+{
+  src_ = src;
+  maps_.resize(mapSrcs_.size());
+  for (size_t imap = 0; imap < mapSrcs_.size(); ++imap) {
+    evt.getByLabel(mapSrcs_[imap], maps_[imap]);
+    // In a composite embedder, src is the input of the first embedder
+    if (src->size() && !maps_[imap]->contains(src->refAt(0).id())) {
+      throw cms::Exception("MismatchedValueMap")
+        << "The value map " << mapSrcs_[imap] << " (" << labels_[imap]
+        << ") is not keyed to the src collection" << std::endl;
+    }
+  }
+}
+
+template <typename T>
+void PATValueMapEmbedFunctor<T>::embed(T& object, size_t index)
+{
+  // Embed map outputs (the ValueMap<float>s)
+  for (size_t imap = 0; imap < maps_.size(); ++imap) {
+    float map_result = (*maps_[imap])[src_->refAt(index)];
+    object.addUserFloat(labels_[imap], map_result);
+  }
+}
+
+#endif
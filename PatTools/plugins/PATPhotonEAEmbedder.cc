@@ -42,6 +42,7 @@ private:
   InputTag _src,;
   vstring _eas_to_get;  
   PATPhotonEACalculator _eacalc;
+  std::vector<double> _eas;
   
 };
 
@@ -50,6 +51,7 @@ PATPhotonEAEmbedder::PATPhotonEAEmbedder(const
   :_eacalc(PATPhotonEACalculator(pset.getParameterSetVector("effective_areas"))){
   _eas_to_get = pset.getParameter<vstring>("applied_effective_areas");
   _src = pset.getParameter<InputTag>("src");  
+  _eacalc.setEATypes(_eas_to_get);
   produces<PhotonCollection>();
 }
 
@@ -62,22 +64,16 @@ void PATPhotonEAEmbedder::produce(Event& evt,
   edm::Handle<PhotonCollection> handle;
   evt.getByLabel(_src, handle);
   
-  vstring::const_iterator i;
-  vstring::const_iterator e = _eas_to_get.end();
-
   // Check if our inputs are in our outputs
   for (size_t iPho = 0; iPho < handle->size(); ++iPho) {
     const Photon* currentPhoton = &(handle->at(iPho));   
     Photon newPhoton = *currentPhoton;    
-      
-    for( i = _eas_to_get.begin(); i != e; ++i ) {
-      
-      _eacalc.setEAType(*i);
 
-      double the_ea = _eacalc(*currentPhoton);
+    // all the requested effective areas at once
+    _eacalc(*currentPhoton, _eas);
       
-      newPhoton.addUserFloat(*i,the_ea);    
-    }
+    for( size_t i = 0; i < _eas_to_get.size(); ++i ) 
+      newPhoton.addUserFloat(_eas_to_get[i],_eas[i]);    
     output->push_back(newPhoton);
   }
 
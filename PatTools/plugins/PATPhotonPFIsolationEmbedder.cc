@@ -3,9 +3,16 @@
  *
  * Author: Lindsey A. Gray, UW Madison
  *
+ * The isolation is computed for each vertex, over the full PF collection.
+ * If pfPreselectionRadius > 0, only the PF candidates within that deltaR of
+ * the photon are given to the isolation instead, found once per photon from
+ * an eta-phi index of the collection.  The radius must be well beyond the
+ * cone size, since the isolation cones are taken w.r.t. each vertex.
+ *
  */
 
 #include "FinalStateAnalysis/PatTools/interface/PATPhotonPFIsolation.h"
+#include "FinalStateAnalysis/DataAlgos/interface/EtaPhiIndex.h"
 #include <algorithm>
 
 #include "FWCore/Framework/interface/EDProducer.h"
@@ -15,6 +22,7 @@
 
 #include "DataFormats/VertexReco/interface/VertexFwd.h"
 #include "DataFormats/VertexReco/interface/Vertex.h"
+#include "DataFormats/ParticleFlowCandidate/interface/PFCandidate.h"
 
 #include "DataFormats/PatCandidates/interface/Photon.h"
 #include "DataFormats/PatCandidates/interface/Isolation.h"
@@ -49,6 +57,10 @@ private:
   PATPhotonPFIsolation _iso;
   const std::string _i_chad,_i_nhad,_i_pho,_cone;  
   char buf[20];
+  double _pfPreselectionRadius;
+  EtaPhiIndex _pfIndex;
+  std::vector<size_t> _pfNearbyIndices;
+  reco::PFCandidateCollection _pfNearby;
 };
 
 PATPhotonPFIsolationEmbedder::PATPhotonPFIsolationEmbedder(const 
@@ -63,6 +75,8 @@ PATPhotonPFIsolationEmbedder::PATPhotonPFIsolationEmbedder(const
   _vtxsrc = pset.getParameter<InputTag>("vtxSrc"); 
   _defaultVertex = pset.getParameter<unsigned>("defaultVertex");
   _userFloatPrefix = pset.getParameter<std::string>("userFloatPrefix");
+  _pfPreselectionRadius = pset.exists("pfPreselectionRadius") ?
+    pset.getParameter<double>("pfPreselectionRadius") : 0.;
   produces<PhotonCollection>();
 }
 
@@ -80,19 +94,32 @@ void PATPhotonPFIsolationEmbedder::produce(Event& evt,
 
   edm::Handle<reco::PFCandidateCollection> pfparts;
   evt.getByLabel(_pfcollsrc,pfparts);
+  if (_pfPreselectionRadius > 0)
+    _pfIndex.fill(*pfparts);
   
   // Check if our inputs are in our outputs
   for (size_t iPho = 0; iPho < handle->size(); ++iPho) {
     const Photon* currentPhoton = &(handle->at(iPho));   
     Photon newPhoton = *currentPhoton;    
 
+    // The candidates given to the isolation, the same for all vertices
+    const reco::PFCandidateCollection* isoCandidates = pfparts.product();
+    if (_pfPreselectionRadius > 0) {
+      _pfIndex.within(currentPhoton->eta(), currentPhoton->phi(),
+          _pfPreselectionRadius, _pfNearbyIndices);
+      _pfNearby.clear();
+      for (size_t i = 0; i < _pfNearbyIndices.size(); ++i)
+        _pfNearby.push_back(pfparts->at(_pfNearbyIndices[i]));
+      isoCandidates = &_pfNearby;
+    }
+
     for (size_t iVtx = 0; iVtx < vtxs->size(); ++iVtx) {
       memset(buf,0,20*sizeof(char));
       sprintf(buf,"_vtx%lu",iVtx);
       std::string postfix(buf);
 
       VertexRef the_pv = VertexRef(vtxs,iVtx);
-      pfisolation the_iso = _iso(currentPhoton,pfparts.product(),the_pv,vtxs);
+      pfisolation the_iso = _iso(currentPhoton,isoCandidates,the_pv,vtxs);
       
       if (iVtx == _defaultVertex) {
 	newPhoton.setIsolation(pat::PfChargedHadronIso,the_iso.iso_chg_had);
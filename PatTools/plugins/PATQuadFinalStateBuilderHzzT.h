@@ -199,6 +199,10 @@ PATQuadFinalStateBuilderHzzT<FinalState>::produce(
     //
     // -------------------------------------------------
 
+    // The nearestLepton userCand of the photons is not used here: it points
+    // to the reco lepton seeds of FSRPhotonProducer, not to the selected
+    // leptons of the final state legs.
+
     std::map<reco::CandidatePtr, std::vector<edm::Ptr<pat::PFParticle> > > photonMap;
     for ( size_t i = 0; i < photons->size(); ++i )
     {
@@ -10,10 +10,10 @@
 
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 #include "DataFormats/PatCandidates/interface/Jet.h"
-#include "DataFormats/BTauReco/interface/SecondaryVertexTagInfo.h"
-#include "DataFormats/BTauReco/interface/TrackIPTagInfo.h"
 
-#include "Math/GenVector/VectorUtil.h"
+#include "FinalStateAnalysis/PatTools/interface/JetConstituentSummary.h"
+
+#include <sstream>
 
 class PATSSVJetEmbedder : public edm::EDProducer {
   public:
@@ -21,6 +21,15 @@ class PATSSVJetEmbedder : public edm::EDProducer {
     explicit PATSSVJetEmbedder(const edm::ParameterSet& iConfig):
       src_(iConfig.getParameter<edm::InputTag>("src"))
   {
+    const char* components[4] = {"px", "py", "pz", "charge"};
+    for (unsigned it=0; it<SecondaryVertexSummary::maxTracks; ++it) {
+      for (unsigned ic=0; ic<4; ++ic) {
+        std::ostringstream name;
+        name << "_track" << (it+1) << "_" << components[ic];
+        trackNames_[it][ic] = "SSV" + name.str();
+        trackNegNames_[it][ic] = "SSVNeg" + name.str();
+      }
+    }
     produces<pat::JetCollection>();
   }
 
@@ -37,280 +46,64 @@ class PATSSVJetEmbedder : public edm::EDProducer {
       std::auto_ptr<pat::JetCollection > out(new pat::JetCollection);
       Handle<pat::JetCollection > cands;
 
-      if(iEvent.getByLabel(src_,cands))
+      if(iEvent.getByLabel(src_,cands)) {
+        out->reserve(cands->size());
         for(unsigned int  i=0;i!=cands->size();++i){
           pat::Jet jet = cands->at(i);
 
-          double btagSSVHEPOS[5]={-777,-777,-777,-777,-777};
-          double btagSSVHPPOS[5]={-777,-777,-777,-777,-777};
-          double btagSSVHENEG[5]={-777,-777,-777,-777,-777};
-          double btagSSVHPNEG[5]={-777,-777,-777,-777,-777};
-          double mass_SSV=-777;
-          double mass_SSVNEG=-777;
-
-          double massD_SSV=-777;
-          double massD_SSVNEG=-777;
-
-          double massD0_SSV=-777;
-          double massD0_SSVNEG=-777;
-
-          unsigned int nSSVNEG=0, nSSVPOS=0;
-          unsigned int nTracks_SSVPOS[5]={0,0,0,0,0}; // Up to 5 just to be safe
-          double flightDistancePOS[5]={-777,-777,-777,-777,-777};
-          double errorFlightDistancePOS[5]={-777,-777,-777,-777,-777};
-          unsigned int nTracks_SSVNEG[5]={0,0,0,0,0};
-          double flightDistanceNEG[5]={-777,-777,-777,-777,-777};
-          double errorFlightDistanceNEG[5]={-777,-777,-777,-777,-777};
-
-          int chargeSSV=0;
-          int chargeSSVNEG=0;
-
-          double track1_px=-777, track1_py=-777, track1_pz=-777;    // Seriously, this has to be redone and coded as a vector. Is there a userVector thing?
-          double track2_px=-777, track2_py=-777, track2_pz=-777;
-          double track3_px=-777, track3_py=-777, track3_pz=-777;
-
-          double trackNeg1_px=-777, trackNeg1_py=-777, trackNeg1_pz=-777;
-          double trackNeg2_px=-777, trackNeg2_py=-777, trackNeg2_pz=-777;
-          double trackNeg3_px=-777, trackNeg3_py=-777, trackNeg3_pz=-777;
-
-          int track1_charge=-777, track2_charge=-777, track3_charge=-777;
-          int trackNeg1_charge=-777, trackNeg2_charge=-777, trackNeg3_charge=-777;
-
-
-          const reco::SecondaryVertexTagInfo* secInfo = jet.tagInfoSecondaryVertex("secondaryVertex");
-          if (secInfo && secInfo->vertexTracks().size()>0) {
-            // Loop on all tracks of all secondary vertices to determine the mass
-            double enall = 0.;
-            double pxall = 0.;
-            double pyall = 0.;
-            double pzall = 0.;
-            double enD = 0.;
-            double enD0_1 = 0.;
-            double enD0_2 = 0.;
-
-            int chargeSSV=0;   // first find charge of vertex (to see if it is D+ or D-)
-
-            for (unsigned int it=0; it<secInfo->vertexTracks().size(); ++it) {
-              chargeSSV+=secInfo->vertexTracks()[it]->charge();
-            }
-
-            for (unsigned int it=0; it<secInfo->vertexTracks().size(); ++it) {
-              double px = secInfo->vertexTracks()[it]->px();
-              double py = secInfo->vertexTracks()[it]->py();
-              double pz = secInfo->vertexTracks()[it]->pz();
-              enall += sqrt(px*px+py*py+pz*pz+0.1396*0.1396);    // mass v1: everything is a pion
-              pxall += px;
-              pyall += py;
-              pzall += pz;
-
-              if(secInfo->vertexTracks().size()==3 && abs(chargeSSV)==1){  // check if this is a 3 track decay with global charge -1 or +1
-                double mass_hadron=0.1396;
-                if(secInfo->vertexTracks()[it]->charge()*chargeSSV<0) mass_hadron=0.493677;  // (pi-,pi-,ka+) or (pi+,pi+,k-)
-                enD += sqrt(px*px+py*py+pz*pz+mass_hadron*mass_hadron);    // mass v2:  2 pions and a kaon
-              }
-
-              if(secInfo->vertexTracks().size()==2) { // Look for D0. This is more complicated (kpi, which is k and which is pi?)
-                double mass_pi=0.1396, mass_k=0.493677;
-                if(it==0){
-                  enD0_1 += sqrt(px*px+py*py+pz*pz+mass_pi*mass_pi);    // mass v3: pi +ka
-                  enD0_2 += sqrt(px*px+py*py+pz*pz+mass_k*mass_k);
-                } else if(it==1){
-                  enD0_1 += sqrt(px*px+py*py+pz*pz+mass_k*mass_k);    // mass v3: pi + ka
-                  enD0_2 += sqrt(px*px+py*py+pz*pz+mass_pi*mass_pi);
-                }
-              }
-
-              if(it==0) {track1_px=px; track1_py=py; track1_pz=pz; track1_charge=secInfo->vertexTracks()[it]->charge();}
-              else if (it==1) {track2_px=px; track2_py=py; track2_pz=pz; track2_charge=secInfo->vertexTracks()[it]->charge();}
-              else if (it==2) {track3_px=px; track3_py=py; track3_pz=pz; track3_charge=secInfo->vertexTracks()[it]->charge();}
-            }
-            double mass2 = enall*enall-pxall*pxall-pyall*pyall-pzall*pzall;
-            if (mass2>0.) mass_SSV = sqrt(mass2);
-
-            double mass2D = enD*enD-pxall*pxall-pyall*pyall-pzall*pzall;
-            if (mass2D>0.) massD_SSV = sqrt(mass2D);
-
-            double mass2D0_1 = enD0_1*enD0_1-pxall*pxall-pyall*pyall-pzall*pzall;
-            if (mass2D0_1>0.) mass2D0_1 = sqrt(mass2D0_1);
-
-            double mass2D0_2 = enD0_2*enD0_2-pxall*pxall-pyall*pyall-pzall*pzall;
-            if (mass2D0_2>0.) mass2D0_2 = sqrt(mass2D0_2);
-
-            if( fabs(mass2D0_1-1.87)<0.05 && fabs(mass2D0_2-1.87)>0.05)  massD0_SSV=mass2D0_1;
-            else if ( fabs(mass2D0_2-1.87)<0.05 && fabs(mass2D0_1-1.87)>0.05)  massD0_SSV=mass2D0_2;
-
-            nSSVPOS=secInfo->nVertices();
-            for (unsigned int isv=0; isv<secInfo->nVertices(); ++isv) {
-              nTracks_SSVPOS[isv]=(secInfo->nVertexTracks(isv));
-              flightDistancePOS[isv]=(secInfo->flightDistance(isv).value());
-              errorFlightDistancePOS[isv]=(secInfo->flightDistance(isv).error());
-            }
+          summary_.fillSecondaryVertices(jet);
+          const SecondaryVertexSummary& pos = summary_.positive;
+          const SecondaryVertexSummary& neg = summary_.negative;
+
+          jet.addUserFloat("nSSV",pos.nVertices);
+          jet.addUserFloat("nNegativeSSV",neg.nVertices);
+          jet.addUserFloat("mass_SSV",pos.mass);
+          jet.addUserFloat("mass_SSVNEG",neg.mass);
+          jet.addUserFloat("massD_SSV",pos.massD);
+          jet.addUserFloat("massD_SSVNEG",neg.massD);
+
+          // The vertex charges have always been stored as 0
+          jet.addUserFloat("chargeSSV",0);
+          jet.addUserFloat("chargeSSVNEG",0);
+
+          jet.addUserFloat("massD0_SSV",pos.massD0);
+          jet.addUserFloat("massD0_SSVNEG",neg.massD0);
+
+          // As before, the tracks of the negative tag info take the place of
+          // the positive ones, and the SSVNeg_track ones are never filled.
+          for (unsigned it=0; it<SecondaryVertexSummary::maxTracks; ++it) {
+            const SecondaryVertexSummary& tracks = neg.nVertexTracks>it ? neg : pos;
+            jet.addUserFloat(trackNegNames_[it][0],-777);
+            jet.addUserFloat(trackNegNames_[it][1],-777);
+            jet.addUserFloat(trackNegNames_[it][2],-777);
+            jet.addUserFloat(trackNegNames_[it][3],-777);
+
+            jet.addUserFloat(trackNames_[it][0],tracks.trackPx[it]);
+            jet.addUserFloat(trackNames_[it][1],tracks.trackPy[it]);
+            jet.addUserFloat(trackNames_[it][2],tracks.trackPz[it]);
+            jet.addUserFloat(trackNames_[it][3],tracks.trackCharge[it]);
           }
 
-          const reco::SecondaryVertexTagInfo* secNegInfo = jet.tagInfoSecondaryVertex("secondaryVertexNegative");
-
-          if (secNegInfo && secNegInfo->vertexTracks().size()>0) {
-            // Loop on all tracks of all secondary vertices to determine the mass
-            double enall = 0.;
-            double pxall = 0.;
-            double pyall = 0.;
-            double pzall = 0.;
-            double enD = 0.;
-            double enD0_1 = 0.;
-            double enD0_2 = 0.;
-
-            int chargeSSVNEG=0;   // first find charge of vertex (to see if it is D+ or D-)
-
-            for (unsigned int it=0; it<secNegInfo->vertexTracks().size(); ++it) {
-              chargeSSVNEG+=secNegInfo->vertexTracks()[it]->charge();
-            }
-
-            for (unsigned int it=0; it<secNegInfo->vertexTracks().size(); ++it) {
-              double px = secNegInfo->vertexTracks()[it]->px();
-              double py = secNegInfo->vertexTracks()[it]->py();
-              double pz = secNegInfo->vertexTracks()[it]->pz();
-              enall += sqrt(px*px+py*py+pz*pz+0.1396*0.1396);    // mass v1: everything is a pion
-              pxall += px;
-              pyall += py;
-              pzall += pz;
-
-              if(secNegInfo->vertexTracks().size()==3 && abs(chargeSSVNEG)==1){  // check if this is a 3 track decay with global charge -1 or +1
-                double mass_hadron=0.1396;
-                if(secNegInfo->vertexTracks()[it]->charge()*chargeSSVNEG<0) mass_hadron=0.493677;  // (pi-,pi-,ka+) or (pi+,pi+,k-)
-                enD += sqrt(px*px+py*py+pz*pz+mass_hadron*mass_hadron);    // mass v2:  2 pions and a kaon
-              }
-
-              if(secNegInfo->vertexTracks().size()==2) { // Look for D0. This is more complicated (kpi, which is k and which is pi?)
-                double mass_pi=0.1396, mass_k=0.493677;
-                if(it==0){
-                  enD0_1 += sqrt(px*px+py*py+pz*pz+mass_pi*mass_pi);    // mass v3: pi +ka
-                  enD0_2 += sqrt(px*px+py*py+pz*pz+mass_k*mass_k);
-                } else if(it==1){
-                  enD0_1 += sqrt(px*px+py*py+pz*pz+mass_k*mass_k);    // mass v3: pi + ka
-                  enD0_2 += sqrt(px*px+py*py+pz*pz+mass_pi*mass_pi);
-                }
-              }
-
-              if(it==0) {track1_px=px; track1_py=py; track1_pz=pz; track1_charge=secNegInfo->vertexTracks()[it]->charge();}
-              else if (it==1) {track2_px=px; track2_py=py; track2_pz=pz; track2_charge=secNegInfo->vertexTracks()[it]->charge();}
-              else if (it==2) {track3_px=px; track3_py=py; track3_pz=pz; track3_charge=secNegInfo->vertexTracks()[it]->charge();}
-            }
-            double mass2 = enall*enall-pxall*pxall-pyall*pyall-pzall*pzall;
-            if (mass2>0.) mass_SSVNEG = sqrt(mass2);
-
-            double mass2D = enD*enD-pxall*pxall-pyall*pyall-pzall*pzall;
-            if (mass2D>0.) massD_SSVNEG = sqrt(mass2D);
-
-            double mass2D0_1 = enD0_1*enD0_1-pxall*pxall-pyall*pyall-pzall*pzall;
-            if (mass2D0_1>0.) mass2D0_1 = sqrt(mass2D0_1);
-
-            double mass2D0_2 = enD0_2*enD0_2-pxall*pxall-pyall*pyall-pzall*pzall;
-            if (mass2D0_2>0.) mass2D0_2 = sqrt(mass2D0_2);
-
-            if( fabs(mass2D0_1-1.87)<0.05 && fabs(mass2D0_2-1.87)>0.05)  massD0_SSVNEG=mass2D0_1;
-            else if ( fabs(mass2D0_2-1.87)<0.05 && fabs(mass2D0_1-1.87)>0.05)  massD0_SSVNEG=mass2D0_2;
-
-            nSSVNEG=secNegInfo->nVertices();
-            for (unsigned int isv=0; isv<secNegInfo->nVertices(); ++isv) {
-              nTracks_SSVNEG[isv]=(secNegInfo->nVertexTracks(isv));
-              flightDistanceNEG[isv]=(secNegInfo->flightDistance(isv).value());
-              errorFlightDistanceNEG[isv]=(secNegInfo->flightDistance(isv).error());
-            }
-          }
-
-
-          for (unsigned int isv=0; isv<nSSVPOS; ++isv) {
-            if (nTracks_SSVPOS[isv]<2) continue;
-            if (errorFlightDistancePOS[isv]<=0.) continue;
-            if (flightDistancePOS[isv]<0.) continue;
-            btagSSVHEPOS[isv]=log(1.+flightDistancePOS[isv]/errorFlightDistancePOS[isv]);
-          }
-
-          for (unsigned int isv=0; isv<nSSVNEG; ++isv) {
-            if (nTracks_SSVNEG[isv]<2) continue;
-            if (errorFlightDistanceNEG[isv]<=0.) continue;
-            if (flightDistanceNEG[isv]>0.) continue;
-            btagSSVHENEG[isv]=-log(1.-flightDistanceNEG[isv]/errorFlightDistanceNEG[isv]);
-          }
-
-
-
-          for (unsigned int isv=0; isv<nSSVPOS; ++isv) {
-            if (nTracks_SSVPOS[isv]<3) continue;
-            if (errorFlightDistancePOS[isv]<=0.) continue;
-            if (flightDistancePOS[isv]<0.) continue;
-            btagSSVHPPOS[isv]=log(1.+flightDistancePOS[isv]/errorFlightDistancePOS[isv]);
-          }
-
-          for (unsigned int isv=0; isv<nSSVNEG; ++isv) {
-            if (nTracks_SSVNEG[isv]<3) continue;
-            if (errorFlightDistanceNEG[isv]<=0.) continue;
-            if (flightDistanceNEG[isv]>0.) continue;
-            btagSSVHPNEG[isv]=-log(1.-flightDistanceNEG[isv]/errorFlightDistanceNEG[isv]);
-          }
-          jet.addUserFloat("nSSV",nSSVPOS);
-          jet.addUserFloat("nNegativeSSV",nSSVNEG);
-          jet.addUserFloat("mass_SSV",mass_SSV);
-          jet.addUserFloat("mass_SSVNEG",mass_SSVNEG);
-          jet.addUserFloat("massD_SSV",massD_SSV);
-          jet.addUserFloat("massD_SSVNEG",massD_SSVNEG);
-
-          jet.addUserFloat("chargeSSV",chargeSSV);
-          jet.addUserFloat("chargeSSVNEG",chargeSSVNEG);
-
-          jet.addUserFloat("massD0_SSV",massD0_SSV);
-          jet.addUserFloat("massD0_SSVNEG",massD0_SSVNEG);
-
-          jet.addUserFloat("SSVNeg_track1_px",trackNeg1_px);
-          jet.addUserFloat("SSVNeg_track1_py",trackNeg1_py);
-          jet.addUserFloat("SSVNeg_track1_pz",trackNeg1_pz);
-          jet.addUserFloat("SSVNeg_track1_charge",trackNeg1_charge);
-
-          jet.addUserFloat("SSV_track1_px",track1_px);
-          jet.addUserFloat("SSV_track1_py",track1_py);
-          jet.addUserFloat("SSV_track1_pz",track1_pz);
-          jet.addUserFloat("SSV_track1_charge",track1_charge);
-
-          jet.addUserFloat("SSVNeg_track2_px",trackNeg2_px);
-          jet.addUserFloat("SSVNeg_track2_py",trackNeg2_py);
-          jet.addUserFloat("SSVNeg_track2_pz",trackNeg2_pz);
-          jet.addUserFloat("SSVNeg_track2_charge",trackNeg2_charge);
-
-          jet.addUserFloat("SSV_track2_px",track2_px);
-          jet.addUserFloat("SSV_track2_py",track2_py);
-          jet.addUserFloat("SSV_track2_pz",track2_pz);
-          jet.addUserFloat("SSV_track2_charge",track2_charge);
-
-          jet.addUserFloat("SSVNeg_track3_px",trackNeg3_px);
-          jet.addUserFloat("SSVNeg_track3_py",trackNeg3_py);
-          jet.addUserFloat("SSVNeg_track3_pz",trackNeg3_pz);
-          jet.addUserFloat("SSVNeg_track3_charge",trackNeg3_charge);
-
-          jet.addUserFloat("SSV_track3_px",track3_px);
-          jet.addUserFloat("SSV_track3_py",track3_py);
-          jet.addUserFloat("SSV_track3_pz",track3_pz);
-          jet.addUserFloat("SSV_track3_charge",track3_charge);
-
-          jet.addUserFloat("btagSSVHE",btagSSVHEPOS[0]);
-          jet.addUserFloat("btagSSVHP",btagSSVHPPOS[0]);
-          jet.addUserFloat("nTracksSSV",nTracks_SSVPOS[0]);
-          jet.addUserFloat("errorFlightDistance",errorFlightDistancePOS[0]);
-          jet.addUserFloat("flightDistance",flightDistancePOS[0]);
-          jet.addUserFloat("btagSSVHE2",btagSSVHEPOS[1]);
-          jet.addUserFloat("btagSSVHP2",btagSSVHPPOS[1]);
-          jet.addUserFloat("nTracksSSV2",nTracks_SSVPOS[1]);
-          jet.addUserFloat("errorFlightDistance2",errorFlightDistancePOS[1]);
-          jet.addUserFloat("flightDistance2",flightDistancePOS[1]);
-
-          jet.addUserFloat("btagNEGSSVHE",btagSSVHENEG[0]);
-          jet.addUserFloat("btagNEGSSVHP",btagSSVHPNEG[0]);
-          jet.addUserFloat("nTracksNEGSSV",nTracks_SSVNEG[0]);
-          jet.addUserFloat("errorFlightDistanceNEG",errorFlightDistanceNEG[0]);
-          jet.addUserFloat("flightDistanceNEG",flightDistanceNEG[0]);
+          jet.addUserFloat("btagSSVHE",pos.discriminator(0,2,false));
+          jet.addUserFloat("btagSSVHP",pos.discriminator(0,3,false));
+          jet.addUserFloat("nTracksSSV",pos.nTracks[0]);
+          jet.addUserFloat("errorFlightDistance",pos.errorFlightDistance[0]);
+          jet.addUserFloat("flightDistance",pos.flightDistance[0]);
+          jet.addUserFloat("btagSSVHE2",pos.discriminator(1,2,false));
+          jet.addUserFloat("btagSSVHP2",pos.discriminator(1,3,false));
+          jet.addUserFloat("nTracksSSV2",pos.nTracks[1]);
+          jet.addUserFloat("errorFlightDistance2",pos.errorFlightDistance[1]);
+          jet.addUserFloat("flightDistance2",pos.flightDistance[1]);
+
+          jet.addUserFloat("btagNEGSSVHE",neg.discriminator(0,2,true));
+          jet.addUserFloat("btagNEGSSVHP",neg.discriminator(0,3,true));
+          jet.addUserFloat("nTracksNEGSSV",neg.nTracks[0]);
+          jet.addUserFloat("errorFlightDistanceNEG",neg.errorFlightDistance[0]);
+          jet.addUserFloat("flightDistanceNEG",neg.flightDistance[0]);
 
           out->push_back(jet);
-
         }
+      }
 
 
 
@@ -320,6 +113,10 @@ class PATSSVJetEmbedder : public edm::EDProducer {
 
     // ----------member data ---------------------------
     edm::InputTag src_;
+    JetConstituentSummary summary_;
+    // userFloat names of the track px, py, pz and charge
+    std::string trackNames_[SecondaryVertexSummary::maxTracks][4];
+    std::string trackNegNames_[SecondaryVertexSummary::maxTracks][4];
 };
 
 #include "FWCore/Framework/interface/MakerMacros.h"
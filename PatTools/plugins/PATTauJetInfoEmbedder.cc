@@ -8,6 +8,7 @@
 #include "FWCore/Framework/interface/EventSetup.h"
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 #include "FWCore/Framework/interface/EDProducer.h"
+#include "FWCore/Utilities/interface/Exception.h"
 
 #include "DataFormats/PatCandidates/interface/Muon.h"
 #include "DataFormats/PatCandidates/interface/Electron.h"
@@ -16,6 +17,11 @@
 
 #include "DataFormats/Math/interface/deltaR.h"
 
+#include "FinalStateAnalysis/DataAlgos/interface/EtaPhiIndex.h"
+
+#include <algorithm>
+#include <limits>
+
 // Helper functions to extract the 4 vector information from the object
 namespace {
   // Taus we can get the value straight from the jet
@@ -45,6 +51,21 @@ class PATObjectJetInfoEmbedder : public edm::EDProducer {
     double maxDeltaR_;
     bool embedBtags_;
     std::string suffix_;
+    std::string jetLabel_;
+
+    // Direction of the uncorrected jets, indexed once per event
+    std::vector<double> jetEtas_;
+    std::vector<double> jetPhis_;
+    EtaPhiIndex jetIndex_;
+    std::vector<size_t> nearJets_;
+
+    // The b-tag discriminator names of the jets, in the order of
+    // getPairDiscri(), with the userFloat names they are stored as.  The
+    // jets of a collection have the same discriminators, so these are
+    // checked against the first jet of each event, and only rebuilt if they
+    // change.
+    std::vector<std::string> btagSources_;
+    std::vector<std::string> btagNames_;
 };
 
 template<class T>
@@ -55,6 +76,7 @@ PATObjectJetInfoEmbedder<T>::PATObjectJetInfoEmbedder(
   suffix_ = pset.getParameter<std::string>("suffix");
   embedBtags_ = pset.getParameter<bool>("embedBtags");
   maxDeltaR_ = pset.getParameter<double>("maxDeltaR");
+  jetLabel_ = "patJet" + suffix_;
   produces<TCollection>();
 }
 
@@ -78,33 +100,82 @@ void PATObjectJetInfoEmbedder<T>::produce(
 //
   typedef edm::Ptr<pat::Jet> JetPtr;
 
+  // Index the jets once.  Use the uncorrected P4, embedded in the
+  // UncorrectedEmbedder module.
+  jetEtas_.resize(jets->size());
+  jetPhis_.resize(jets->size());
+  jetIndex_.clear();
+  for (size_t j = 0; j < jets->size(); ++j) {
+    reco::CandidatePtr uncorrected = jets->at(j).userCand("uncorr");
+    assert(uncorrected.isNonnull());
+    jetEtas_[j] = uncorrected->p4().eta();
+    jetPhis_[j] = uncorrected->p4().phi();
+    jetIndex_.insert(jetEtas_[j], jetPhis_[j], j);
+  }
+  if (embedBtags_ && !jets->empty()) {
+    const std::vector<std::pair<std::string, float> >& bTags =
+      jets->at(0).getPairDiscri();
+    bool sameNames = (bTags.size() == btagSources_.size());
+    for (size_t iTag = 0; sameNames && iTag < bTags.size(); ++iTag)
+      sameNames = (bTags[iTag].first == btagSources_[iTag]);
+    if (!sameNames) {
+      btagSources_.clear();
+      btagNames_.clear();
+      for (size_t iTag = 0; iTag < bTags.size(); ++iTag) {
+        btagSources_.push_back(bTags[iTag].first);
+        btagNames_.push_back("btag_" + suffix_ + bTags[iTag].first);
+      }
+    }
+  }
+  // Any jet closer than this to an object is in the cells scanned
+  const double jetSearchRadius = std::max(maxDeltaR_, 0.5);
+
   for (size_t i = 0; i < objects->size(); ++i) {
     // Make a copy that we own
     T object = objects->at(i);
     reco::Candidate::LorentzVector objectP4 = extractObjectP4(object);
-    // Find the closest jet
-    JetPtr closestJet;
+    double objectEta = objectP4.eta();
+    double objectPhi = objectP4.phi();
+    // Find the closest jet.  Look in the cells around the object first.
+    // Jets outside them are at least jetSearchRadius away, so only if none
+    // is closer do all the jets need to be checked (the jetDR and b-tags
+    // are stored for the closest jet at any distance).  The jets are
+    // checked in collection order in both cases, so ties are resolved the
+    // same way.
+    int closestIndex = -1;
     double closestDeltaR = std::numeric_limits<double>::infinity();
-    for (size_t j = 0; j < jets->size(); ++j) {
-      JetPtr jet = jets->ptrAt(j);
-      // Use the uncorrected P4. Embedded in the UncorrectedEmbedder module.
-      reco::CandidatePtr uncorrected = jet->userCand("uncorr");
-      assert(uncorrected.isNonnull());
-      reco::Candidate::LorentzVector jetP4 = uncorrected->p4();
-      double deltaR = reco::deltaR(objectP4, jetP4);
+    jetIndex_.neighbours(objectEta, objectPhi, jetSearchRadius, nearJets_);
+    for (size_t k = 0; k < nearJets_.size(); ++k) {
+      size_t j = nearJets_[k];
+      double deltaR = reco::deltaR(objectEta, objectPhi, jetEtas_[j], jetPhis_[j]);
       if (deltaR < closestDeltaR) {
         closestDeltaR = deltaR;
-        closestJet = jet;
+        closestIndex = j;
+      }
+    }
+    if (!(closestDeltaR < jetSearchRadius)) {
+      closestIndex = -1;
+      closestDeltaR = std::numeric_limits<double>::infinity();
+      for (size_t j = 0; j < jets->size(); ++j) {
+        double deltaR = reco::deltaR(objectEta, objectPhi, jetEtas_[j], jetPhis_[j]);
+        if (deltaR < closestDeltaR) {
+          closestDeltaR = deltaR;
+          closestIndex = j;
+        }
       }
     }
+    JetPtr closestJet;
+    if (closestIndex >= 0)
+      closestJet = jets->ptrAt(closestIndex);
+
     if (closestDeltaR > maxDeltaR_) {
       // Null jet
-      object.addUserCand("patJet" + suffix_, reco::CandidatePtr());
+      object.addUserCand(jetLabel_, reco::CandidatePtr());
       // The jet pt is just the object pt
       object.addUserFloat("jetPt", objectP4.pt());
     } else {
       // Null jet
-      object.addUserCand("patJet" + suffix_, closestJet);
+      object.addUserCand(jetLabel_, closestJet);
       // The jet pt is just the object pt
       object.addUserFloat("jetPt", closestJet->pt());
     }
@@ -114,9 +185,15 @@ void PATObjectJetInfoEmbedder<T>::produce(
       typedef std::pair<std::string, float> IdPair;
       typedef std::vector<IdPair> IdPairs;
       const IdPairs& bTags = closestJet->getPairDiscri();
+      if (bTags.size() != btagNames_.size()) {
+        throw cms::Exception("MismatchedBtags")
+          << "PATObjectJetInfoEmbedder: jet " << closestIndex << " in "
+          << jetSrc_ << " has " << bTags.size()
+          << " b-tag discriminators, but the first jet has "
+          << btagNames_.size() << std::endl;
+      }
       for (size_t iTag = 0; iTag < bTags.size(); ++iTag) {
-        std::string name = "btag_" + suffix_ + bTags[iTag].first;
-        object.addUserFloat(name, bTags[iTag].second);
+        object.addUserFloat(btagNames_[iTag], bTags[iTag].second);
       }
     }
     output->push_back(object);
@@ -12,8 +12,11 @@
 #include "RecoTauTag/RecoTau/interface/RecoTauQualityCuts.h"
 
 #include "FinalStateAnalysis/PatTools/interface/ParticlePFIsolationExtractor.h"
+#include "FinalStateAnalysis/PatTools/interface/PFCandidateIndex.h"
+#include "FinalStateAnalysis/DataAlgos/interface/EtaPhiIndex.h"
 
 #include <string>
+#include <algorithm>
 
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 
@@ -63,6 +66,10 @@ private:
   double minDeltaRtoNearestMuon_;
   StringCutObjectSelector<pat::Muon>* muonSelection_;
   edm::InputTag srcMuon_;
+  // Muons passing muonSelection, selected and indexed once per event
+  std::vector<const pat::Muon*> selectedMuons_;
+  EtaPhiIndex muonIndex_;
+  std::vector<size_t> nearMuons_;
 
   ek::ParticlePFIsolationExtractor<pat::Tau>* pfIsolationExtractor_;
   double maxPFIsoPt_;
@@ -71,6 +78,14 @@ private:
   edm::InputTag srcVertex_;
   edm::InputTag srcRhoFastJet_;
 
+  // JEC types for the jet kinematic selection, with their userInt labels
+  std::vector<std::string> correctionTypes_;
+  std::vector<std::string> crackLabels_;
+  std::vector<std::string> kinLabels_;
+  std::vector<std::string> selLabels_;
+  // PF candidates, indexed once per event for the isolation of all taus
+  PFCandidateIndex pfIsoCandidateIndex_;
+
   // special flag to add userFloats to all pat::Taus
   // without applying any selection cuts
   bool produceAll_;
@@ -117,6 +132,14 @@ PATTauPreselectionEmbedder::PATTauPreselectionEmbedder(const edm::ParameterSet&
     srcRhoFastJet_ = cfg.getParameter<edm::InputTag>("srcRhoFastJet");
   }
 
+  // Fuck the JEC for this tool
+  correctionTypes_.push_back("nom");
+  for ( size_t iCorr = 0; iCorr < correctionTypes_.size(); ++iCorr ) {
+    crackLabels_.push_back("ps_crk_" + correctionTypes_[iCorr]);
+    kinLabels_.push_back("ps_kin_" + correctionTypes_[iCorr]);
+    selLabels_.push_back("ps_sel_" + correctionTypes_[iCorr]);
+  }
+
   produces<PATTauCollection>();
 }
 
@@ -141,6 +164,7 @@ bool PATTauPreselectionEmbedder::filter(edm::Event& evt, const edm::EventSetup&
 
   edm::Handle<reco::PFCandidateCollection> pfIsoCandidates;
   evt.getByLabel(srcPFIsoCandidates_, pfIsoCandidates);
+  pfIsoCandidateIndex_.fill(*pfIsoCandidates);
 
   edm::Handle<reco::BeamSpot> beamSpot;
   evt.getByLabel(srcBeamSpot_, beamSpot);
@@ -156,11 +180,30 @@ bool PATTauPreselectionEmbedder::filter(edm::Event& evt, const edm::EventSetup&
   edm::Handle<PATMuonCollection> muons;
   evt.getByLabel(srcMuon_, muons);
 
+  // Apply the muon selection once, and index the selected muons, so each
+  // leading track is only compared to the muons around it
+  selectedMuons_.clear();
+  muonIndex_.clear();
+  for ( PATMuonCollection::const_iterator muon = muons->begin();
+	muon != muons->end(); ++muon ) {
+    if ( muonSelection_ == 0 || (*muonSelection_)(*muon) ) {
+      muonIndex_.insert(muon->p4().eta(), muon->p4().phi(), selectedMuons_.size());
+      selectedMuons_.push_back(&(*muon));
+    }
+  }
+  // Any muon closer than this to the leading track is in the cells scanned
+  const double muonSearchRadius = std::max(minDeltaRtoNearestMuon_, 0.5);
+
   edm::Handle<PATTauCollection> pfTaus_input;
   evt.getByLabel(src_, pfTaus_input);
 
   std::auto_ptr<PATTauCollection> pfTaus_output(new PATTauCollection());
 
+  // Filled on the first tau, the same for all of them
+  reco::VertexCollection theVertexCollection;
+
+  trackQualityCuts_->setPV(theVertex);
+
   for ( PATTauCollection::const_iterator pfTau_input = pfTaus_input->begin();
 	pfTau_input != pfTaus_input->end(); ++pfTau_input ) {
 
@@ -169,7 +212,6 @@ bool PATTauPreselectionEmbedder::filter(edm::Event& evt, const edm::EventSetup&
 
 //--- select PFChargedHadrons passing track quality cuts
 //    applied in PFTau reconstruction
-    trackQualityCuts_->setPV(theVertex);
     std::vector<reco::PFCandidatePtr> pfChargedJetConstituents = reco::tau::pfChargedCands(*pfJet);
     std::vector<reco::PFCandidatePtr> selPFChargedHadrons;
     for ( std::vector<reco::PFCandidatePtr>::const_iterator pfChargedJetConstituent = pfChargedJetConstituents.begin();
@@ -220,12 +262,11 @@ bool PATTauPreselectionEmbedder::filter(edm::Event& evt, const edm::EventSetup&
       passesAll = false;
 
 //--- require that (PF)Tau-jet candidate passes loose isolation criteria
-    reco::VertexCollection theVertexCollection;
-    theVertexCollection.push_back(*theVertex);
+    if ( theVertexCollection.empty() ) theVertexCollection.push_back(*theVertex);
     double loosePFIsoPt = -1.;
     if ( leadPFChargedHadron )
       loosePFIsoPt = (*pfIsolationExtractor_)(*pfTau_input, leadPFChargedHadron->momentum(),
-					      *pfIsoCandidates, &theVertexCollection, beamSpot.product(), rhoFastJet);
+					      pfIsoCandidateIndex_, &theVertexCollection, beamSpot.product(), rhoFastJet);
     if ( verbosity_ ) std::cout << " loosePFIsoPt = " << loosePFIsoPt << std::endl;
 
     pfTau_output.addUserFloat("ps_lsPFIsoPt", loosePFIsoPt);
@@ -252,12 +293,29 @@ bool PATTauPreselectionEmbedder::filter(edm::Event& evt, const edm::EventSetup&
     const pat::Muon* nearestMuon = 0;
     double dRnearestMuon = 1.e+3;
     if ( leadPFChargedHadron ) {
-      for ( PATMuonCollection::const_iterator muon = muons->begin();
-	    muon != muons->end(); ++muon ) {
-	if ( muonSelection_ == 0 || (*muonSelection_)(*muon) ) {
+      // Look in the cells around the leading track first.  Muons outside
+      // them are at least muonSearchRadius away, so only if none is closer
+      // do all the selected muons need to be checked.  The muons are
+      // checked in collection order in both cases, so ties are resolved the
+      // same way.
+      muonIndex_.neighbours(leadPFChargedHadron->p4().eta(), leadPFChargedHadron->p4().phi(),
+			    muonSearchRadius, nearMuons_);
+      for ( size_t iMuon = 0; iMuon < nearMuons_.size(); ++iMuon ) {
+	const pat::Muon* muon = selectedMuons_[nearMuons_[iMuon]];
+	double dR = deltaR(leadPFChargedHadron->p4(), muon->p4());
+	if ( dR < dRnearestMuon ) {
+	  nearestMuon = muon;
+	  dRnearestMuon = dR;
+	}
+      }
+      if ( !(dRnearestMuon < muonSearchRadius) ) {
+	nearestMuon = 0;
+	dRnearestMuon = 1.e+3;
+	for ( size_t iMuon = 0; iMuon < selectedMuons_.size(); ++iMuon ) {
+	  const pat::Muon* muon = selectedMuons_[iMuon];
 	  double dR = deltaR(leadPFChargedHadron->p4(), muon->p4());
 	  if ( dR < dRnearestMuon ) {
-	    nearestMuon = &(*muon);
+	    nearestMuon = muon;
 	    dRnearestMuon = dR;
 	  }
 	}
@@ -279,34 +337,31 @@ bool PATTauPreselectionEmbedder::filter(edm::Event& evt, const edm::EventSetup&
     if (isMuon)
       passesAll = false;
 
-    // Fuck the JEC for this tool
-    std::vector<std::string> correctionTypes;
-    correctionTypes.push_back("nom");
+    // The jet kinematics are the same for all the correction types
+    reco::Candidate::LorentzVector p4PFJetCorrected =
+      pfTau_input->userCand("patJet")->p4();
 
-    for (size_t iCorr = 0; iCorr < correctionTypes.size(); ++iCorr) {
+    bool isECALcrack = (TMath::Abs(p4PFJetCorrected.eta()) > 1.442 &&
+        TMath::Abs(p4PFJetCorrected.eta()) < 1.560);
 
-      bool systematicPassResult = passesAll;
+    //--- check that (PF)tau-jet candidate passes Pt and eta selection
+    bool passesKin = (p4PFJetCorrected.pt() > minJetPt_
+          && TMath::Abs(p4PFJetCorrected.eta()) < maxJetEta_);
 
-      const std::string& corrType = correctionTypes[iCorr];
-      reco::Candidate::LorentzVector p4PFJetCorrected =
-        pfTau_input->userCand("patJet")->p4();
+    for (size_t iCorr = 0; iCorr < correctionTypes_.size(); ++iCorr) {
 
-      bool isECALcrack = (TMath::Abs(p4PFJetCorrected.eta()) > 1.442 &&
-          TMath::Abs(p4PFJetCorrected.eta()) < 1.560);
+      bool systematicPassResult = passesAll;
 
-      pfTau_output.addUserInt("ps_crk_" + corrType, isECALcrack);
+      pfTau_output.addUserInt(crackLabels_[iCorr], isECALcrack);
       if (applyECALcrackVeto_ && isECALcrack)
         systematicPassResult = false;
 
-      //--- check that (PF)tau-jet candidate passes Pt and eta selection
-      bool passesKin = (p4PFJetCorrected.pt() > minJetPt_
-            && TMath::Abs(p4PFJetCorrected.eta()) < maxJetEta_);
-      pfTau_output.addUserInt("ps_kin_" + corrType, passesKin);
+      pfTau_output.addUserInt(kinLabels_[iCorr], passesKin);
       if (!passesKin) {
         systematicPassResult = false;
       }
       // Final result for this systematic
-      pfTau_output.addUserInt("ps_sel_" + corrType, systematicPassResult);
+      pfTau_output.addUserInt(selLabels_[iCorr], systematicPassResult);
     }
 //--- all cuts passed
 //   --> create selected (PF)tau-jet candidate
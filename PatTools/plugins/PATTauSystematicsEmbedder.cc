@@ -9,6 +9,8 @@
 #include "DataFormats/PatCandidates/interface/Tau.h"
 #include "DataFormats/Candidate/interface/LeafCandidate.h"
 
+#include "FinalStateAnalysis/DataFormats/interface/PATObjectShifts.h"
+
 #include "JetMETCorrections/Objects/interface/JetCorrector.h"
 #include "JetMETCorrections/Objects/interface/JetCorrectionsRecord.h"
 #include "CondFormats/JetMETObjects/interface/JetCorrectorParameters.h"
@@ -131,6 +133,8 @@ class PATTauSystematicsEmbedder : public edm::EDProducer {
     void produce(edm::Event& evt, const edm::EventSetup& es);
   private:
     edm::InputTag src_;
+    // Store the shifts in a single PATObjectShifts
+    bool compact_;
     CorrectorFromDB tauJetCorrection_;
 };
 
@@ -139,13 +143,18 @@ PATTauSystematicsEmbedder::PATTauSystematicsEmbedder(
   tauJetCorrection_(pset.getParameterSet("tauEnergyScale"))
 {
   src_ = pset.getParameter<edm::InputTag>("src");
+  compact_ = pset.exists("compact") ? pset.getParameter<bool>("compact") : false;
 
-  // Produce the (corrected) nominal p4 collections for the jet and taus
-  produces<ShiftedCandCollection>("p4OutNomTaus");
+  if (compact_) {
+    produces<PATObjectShifts>("shifts");
+  } else {
+    // Produce the (corrected) nominal p4 collections for the jet and taus
+    produces<ShiftedCandCollection>("p4OutNomTaus");
 
-  // TES affects the tau
-  produces<ShiftedCandCollection>("p4OutTESUpTaus");
-  produces<ShiftedCandCollection>("p4OutTESDownTaus");
+    // TES affects the tau
+    produces<ShiftedCandCollection>("p4OutTESUpTaus");
+    produces<ShiftedCandCollection>("p4OutTESDownTaus");
+  }
 
   produces<pat::TauCollection>();
 }
@@ -165,19 +174,37 @@ void PATTauSystematicsEmbedder::produce(edm::Event& evt, const edm::EventSetup&
   std::auto_ptr<ShiftedCandCollection> p4OutTESUpTaus(new ShiftedCandCollection);
   std::auto_ptr<ShiftedCandCollection> p4OutTESDownTaus(new ShiftedCandCollection);
 
-  p4OutNomTaus->reserve(nTaus);
-  p4OutTESUpTaus->reserve(nTaus);
-  p4OutTESDownTaus->reserve(nTaus);
+  std::auto_ptr<PATObjectShifts> shifts;
+  if (compact_) {
+    std::vector<std::string> names;
+    names.push_back("uncorr");
+    names.push_back("tes+");
+    names.push_back("tes-");
+    shifts.reset(new PATObjectShifts(names, nTaus));
+  } else {
+    p4OutNomTaus->reserve(nTaus);
+    p4OutTESUpTaus->reserve(nTaus);
+    p4OutTESDownTaus->reserve(nTaus);
+  }
 
+  // The shifts are computed once, and stored either way
   for (size_t i = 0; i < nTaus; ++i) {
     const pat::Tau& origTau = taus->at(i);
     output->push_back(origTau); // make our own copy
-    ShiftedCand p4OutNomTau(origTau);
-    p4OutNomTaus->push_back(p4OutNomTau);
-    // Now make the smeared versions of the jets and taus
     // TES uncertainty
     ShiftedLorentzVectors tesShifts = tauJetCorrection_.uncertainties(
-        p4OutNomTau.p4());
+        origTau.p4());
+
+    if (compact_) {
+      shifts->setP4(i, 0, origTau.p4());
+      shifts->setP4(i, 1, tesShifts.shiftedUp);
+      shifts->setP4(i, 2, tesShifts.shiftedDown);
+      continue;
+    }
+
+    ShiftedCand p4OutNomTau(origTau);
+    p4OutNomTaus->push_back(p4OutNomTau);
+
     ShiftedCand p4OutTESUpTau(p4OutNomTau);
     p4OutTESUpTau.setP4(tesShifts.shiftedUp);
     p4OutTESUpTaus->push_back(p4OutTESUpTau);
@@ -187,6 +214,14 @@ void PATTauSystematicsEmbedder::produce(edm::Event& evt, const edm::EventSetup&
     p4OutTESDownTaus->push_back(p4OutTESDownTau);
   }
 
+  if (compact_) {
+    edm::RefProd<PATObjectShifts> shiftsRef(evt.put(shifts, "shifts"));
+    for (size_t i = 0; i < output->size(); ++i)
+      PATObjectShifts::link(output->at(i), shiftsRef, i);
+    evt.put(output);
+    return;
+  }
+
   // Put the shifted collections in the event
   typedef edm::OrphanHandle<ShiftedCandCollection> PutHandle;
 
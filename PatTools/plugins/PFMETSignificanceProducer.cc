@@ -25,6 +25,8 @@ class PFMETSignificanceProducer : public edm::EDProducer {
     typedef std::vector<edm::InputTag> vInputTag;
     vInputTag src_;
     PFMEtSignInterfaceBase pfMEtSignInterface_;
+    // The input candidates, reused between events
+    std::vector<const reco::Candidate*> particles_;
 };
 
 PFMETSignificanceProducer::PFMETSignificanceProducer(const edm::ParameterSet& pset)
@@ -35,14 +37,15 @@ PFMETSignificanceProducer::PFMETSignificanceProducer(const edm::ParameterSet& ps
 
 void PFMETSignificanceProducer::produce(edm::Event& evt, const edm::EventSetup& es) {
 
-  std::list<const reco::Candidate*> particles;
+  particles_.clear();
   for ( vInputTag::const_iterator src_i = src_.begin();
 	src_i != src_.end(); ++src_i ) {
     edm::Handle<reco::CandidateView> particles_i;
     evt.getByLabel(*src_i, particles_i);
+    particles_.reserve(particles_.size() + particles_i->size());
     for ( reco::CandidateView::const_iterator particle = particles_i->begin();
 	  particle != particles_i->end(); ++particle ) {
-      particles.push_back(&(*particle));
+      particles_.push_back(&(*particle));
     }
   }
 
@@ -51,12 +54,7 @@ void PFMETSignificanceProducer::produce(edm::Event& evt, const edm::EventSetup&
   // Very rarely there can be a singularity error which throws
   // and exception.
   try {
-    TMatrixD result_tm = pfMEtSignInterface_(particles);
-
-    (*output)(0,0) = result_tm(0, 0);
-    (*output)(1,0) = result_tm(1, 0);
-    (*output)(0,1) = result_tm(0, 1);
-    (*output)(1,1) = result_tm(1, 1);
+    *output = pfMEtSignInterface_(particles_);
   } catch (...) {
     edm::LogError("BadPFMETMatrix")
       << "Caught an exception computing PFMET signif. matrix"
@@ -21,16 +21,22 @@
 #include "DataFormats/HLTReco/interface/TriggerRefsCollections.h"
 #include "DataFormats/HLTReco/interface/TriggerObject.h"
 
+#include "FinalStateAnalysis/DataAlgos/interface/EtaPhiIndex.h"
+
 // class decleration
 //
 template <typename T>
 class MyTriggerMatcher : public edm::EDProducer {
   public:
+    typedef reco::Candidate::LorentzVector LV;
+
     explicit MyTriggerMatcher (const edm::ParameterSet& iConfig):
       src_(iConfig.getParameter<edm::InputTag>("src")),
       triggerEvent_(iConfig.getParameter<edm::InputTag>("trigEvent")),
       filters_(iConfig.getParameter<std::vector<edm::InputTag> >("filters")),
-      pdgId_(iConfig.getParameter<int>("pdgId")) {
+      pdgId_(iConfig.getParameter<int>("pdgId")),
+      trigObjects_(filters_.size()),
+      indices_(filters_.size()) {
         produces<std::vector<T> >();
       }
     ~MyTriggerMatcher () { }
@@ -40,8 +46,6 @@ class MyTriggerMatcher : public edm::EDProducer {
       using namespace reco;
       using namespace trigger;
 
-      typedef reco::Candidate::LorentzVector LV;
-
       //Read the shallow clones of a candidate and save the SECOND Clone
       std::auto_ptr<std::vector<T> > out(new std::vector<T> );
       edm::Handle<std::vector<T> > src;
@@ -52,45 +56,50 @@ class MyTriggerMatcher : public edm::EDProducer {
       /*  	  for(unsigned int i=0;i<trigEv->sizeFilters();++i)  */
       /*  	    printf("%s\n",trigEv->filterTag(i).label().c_str());   */
 
-      if(iEvent.getByLabel(src_,src))
+      if(iEvent.getByLabel(src_,src)) {
+        // Extract the objects of each filter once per event
+        for(unsigned int f=0;f<filters_.size();++f) {
+          size_t INDEX =trigEv->filterIndex(filters_[f]);
+          getFilterCollection(INDEX,pdgId_,*trigEv,trigObjects_[f]);
+          indices_[f].fill(trigObjects_[f]);
+        }
+
+        out->reserve(src->size());
         for(unsigned int i=0;i<src->size();++i) {
-          T obj = src->at(i);
+          out->push_back(src->at(i));
+          T& obj = out->back();
 
           //loop the filters
-          for(unsigned int i=0;i<filters_.size();++i) {
-            size_t INDEX =trigEv->filterIndex(filters_[i]);
-
-            std::vector<LV> trigObjects = getFilterCollection(INDEX,pdgId_,*trigEv);
+          for(unsigned int f=0;f<filters_.size();++f) {
+            const std::vector<LV>& trigObjects = trigObjects_[f];
             bool match = false;
 
-            for(unsigned int j=0;j<trigObjects.size();++j)
-              if(deltaR(trigObjects.at(j),obj)<0.5) {
+            // Only the trigger objects in the nearby cells can match
+            indices_[f].neighbours(obj.eta(),obj.phi(),0.5,nearby_);
+            for(unsigned int j=0;j<nearby_.size();++j)
+              if(deltaR(trigObjects[nearby_[j]],obj)<0.5) {
                 match=true;
                 break;
               }
 
-            // only embed if there are trigger objects
-            if (true || trigObjects.size()) {
-              if(match)
-                obj.addUserFloat(filters_[i].label(),1.0);
-              else
-                obj.addUserFloat(filters_[i].label(),0.0);
-            }
+            if(match)
+              obj.addUserFloat(filters_[f].label(),1.0);
+            else
+              obj.addUserFloat(filters_[f].label(),0.0);
           }
-
-          out->push_back(obj);
         }
+      }
 
       iEvent.put(out);
     }
 
     virtual void endJob() { }
 
-    std::vector<reco::Candidate::LorentzVector>
-      getFilterCollection(size_t index,int id,const trigger::TriggerEvent& trigEv)
+    // Fill [out] with the objects of filter [index] with |pdgId| == [id]
+    void getFilterCollection(size_t index,int id,
+        const trigger::TriggerEvent& trigEv,std::vector<LV>& out)
       {
-        //Create output Collection
-        std::vector<reco::Candidate::LorentzVector>  out;
+        out.clear();
         //get All the final trigger objects
         const trigger::TriggerObjectCollection& TOC(trigEv.getObjects());
         //filter index
@@ -101,17 +110,19 @@ class MyTriggerMatcher : public edm::EDProducer {
           for(size_t i = 0;i<KEYS.size();++i)
           {
             const trigger::TriggerObject& TO(TOC[KEYS[i]]);
-            reco::Candidate::LorentzVector a(TO.px(),TO.py(),TO.pz(),sqrt(TO.px()*TO.px()+TO.py()*TO.py()+TO.pz()*TO.pz()));
             if(abs(TO.id()) == id)
-              out.push_back(a);
+              out.push_back(LV(TO.px(),TO.py(),TO.pz(),sqrt(TO.px()*TO.px()+TO.py()*TO.py()+TO.pz()*TO.pz())));
           }
         }
-
-        return out;
       }
 
     edm::InputTag src_;
     edm::InputTag triggerEvent_;
     std::vector<edm::InputTag> filters_;
     int pdgId_;
+
+    // Per-event trigger objects of each filter, and their eta-phi indices
+    std::vector<std::vector<LV> > trigObjects_;
+    std::vector<EtaPhiIndex> indices_;
+    std::vector<size_t> nearby_;
 };
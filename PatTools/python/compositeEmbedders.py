@@ -0,0 +1,128 @@
+'''
+
+Fuse chains of PAT object embedders into composite embedders.
+
+Each embedder plugin normally copies the full input collection.  The
+PAT<Object>CompositeEmbedder plugins run several embedders over a single copy.
+
+fuse_embedders(process, sequence) replaces each run of consecutive fusable
+embedders in [sequence] with a single composite embedder.  It must be called
+before the sequence is chained with chain_sequence.
+
+NB that the composite embedders look up value maps with refs to their input
+collection.  A value map embedder is keyed to its own src, which is the
+input of the composite only if it is the first embedder of the run, so it
+always starts a new run.  (The composite also checks the keys of the maps
+when it runs.)
+
+'''
+
+import FWCore.ParameterSet.Config as cms
+
+# Map of the fusable plugins to the composite plugin that can run them
+_composite_for = {
+    'MuonRhoOverloader': 'PATMuonCompositeEmbedder',
+    'PATMuonValueMapEmbedder': 'PATMuonCompositeEmbedder',
+    'PATMuonIpEmbedder': 'PATMuonCompositeEmbedder',
+    'PATMuonIdEmbedder': 'PATMuonCompositeEmbedder',
+    'PATMuonEAEmbedder': 'PATMuonCompositeEmbedder',
+    'ElectronRhoOverloader': 'PATElectronCompositeEmbedder',
+    'PATElectronValueMapEmbedder': 'PATElectronCompositeEmbedder',
+    'PATElectronIpEmbedder': 'PATElectronCompositeEmbedder',
+    'TauRhoOverloader': 'PATTauCompositeEmbedder',
+    'PATTauValueMapEmbedder': 'PATTauCompositeEmbedder',
+    'PATTauIpEmbedder': 'PATTauCompositeEmbedder',
+    'PhotonRhoOverloader': 'PATPhotonCompositeEmbedder',
+    'PATJetValueMapEmbedder': 'PATJetCompositeEmbedder',
+    'PATJetIdEmbedder': 'PATJetCompositeEmbedder',
+    'PATJetPUIDEmbedder': 'PATJetCompositeEmbedder',
+}
+
+# The fusable plugins which look up value maps keyed to their src
+_keyed_to_src = set([
+    'PATMuonValueMapEmbedder',
+    'PATElectronValueMapEmbedder',
+    'PATTauValueMapEmbedder',
+    'PATJetValueMapEmbedder',
+])
+
+
+def make_composite(*embedders):
+    ''' Build a composite embedder which runs [embedders] in order
+
+    The src of the composite is the src of the first embedder, so only the
+    first embedder can use value maps keyed to its src.
+    '''
+    composite_type = _composite_for[embedders[0].type_()]
+    for embedder in embedders[1:]:
+        if embedder.type_() in _keyed_to_src:
+            raise ValueError("Can't fuse %s after another embedder: its value "
+                             "maps are keyed to its own src" % embedder.type_())
+    output = cms.EDProducer(
+        composite_type,
+        src=embedders[0].src,
+        embedders=cms.VPSet()
+    )
+    for embedder in embedders:
+        if _composite_for[embedder.type_()] != composite_type:
+            raise ValueError("Can't fuse %s into a %s" %
+                             (embedder.type_(), composite_type))
+        pset = cms.PSet(type=cms.string(embedder.type_()))
+        for name in embedder.parameterNames_():
+            if name == 'src':
+                continue
+            setattr(pset, name, getattr(embedder, name))
+        output.embedders.append(pset)
+    return output
+
+
+class _ModuleCollector(object):
+    def __init__(self):
+        self.modules = []
+    def enter(self, visitee):
+        if isinstance(visitee, cms.EDProducer) or \
+           isinstance(visitee, cms.EDFilter):
+            self.modules.append(visitee)
+    def leave(self, visitee):
+        pass
+
+
+def _fusable(module):
+    skip = hasattr(module, 'noSeqChain') and module.noSeqChain
+    return not skip and module.type_() in _composite_for
+
+
+def fuse_embedders(process, sequence):
+    ''' Replace runs of fusable embedders in [sequence] with composites
+
+    The composite takes the label of the first embedder in the run, with
+    "Composite" appended.  Returns the labels of the composites.
+    '''
+    collector = _ModuleCollector()
+    sequence.visit(collector)
+
+    runs = []
+    current = []
+    for module in collector.modules:
+        if _fusable(module) and (
+            not current or (
+                module.type_() not in _keyed_to_src and
+                _composite_for[module.type_()] ==
+                _composite_for[current[0].type_()])):
+            current.append(module)
+            continue
+        runs.append(current)
+        current = [module] if _fusable(module) else []
+    runs.append(current)
+
+    labels = []
+    for run in runs:
+        if len(run) < 2:
+            continue
+        label = run[0].label() + 'Composite'
+        setattr(process, label, make_composite(*run))
+        sequence.replace(run[0], getattr(process, label))
+        for module in run[1:]:
+            sequence.remove(module)
+        labels.append(label)
+    return labels
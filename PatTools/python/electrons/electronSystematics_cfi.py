@@ -6,4 +6,6 @@ electronSystematics = cms.EDProducer(
     nominal = cms.double(1.0),
     eScaleUp = cms.double(1.06),
     eScaleDown = cms.double(0.94),
+    # Store the shifts in a single PATObjectShifts instead of userCands
+    compact = cms.bool(False),
 )
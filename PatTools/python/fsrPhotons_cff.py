@@ -5,7 +5,13 @@ import FWCore.ParameterSet.Config as cms
 ## PF Photons
 fsrPhotonCands = cms.EDProducer(
     "FSRPhotonProducer",
-    src = cms.InputTag("particleFlow")
+    src = cms.InputTag("particleFlow"),
+    # Only keep photons near a lepton.  The cone is a bit larger than the 0.5
+    # used to assign FSR, as the lepton directions can change in the
+    # corrections applied later.  This also restricts boostedFsrPhotons in
+    # the PAT tuples to these photons; remove leptonSrcs to keep them all.
+    leptonSrcs = cms.VInputTag("muons", "gsfElectrons"),
+    maxDeltaR = cms.double(0.6),
 )
 
 # http://cmssw.cvs.cern.ch/cgi-bin/cmssw.cgi/UserCode/Mangano/WWAnalysis/Tools/python/fsrPhotons_cff.py?revision=1.2&view=markup
@@ -73,7 +79,8 @@ boostedFsrPhotons = cms.EDProducer("PATPFParticleProducerUser",
             ),
         # add candidate ptrs here
         userCands = cms.PSet(
-            src = cms.VInputTag('')
+            src = cms.VInputTag(
+                cms.InputTag("fsrPhotonCands", "nearestLepton"))
             ),
         # add "inline" functions here
         userFunctions = cms.vstring(),
@@ -101,6 +108,7 @@ boostedFsrPhotons.userData.userFloats.src = cms.VInputTag(
     cms.InputTag("fsrPhotonPFIsoPhoton03"),
     cms.InputTag("fsrPhotonPFIsoChHadPU03"),
     cms.InputTag("fsrPhotonPFIsoChHadPU03pt02"),
+    cms.InputTag("fsrPhotonCands", "nearestLeptonDR"),
 )
 
 fsrPhotonSequence = cms.Sequence(
@@ -5,4 +5,6 @@ patJetEmbedSystematics = cms.EDProducer(
     src = cms.InputTag("fixme"),
     corrLabel = cms.string("AK5PF"),
     unclusteredEnergyScale = cms.double(0.1),
+    # Store the shifts in a single PATObjectShifts instead of userCands
+    compact = cms.bool(False),
 )
@@ -27,4 +27,6 @@ systematicsMET = cms.EDProducer(
     applyType1ForElectrons = cms.bool(False),
     applyType1ForJets = cms.bool(True),
     applyType2ForJets = cms.bool(False),
+    # Embed all the variations in the MET instead of a collection for each
+    compact = cms.bool(False),
 )
@@ -13,6 +13,12 @@ Arguments:
     noTracks : if true, remove stuff that depends on the tracks
     buildFSAEvent : whether or not to build the FSA event object (if not,
                     it must already be in the event)
+    associateFinalStates : if true, the embedders store their results in
+                    associations to the raw final states, which are folded
+                    into a single copy by the final PATFinalStateCopier
+    compactFinalStates : if true, store the final states in the compact
+                    (columnar) PATCompactFinalStateCollection format instead
+                    of the full PATFinalStateCollection
 
 Author Evan K. Friis, UW Madison
 
@@ -20,6 +26,7 @@ Author Evan K. Friis, UW Madison
 
 import FWCore.ParameterSet.Config as cms
 from FinalStateAnalysis.Utilities.cfgtools import chain_sequence
+from FinalStateAnalysis.Utilities.cfgtools import associate_sequence
 import PhysicsTools.PatAlgos.tools.helpers as helpers
 import itertools
 
@@ -41,10 +48,44 @@ def _combinatorics(items, n):
         yield tuple(items[x] for x in index_set)
 
 
+def _final_copier(embedder_seq, producer_name, associate):
+    ''' Build the PATFinalStateCopier at the end of the embedder chain '''
+    if associate:
+        associations = associate_sequence(embedder_seq, producer_name + "Raw")
+        return cms.EDProducer(
+            "PATFinalStateCopier",
+            src=cms.InputTag(producer_name + "Raw"),
+            associations=associations)
+    final_module_name = chain_sequence(embedder_seq, producer_name + "Raw")
+    return cms.EDProducer("PATFinalStateCopier", src=final_module_name)
+
+
+def _add_output(process, sequence, producer_name, n_legs, output_commands,
+                compact):
+    ''' Keep the final states built by [producer_name]
+
+    If [compact] is set, the final states are converted to a
+    PATCompactFinalStateCollection and only that product is kept.
+    '''
+    if not compact:
+        output_commands.append("*_%s_*_*" % producer_name)
+        return
+    compactor = cms.EDProducer(
+        "PATFinalStateCompactor",
+        src=cms.InputTag(producer_name),
+        evtSrc=cms.InputTag("patFinalStateEventProducer"),
+        nLegs=cms.uint32(n_legs),
+    )
+    setattr(process, producer_name + "Compact", compactor)
+    sequence += compactor
+    output_commands.append("*_%sCompact_*_*" % producer_name)
+
+
 def produce_final_states(process, collections, output_commands,
                          sequence, puTag, buildFSAEvent=True,
                          noTracks=False, noPhotons=False, zzMode=False,
-                         rochCor="", eleCor=""):
+                         rochCor="", eleCor="", associateFinalStates=False,
+                         compactFinalStates=False):
 
     muonsrc = collections['muons']
     esrc = collections['electrons']
@@ -276,13 +317,13 @@ def produce_final_states(process, collections, output_commands,
             process, process.patFinalStatesEmbedObjects, producer_name)
         process.buildDiObjects += embedder_seq
         # Do some trickery so the final module has a nice output name
-        final_module_name = chain_sequence(embedder_seq, producer_name + "Raw")
-        final_module = cms.EDProducer(
-            "PATFinalStateCopier", src=final_module_name)
+        final_module = _final_copier(embedder_seq, producer_name,
+                                     associateFinalStates)
         setattr(process, producer_name, final_module)
         process.buildDiObjects += final_module
         setattr(process, producer_name, final_module)
-        output_commands.append("*_%s_*_*" % producer_name)
+        _add_output(process, process.buildDiObjects, producer_name, 2,
+                    output_commands, compactFinalStates)
     sequence += process.buildDiObjects
 
     # Build tri-lepton pairs
@@ -331,12 +372,12 @@ def produce_final_states(process, collections, output_commands,
             process, process.patFinalStatesEmbedObjects, producer_name)
         process.buildTriObjects += embedder_seq
         # Do some trickery so the final module has a nice output name
-        final_module_name = chain_sequence(embedder_seq, producer_name + "Raw")
-        final_module = cms.EDProducer(
-            "PATFinalStateCopier", src=final_module_name)
+        final_module = _final_copier(embedder_seq, producer_name,
+                                     associateFinalStates)
         setattr(process, producer_name, final_module)
         process.buildTriObjects += final_module
-        output_commands.append("*_%s_*_*" % producer_name)
+        _add_output(process, process.buildTriObjects, producer_name, 3,
+                    output_commands, compactFinalStates)
     sequence += process.buildTriObjects
 
     # Build 4 lepton final states
@@ -384,12 +425,12 @@ def produce_final_states(process, collections, output_commands,
             process, process.patFinalStatesEmbedObjects, producer_name)
         process.buildQuadObjects += embedder_seq
         # Do some trickery so the final module has a nice output name
-        final_module_name = chain_sequence(embedder_seq, producer_name + "Raw")
-        final_module = cms.EDProducer(
-            "PATFinalStateCopier", src=final_module_name)
+        final_module = _final_copier(embedder_seq, producer_name,
+                                     associateFinalStates)
         setattr(process, producer_name, final_module)
         process.buildQuadObjects += final_module
-        output_commands.append("*_%s_*_*" % producer_name)
+        _add_output(process, process.buildQuadObjects, producer_name, 4,
+                    output_commands, compactFinalStates)
     sequence += process.buildQuadObjects
 
     # Build 4 lepton final states w/ FSR
@@ -439,13 +480,13 @@ def produce_final_states(process, collections, output_commands,
             process.buildQuadHzzObjects += embedder_seq
 
             # Do some trickery so the final module has a nice output name
-            final_module_name = chain_sequence(embedder_seq, producer_name + "Raw")
-            final_module = cms.EDProducer(
-                "PATFinalStateCopier", src=final_module_name)
+            final_module = _final_copier(embedder_seq, producer_name,
+                                         associateFinalStates)
 
             setattr(process, producer_name, final_module)
             process.buildQuadHzzObjects += final_module
-            output_commands.append("*_%s_*_*" % producer_name)
+            _add_output(process, process.buildQuadHzzObjects, producer_name,
+                        4, output_commands, compactFinalStates)
 
         sequence += process.buildQuadHzzObjects
 
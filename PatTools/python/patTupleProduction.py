@@ -38,9 +38,14 @@ from FinalStateAnalysis.PatTools.pfIsolationTools import setup_h2tau_iso,\
 from FinalStateAnalysis.PatTools.patFinalStateProducers import \
     produce_final_states
 from FinalStateAnalysis.PatTools.fsaRandomSeeds import add_fsa_random_seeds
+from FinalStateAnalysis.PatTools.compositeEmbedders import fuse_embedders
 
 
 def configurePatTuple(process, isMC=True, **kwargs):
+    # If true, run consecutive embedders in the object sequences on a single
+    # copy of each collection.
+    fuse = kwargs.get('fuseEmbedders', False)
+
     # Stuff we always keep
     output_commands = [
         '*_addPileupInfo_*_*',
@@ -299,6 +304,8 @@ def configurePatTuple(process, isMC=True, **kwargs):
     process.load("FinalStateAnalysis.PatTools.patJetProduction_cff")
     process.patJetGarbageRemoval.cut = 'pt > 12'
 
+    if fuse:
+        fuse_embedders(process, process.customizeJetSequence)
     final_jet_collection = chain_sequence(
         process.customizeJetSequence, "patJets")
     process.customizeJetSequence.insert(0, process.patJets)
@@ -340,6 +347,8 @@ def configurePatTuple(process, isMC=True, **kwargs):
         process.calibratedPatElectrons.isMC = cms.bool(isMC == 1)
         process.calibratedPatElectrons.verbose = cms.bool(False)
 
+    if fuse:
+        fuse_embedders(process, process.customizeElectronSequence)
     final_electron_collection = chain_sequence(
         process.customizeElectronSequence, "selectedPatElectrons",
         # Some of the EGamma modules have non-standard src InputTags,
@@ -358,6 +367,8 @@ def configurePatTuple(process, isMC=True, **kwargs):
     process.cleanPatElectrons.src = final_electron_collection
 
     process.load("FinalStateAnalysis.PatTools.patMuonProduction_cff")
+    if fuse:
+        fuse_embedders(process, process.customizeMuonSequence)
     final_muon_collection = chain_sequence(
         process.customizeMuonSequence, "selectedPatMuons")
     process.customizeMuonSequence.insert(0, process.selectedPatMuons)
@@ -370,6 +381,8 @@ def configurePatTuple(process, isMC=True, **kwargs):
     # Require all taus to pass decay mode finding and have high PT
     process.patTauGarbageRemoval.cut = cms.string(
         "pt > 17 && abs(eta) < 2.5 && tauID('decayModeFinding')")
+    if fuse:
+        fuse_embedders(process, process.customizeTauSequence)
     final_tau_collection = chain_sequence(
         process.customizeTauSequence, "selectedPatTaus")
     # Inject into the pat sequence
@@ -386,6 +399,8 @@ def configurePatTuple(process, isMC=True, **kwargs):
 
     # Setup pat::Photon Production
     process.load("FinalStateAnalysis.PatTools.patPhotonProduction_cff")
+    if fuse:
+        fuse_embedders(process, process.customizePhotonSequence)
     final_photon_collection = chain_sequence(process.customizePhotonSequence,
                                              "selectedPatPhotons")
     #setup PHOSPHOR for a specific dataset
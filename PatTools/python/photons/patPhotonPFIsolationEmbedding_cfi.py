@@ -7,5 +7,8 @@ patPhotonPFIsolation = cms.EDProducer(
     vtxSrc = cms.InputTag("offlinePrimaryVertices"),
     defaultVertex = cms.uint32(0), #set vertex embedded as default iso    
     userFloatPrefix = cms.string("pf"),
-    coneSize = cms.double(0.3)
+    coneSize = cms.double(0.3),
+    # only give the PF candidates within this dR of the photon to the
+    # isolation; must cover the cone w.r.t. any vertex.  0 = use all (off)
+    pfPreselectionRadius = cms.double(0.0)
 )
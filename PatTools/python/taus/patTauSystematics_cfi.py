@@ -11,5 +11,7 @@ systematicsTaus = cms.EDProducer(
         uncTag = cms.string("Uncertainty"),
         flavorUncertainty = cms.double(0),
     ),
+    # Store the shifts in a single PATObjectShifts instead of userCands
+    compact = cms.bool(False),
 )
 
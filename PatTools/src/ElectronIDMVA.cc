@@ -58,57 +58,66 @@ void ElectronIDMVA::Initialize( std::string methodName,
 
   fMethodname = methodName;
 
+  fVariableNames.clear();
+  fVariables.clear();
+  if (type == kBaseline) {
+    AddVariable( "SigmaIEtaIEta",         &fMVAVar_EleSigmaIEtaIEta         );
+    AddVariable( "DEtaIn",                &fMVAVar_EleDEtaIn                );
+    AddVariable( "DPhiIn",                &fMVAVar_EleDPhiIn                );
+    AddVariable( "FBrem",                 &fMVAVar_EleFBrem                 );
+    AddVariable( "SigmaIPhiIPhi",         &fMVAVar_EleSigmaIPhiIPhi         );
+    AddVariable( "NBrem",                 &fMVAVar_EleNBrem                 );
+    AddVariable( "OneOverEMinusOneOverP", &fMVAVar_EleOneOverEMinusOneOverP );
+  }
+
+  if (type == kNoIPInfo) {
+    AddVariable( "SigmaIEtaIEta",         &fMVAVar_EleSigmaIEtaIEta         );
+    AddVariable( "DEtaIn",                &fMVAVar_EleDEtaIn                );
+    AddVariable( "DPhiIn",                &fMVAVar_EleDPhiIn                );
+    AddVariable( "FBrem",                 &fMVAVar_EleFBrem                 );
+    AddVariable( "EOverP",                &fMVAVar_EleEOverP                );
+    AddVariable( "ESeedClusterOverPout",  &fMVAVar_EleESeedClusterOverPout  );
+    AddVariable( "SigmaIPhiIPhi",         &fMVAVar_EleSigmaIPhiIPhi         );
+    AddVariable( "NBrem",                 &fMVAVar_EleNBrem                 );
+    AddVariable( "OneOverEMinusOneOverP", &fMVAVar_EleOneOverEMinusOneOverP );
+    AddVariable( "ESeedClusterOverPIn",   &fMVAVar_EleESeedClusterOverPIn   );
+  }
+  if (type == kWithIPInfo) {
+    AddVariable( "SigmaIEtaIEta",         &fMVAVar_EleSigmaIEtaIEta         );
+    AddVariable( "DEtaIn",                &fMVAVar_EleDEtaIn                );
+    AddVariable( "DPhiIn",                &fMVAVar_EleDPhiIn                );
+    AddVariable( "D0",                    &fMVAVar_EleD0                    );
+    AddVariable( "FBrem",                 &fMVAVar_EleFBrem                 );
+    AddVariable( "EOverP",                &fMVAVar_EleEOverP                );
+    AddVariable( "ESeedClusterOverPout",  &fMVAVar_EleESeedClusterOverPout  );
+    AddVariable( "SigmaIPhiIPhi",         &fMVAVar_EleSigmaIPhiIPhi         );
+    AddVariable( "NBrem",                 &fMVAVar_EleNBrem                 );
+    AddVariable( "OneOverEMinusOneOverP", &fMVAVar_EleOneOverEMinusOneOverP );
+    AddVariable( "ESeedClusterOverPIn",   &fMVAVar_EleESeedClusterOverPIn   );
+    AddVariable( "IP3d",                  &fMVAVar_EleIP3d                  );
+    AddVariable( "IP3dSig",               &fMVAVar_EleIP3dSig               );
+  }
+  fInputs.resize(fVariables.size());
+
+  std::string weights[6] = {
+    Subdet0Pt10To20Weights, Subdet1Pt10To20Weights, Subdet2Pt10To20Weights,
+    Subdet0Pt20ToInfWeights, Subdet1Pt20ToInfWeights, Subdet2Pt20ToInfWeights
+  };
+
   for(UInt_t i=0; i<6; ++i) {
     if (fTMVAReader[i]) delete fTMVAReader[i];
+    fTMVAReader[i] = 0;
+
+    // Use the native evaluator when it supports the weight file
+    if (fForest[i].load(weights[i], fVariableNames))
+      continue;
 
     fTMVAReader[i] = new TMVA::Reader( "!Color:Silent:Error" );
     fTMVAReader[i]->SetVerbose(kTRUE);
-
-    if (type == kBaseline) {
-      fTMVAReader[i]->AddVariable( "SigmaIEtaIEta",         &fMVAVar_EleSigmaIEtaIEta         );
-      fTMVAReader[i]->AddVariable( "DEtaIn",                &fMVAVar_EleDEtaIn                );
-      fTMVAReader[i]->AddVariable( "DPhiIn",                &fMVAVar_EleDPhiIn                );
-      fTMVAReader[i]->AddVariable( "FBrem",                 &fMVAVar_EleFBrem                 );
-      fTMVAReader[i]->AddVariable( "SigmaIPhiIPhi",         &fMVAVar_EleSigmaIPhiIPhi         );
-      fTMVAReader[i]->AddVariable( "NBrem",                 &fMVAVar_EleNBrem                 );
-      fTMVAReader[i]->AddVariable( "OneOverEMinusOneOverP", &fMVAVar_EleOneOverEMinusOneOverP );
-    }
-
-    if (type == kNoIPInfo) {
-      fTMVAReader[i]->AddVariable( "SigmaIEtaIEta",         &fMVAVar_EleSigmaIEtaIEta         );
-      fTMVAReader[i]->AddVariable( "DEtaIn",                &fMVAVar_EleDEtaIn                );
-      fTMVAReader[i]->AddVariable( "DPhiIn",                &fMVAVar_EleDPhiIn                );
-      fTMVAReader[i]->AddVariable( "FBrem",                 &fMVAVar_EleFBrem                 );
-      fTMVAReader[i]->AddVariable( "EOverP",                &fMVAVar_EleEOverP                );
-      fTMVAReader[i]->AddVariable( "ESeedClusterOverPout",  &fMVAVar_EleESeedClusterOverPout  );
-      fTMVAReader[i]->AddVariable( "SigmaIPhiIPhi",         &fMVAVar_EleSigmaIPhiIPhi         );
-      fTMVAReader[i]->AddVariable( "NBrem",                 &fMVAVar_EleNBrem                 );
-      fTMVAReader[i]->AddVariable( "OneOverEMinusOneOverP", &fMVAVar_EleOneOverEMinusOneOverP );
-      fTMVAReader[i]->AddVariable( "ESeedClusterOverPIn",   &fMVAVar_EleESeedClusterOverPIn   );
+    for (size_t iVar = 0; iVar < fVariables.size(); ++iVar) {
+      fTMVAReader[i]->AddVariable( fVariableNames[iVar], fVariables[iVar] );
     }
-    if (type == kWithIPInfo) {
-      fTMVAReader[i]->AddVariable( "SigmaIEtaIEta",         &fMVAVar_EleSigmaIEtaIEta         );
-      fTMVAReader[i]->AddVariable( "DEtaIn",                &fMVAVar_EleDEtaIn                );
-      fTMVAReader[i]->AddVariable( "DPhiIn",                &fMVAVar_EleDPhiIn                );
-      fTMVAReader[i]->AddVariable( "D0",                    &fMVAVar_EleD0                    );
-      fTMVAReader[i]->AddVariable( "FBrem",                 &fMVAVar_EleFBrem                 );
-      fTMVAReader[i]->AddVariable( "EOverP",                &fMVAVar_EleEOverP                );
-      fTMVAReader[i]->AddVariable( "ESeedClusterOverPout",  &fMVAVar_EleESeedClusterOverPout  );
-      fTMVAReader[i]->AddVariable( "SigmaIPhiIPhi",         &fMVAVar_EleSigmaIPhiIPhi         );
-      fTMVAReader[i]->AddVariable( "NBrem",                 &fMVAVar_EleNBrem                 );
-      fTMVAReader[i]->AddVariable( "OneOverEMinusOneOverP", &fMVAVar_EleOneOverEMinusOneOverP );
-      fTMVAReader[i]->AddVariable( "ESeedClusterOverPIn",   &fMVAVar_EleESeedClusterOverPIn   );
-      fTMVAReader[i]->AddVariable( "IP3d",                  &fMVAVar_EleIP3d                  );
-      fTMVAReader[i]->AddVariable( "IP3dSig",               &fMVAVar_EleIP3dSig               );
-    }
-
-    if (i==0) loadTMVAWeights(fTMVAReader[i], fMethodname , Subdet0Pt10To20Weights );
-    if (i==1) loadTMVAWeights(fTMVAReader[i], fMethodname , Subdet1Pt10To20Weights );
-    if (i==2) loadTMVAWeights(fTMVAReader[i], fMethodname , Subdet2Pt10To20Weights );
-    if (i==3) loadTMVAWeights(fTMVAReader[i], fMethodname , Subdet0Pt20ToInfWeights );
-    if (i==4) loadTMVAWeights(fTMVAReader[i], fMethodname , Subdet1Pt20ToInfWeights );
-    if (i==5) loadTMVAWeights(fTMVAReader[i], fMethodname , Subdet2Pt20ToInfWeights );
-
+    loadTMVAWeights(fTMVAReader[i], fMethodname , weights[i] );
   }
 
   std::cout << "Electron ID MVA Initialization\n";
@@ -119,7 +128,6 @@ void ElectronIDMVA::Initialize( std::string methodName,
   std::cout << "Load weights file : " << Subdet0Pt20ToInfWeights << std::endl;
   std::cout << "Load weights file : " << Subdet1Pt20ToInfWeights << std::endl;
   std::cout << "Load weights file : " << Subdet2Pt20ToInfWeights << std::endl;
-
 }
 
 
@@ -146,13 +154,6 @@ Double_t ElectronIDMVA::MVAValue(Double_t ElePt , Double_t EleSCEta,
     return -9999;
   }
 
-  Int_t subdet = 0;
-  if (fabs(EleSCEta) < 1.0) subdet = 0;
-  else if (fabs(EleSCEta) < 1.479) subdet = 1;
-  else subdet = 2;
-  Int_t ptBin = 0;
-  if (ElePt > 20.0) ptBin = 1;
-
   //set all input variables
   fMVAVar_EleSigmaIEtaIEta = EleSigmaIEtaIEta;
   fMVAVar_EleDEtaIn = EleDEtaIn;
@@ -169,19 +170,7 @@ Double_t ElectronIDMVA::MVAValue(Double_t ElePt , Double_t EleSCEta,
   fMVAVar_EleIP3d = EleIP3d;
   fMVAVar_EleIP3dSig = EleIP3dSig;
 
-  Double_t mva = -9999;
-  TMVA::Reader *reader = 0;
-  Int_t MVABin = -1;
-  if (subdet == 0 && ptBin == 0) MVABin = 0;
-  if (subdet == 1 && ptBin == 0) MVABin = 1;
-  if (subdet == 2 && ptBin == 0) MVABin = 2;
-  if (subdet == 0 && ptBin == 1) MVABin = 3;
-  if (subdet == 1 && ptBin == 1) MVABin = 4;
-  if (subdet == 2 && ptBin == 1) MVABin = 5;
-  assert(MVABin >= 0 && MVABin <= 5);
-  reader = fTMVAReader[MVABin];
-
-  mva = reader->EvaluateMVA( fMethodname );
+  Double_t mva = Evaluate(MVABin(ElePt, EleSCEta));
 
   return mva;
 }
@@ -214,13 +203,6 @@ Double_t ElectronIDMVA::MVAValue(const reco::GsfElectron *ele, const reco::Verte
   fMVAVar_EleIP3d = -9999.0;
   fMVAVar_EleIP3dSig = -9999.0;
 
-  Int_t subdet = 0;
-  if (fabs(ele->superCluster()->eta()) < 1.0) subdet = 0;
-  else if (fabs(ele->superCluster()->eta()) < 1.479) subdet = 1;
-  else subdet = 2;
-  Int_t ptBin = 0;
-  if (ele->pt() > 20.0) ptBin = 1;
-
   //set all input variables
   fMVAVar_EleSigmaIEtaIEta = ele->sigmaIetaIeta() ;
   fMVAVar_EleDEtaIn = ele->deltaEtaSuperClusterTrackAtVtx();
@@ -266,19 +248,7 @@ Double_t ElectronIDMVA::MVAValue(const reco::GsfElectron *ele, const reco::Verte
     }
   }
 
-  Double_t mva = -9999;
-  TMVA::Reader *reader = 0;
-  Int_t MVABin = -1;
-  if (subdet == 0 && ptBin == 0) MVABin = 0;
-  if (subdet == 1 && ptBin == 0) MVABin = 1;
-  if (subdet == 2 && ptBin == 0) MVABin = 2;
-  if (subdet == 0 && ptBin == 1) MVABin = 3;
-  if (subdet == 1 && ptBin == 1) MVABin = 4;
-  if (subdet == 2 && ptBin == 1) MVABin = 5;
-  assert(MVABin >= 0 && MVABin <= 5);
-  reader = fTMVAReader[MVABin];
-
-  mva = reader->EvaluateMVA( fMethodname );
+  Double_t mva = Evaluate(MVABin(ele->pt(), ele->superCluster()->eta()));
 
 //   ***************************************************
 //   For DEBUGGING
@@ -321,60 +291,9 @@ Double_t ElectronIDMVA::MVAValue(const reco::GsfElectron *ele,
     return -9999;
   }
 
-  //initialize
-  fMVAVar_EleSigmaIEtaIEta = -9999.0;
-  fMVAVar_EleDEtaIn = -9999.0;
-  fMVAVar_EleDPhiIn = -9999.0;
-  fMVAVar_EleHoverE = -9999.0;
-  fMVAVar_EleFBrem = -9999.0;
-  fMVAVar_EleEOverP = -9999.0;
-  fMVAVar_EleESeedClusterOverPout = -9999.0;
-  fMVAVar_EleSigmaIPhiIPhi = -9999.0;
-  fMVAVar_EleNBrem = -9999.0;
-  fMVAVar_EleOneOverEMinusOneOverP = -9999.0;
-  fMVAVar_EleESeedClusterOverPIn = -9999.0;
-
-  Int_t subdet = 0;
-  if (fabs(ele->superCluster()->eta()) < 1.0) subdet = 0;
-  else if (fabs(ele->superCluster()->eta()) < 1.479) subdet = 1;
-  else subdet = 2;
-  Int_t ptBin = 0;
-  if (ele->pt() > 20.0) ptBin = 1;
-
-  //set all input variables
-  fMVAVar_EleSigmaIEtaIEta = ele->sigmaIetaIeta() ;
-  fMVAVar_EleDEtaIn = ele->deltaEtaSuperClusterTrackAtVtx();
-  fMVAVar_EleDPhiIn = ele->deltaPhiSuperClusterTrackAtVtx();
-  fMVAVar_EleHoverE = ele->hcalOverEcal();
-
-  fMVAVar_EleFBrem = ele->fbrem();
-  fMVAVar_EleEOverP = ele->eSuperClusterOverP();
-  fMVAVar_EleESeedClusterOverPout = ele->eSeedClusterOverPout();
-
-  //temporary fix for weird electrons with Sigma iPhi iPhi == Nan
-  //these occur at the sub-percent level
-  std::vector<float> vCov = myEcalCluster.localCovariances(*(ele->superCluster()->seed())) ;
-  if (!isnan(vCov[2])) fMVAVar_EleSigmaIPhiIPhi = sqrt (vCov[2]);
-  else fMVAVar_EleSigmaIPhiIPhi = ele->sigmaIetaIeta();
-
-  fMVAVar_EleNBrem = ele->basicClustersSize() - 1;
-  fMVAVar_EleOneOverEMinusOneOverP = (1.0/(ele->superCluster()->energy())) - 1.0 / ele->gsfTrack()->p();
-  fMVAVar_EleESeedClusterOverPIn = ele->superCluster()->seed()->energy() / ele->trackMomentumAtVtx().R();
-
-
-  Double_t mva = -9999;
-  TMVA::Reader *reader = 0;
-  Int_t MVABin = -1;
-  if (subdet == 0 && ptBin == 0) MVABin = 0;
-  if (subdet == 1 && ptBin == 0) MVABin = 1;
-  if (subdet == 2 && ptBin == 0) MVABin = 2;
-  if (subdet == 0 && ptBin == 1) MVABin = 3;
-  if (subdet == 1 && ptBin == 1) MVABin = 4;
-  if (subdet == 2 && ptBin == 1) MVABin = 5;
-  assert(MVABin >= 0 && MVABin <= 5);
-  reader = fTMVAReader[MVABin];
+  SetVariables(ele, myEcalCluster);
 
-  mva = reader->EvaluateMVA( fMethodname );
+  Double_t mva = Evaluate(MVABin(ele->pt(), ele->superCluster()->eta()));
 
 //   ***************************************************
 //   For DEBUGGING
@@ -409,3 +328,141 @@ double ElectronIDMVA::MVAValue(
   return MVAValue(ele, clusterTool);
 }
 
+//--------------------------------------------------------------------------------------------------
+void ElectronIDMVA::MVAValues(const std::vector<const reco::GsfElectron*>& eles,
+                              EcalClusterLazyTools& myEcalCluster,
+                              std::vector<double>& output) {
+  output.assign(eles.size(), -9999);
+
+  if (!fIsInitialized) {
+    std::cout << "Error: ElectronIDMVA not properly initialized.\n";
+    return;
+  }
+  if (fMVAType == kWithIPInfo) {
+    std::cout << "Error: ElectronIDMVA was initialized with type that requires vertex information. "
+              << "It is not compatible with this accessor. \n";
+    return;
+  }
+
+  // Compute the input variables of all the electrons
+  size_t nVars = fVariables.size();
+  fBatchBins.resize(eles.size());
+  fBatchInputs.resize(eles.size()*nVars);
+  for (size_t i = 0; i < eles.size(); ++i) {
+    const reco::GsfElectron *ele = eles[i];
+    SetVariables(ele, myEcalCluster);
+    fBatchBins[i] = MVABin(ele->pt(), ele->superCluster()->eta());
+    if (!fForest[fBatchBins[i]].isLoaded()) {
+      output[i] = fTMVAReader[fBatchBins[i]]->EvaluateMVA( fMethodname );
+      continue;
+    }
+    for (size_t iVar = 0; iVar < nVars; ++iVar) {
+      fBatchInputs[i*nVars + iVar] = *fVariables[iVar];
+    }
+  }
+
+  // Evaluate each bin in one go
+  for (Int_t bin = 0; bin < 6; ++bin) {
+    if (!fForest[bin].isLoaded())
+      continue;
+    fBinIndices.clear();
+    fBinInputs.clear();
+    for (size_t i = 0; i < eles.size(); ++i) {
+      if (fBatchBins[i] != bin)
+        continue;
+      fBinIndices.push_back(i);
+      fBinInputs.insert(fBinInputs.end(),
+                        fBatchInputs.begin() + i*nVars,
+                        fBatchInputs.begin() + (i + 1)*nVars);
+    }
+    if (fBinIndices.empty())
+      continue;
+    fBinOutputs.resize(fBinIndices.size());
+    fForest[bin].evaluate(fBinIndices.size(), &fBinInputs[0], &fBinOutputs[0]);
+    for (size_t j = 0; j < fBinIndices.size(); ++j) {
+      output[fBinIndices[j]] = fBinOutputs[j];
+    }
+  }
+}
+
+void ElectronIDMVA::MVAValues(
+    const std::vector<const reco::GsfElectron*>& eles,
+    const edm::Event& evt,
+    const edm::EventSetup& es,
+    const edm::InputTag& ebRecHits,
+    const edm::InputTag& eeRecHits,
+    std::vector<double>& output) {
+  EcalClusterLazyTools clusterTool(evt, es, ebRecHits, eeRecHits);
+  MVAValues(eles, clusterTool, output);
+}
+
+//--------------------------------------------------------------------------------------------------
+Int_t ElectronIDMVA::MVABin(Double_t ElePt, Double_t EleSCEta) const {
+  Int_t subdet = 0;
+  if (fabs(EleSCEta) < 1.0) subdet = 0;
+  else if (fabs(EleSCEta) < 1.479) subdet = 1;
+  else subdet = 2;
+  Int_t ptBin = 0;
+  if (ElePt > 20.0) ptBin = 1;
+
+  Int_t MVABin = -1;
+  if (subdet == 0 && ptBin == 0) MVABin = 0;
+  if (subdet == 1 && ptBin == 0) MVABin = 1;
+  if (subdet == 2 && ptBin == 0) MVABin = 2;
+  if (subdet == 0 && ptBin == 1) MVABin = 3;
+  if (subdet == 1 && ptBin == 1) MVABin = 4;
+  if (subdet == 2 && ptBin == 1) MVABin = 5;
+  assert(MVABin >= 0 && MVABin <= 5);
+  return MVABin;
+}
+
+Double_t ElectronIDMVA::Evaluate(Int_t bin) {
+  if (fForest[bin].isLoaded()) {
+    for (size_t iVar = 0; iVar < fVariables.size(); ++iVar) {
+      fInputs[iVar] = *fVariables[iVar];
+    }
+    return fForest[bin].evaluate(&fInputs[0]);
+  }
+  return fTMVAReader[bin]->EvaluateMVA( fMethodname );
+}
+
+void ElectronIDMVA::SetVariables(const reco::GsfElectron *ele,
+                                 EcalClusterLazyTools& myEcalCluster) {
+  //initialize
+  fMVAVar_EleSigmaIEtaIEta = -9999.0;
+  fMVAVar_EleDEtaIn = -9999.0;
+  fMVAVar_EleDPhiIn = -9999.0;
+  fMVAVar_EleHoverE = -9999.0;
+  fMVAVar_EleFBrem = -9999.0;
+  fMVAVar_EleEOverP = -9999.0;
+  fMVAVar_EleESeedClusterOverPout = -9999.0;
+  fMVAVar_EleSigmaIPhiIPhi = -9999.0;
+  fMVAVar_EleNBrem = -9999.0;
+  fMVAVar_EleOneOverEMinusOneOverP = -9999.0;
+  fMVAVar_EleESeedClusterOverPIn = -9999.0;
+
+  //set all input variables
+  fMVAVar_EleSigmaIEtaIEta = ele->sigmaIetaIeta() ;
+  fMVAVar_EleDEtaIn = ele->deltaEtaSuperClusterTrackAtVtx();
+  fMVAVar_EleDPhiIn = ele->deltaPhiSuperClusterTrackAtVtx();
+  fMVAVar_EleHoverE = ele->hcalOverEcal();
+
+  fMVAVar_EleFBrem = ele->fbrem();
+  fMVAVar_EleEOverP = ele->eSuperClusterOverP();
+  fMVAVar_EleESeedClusterOverPout = ele->eSeedClusterOverPout();
+
+  //temporary fix for weird electrons with Sigma iPhi iPhi == Nan
+  //these occur at the sub-percent level
+  std::vector<float> vCov = myEcalCluster.localCovariances(*(ele->superCluster()->seed())) ;
+  if (!isnan(vCov[2])) fMVAVar_EleSigmaIPhiIPhi = sqrt (vCov[2]);
+  else fMVAVar_EleSigmaIPhiIPhi = ele->sigmaIetaIeta();
+
+  fMVAVar_EleNBrem = ele->basicClustersSize() - 1;
+  fMVAVar_EleOneOverEMinusOneOverP = (1.0/(ele->superCluster()->energy())) - 1.0 / ele->gsfTrack()->p();
+  fMVAVar_EleESeedClusterOverPIn = ele->superCluster()->seed()->energy() / ele->trackMomentumAtVtx().R();
+}
+
+void ElectronIDMVA::AddVariable(const std::string& name, Float_t* variable) {
+  fVariableNames.push_back(name);
+  fVariables.push_back(variable);
+}
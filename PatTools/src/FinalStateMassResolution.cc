@@ -8,6 +8,7 @@
 #include "DataFormats/GsfTrackReco/interface/GsfTrack.h"
 #include "DataFormats/ParticleFlowCandidate/interface/PFCandidate.h"
 #include "DataFormats/PatCandidates/interface/Jet.h"
+#include "FinalStateAnalysis/DataFormats/interface/PATObjectShifts.h"
 #include "FWCore/Framework/interface/EventSetup.h"
 
 #include "TrackingTools/AnalyticalJacobians/interface/JacobianCurvilinearToCartesian.h"
@@ -18,8 +19,11 @@
 #include "RecoParticleFlow/PFClusterTools/interface/PFEnergyResolution.h"
 #include "RecoEcal/EgammaCoreTools/interface/EcalClusterFunctionFactory.h"
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/Utilities/interface/Exception.h"
 
 #include <TMatrixD.h>
+#include <TMatrixDSym.h>
+#include <Math/SMatrix.h>
 
 FinalStateMassResolution::
 FinalStateMassResolution() {
@@ -82,12 +86,77 @@ getMassResolution_(const reco::Candidate &c,
 		   bool doComponents) const {
   std::vector<const reco::Candidate *> leaves;
   getLeaves(c, leaves);
+  switch (leaves.size()) {
+  case 2:
+    return getMassResolutionFixed_<2>(c, leaves, errs, doComponents);
+  case 3:
+    return getMassResolutionFixed_<3>(c, leaves, errs, doComponents);
+  case 4:
+    return getMassResolutionFixed_<4>(c, leaves, errs, doComponents);
+  default:
+    return getMassResolutionGeneral_(c, leaves, errs, doComponents);
+  }
+}
+
+// The covariance matrix is block diagonal (one 3x3 block per leaf).  The
+// fixed size version does the same operations in the same order as the
+// TMatrixDSym version, so the results are identical.
+template<unsigned int N>
+double
+FinalStateMassResolution::
+getMassResolutionFixed_(const reco::Candidate &c,
+			const std::vector<const reco::Candidate *> &leaves,
+			std::vector<double> &errs,
+			bool doComponents) const {
+  typedef ROOT::Math::SMatrix<double, 3*N, 3*N,
+	  ROOT::Math::MatRepSym<double, 3*N> > BigCov;
+  typedef ROOT::Math::SVector<double, 3*N> Jacobian;
+  BigCov bigCov;
+  Jacobian jacobian;
+  for (unsigned int i = 0, o = 0; i < N; ++i, o += 3) {
+    const reco::Candidate &ci = *leaves[i];
+    AlgebraicSymMatrix33 cov;
+    fillP3Covariance(ci, cov);
+    bigCov.Place_at(cov, o, o);
+    jacobian(o+0) =
+      (c.energy()*(ci.px()/ci.energy()) - c.px())/c.mass();
+    jacobian(o+1) =
+      (c.energy()*(ci.py()/ci.energy()) - c.py())/c.mass();
+    jacobian(o+2) =
+      (c.energy()*(ci.pz()/ci.energy()) - c.pz())/c.mass();
+  }
+
+  if (doComponents) {
+    errs.resize(N);
+    for (unsigned int i = 0, o = 0; i < N; ++i, o += 3) {
+      BigCov bigCovOne;
+      bigCovOne.Place_at(bigCov.template Sub<AlgebraicSymMatrix33>(o, o),
+			 o, o);
+      double dm2 = ROOT::Math::Similarity(jacobian, bigCovOne);
+      errs[i] = dm2 > 0 ? std::sqrt(dm2) : 0.0;
+    }
+  }
+
+  double dm2 = ROOT::Math::Similarity(jacobian, bigCov);
+  return (dm2 > 0 ? std::sqrt(dm2) : 0.0);
+}
+
+double
+FinalStateMassResolution::
+getMassResolutionGeneral_(const reco::Candidate &c,
+			  const std::vector<const reco::Candidate *> &leaves,
+			  std::vector<double> &errs,
+			  bool doComponents) const {
   int n = leaves.size(), ndim = n*3;
   TMatrixDSym bigCov(ndim);
   TMatrixD jacobian(1,ndim);
   for (int i = 0, o = 0; i < n; ++i, o += 3) {
     const reco::Candidate &ci = *leaves[i];
-    fillP3Covariance(ci, bigCov, o);
+    AlgebraicSymMatrix33 cov;
+    fillP3Covariance(ci, cov);
+    for (int ir = 0; ir < 3; ++ir) { for (int ic = 0; ic < 3; ++ic) {
+	bigCov(o+ir,o+ic) = cov(ir,ic);
+      } }
     jacobian(0, o+0) =
       (c.energy()*(ci.px()/ci.energy()) - c.px())/c.mass();
     jacobian(0, o+1) =
@@ -122,8 +191,7 @@ getMassResolution_(const reco::Candidate &c,
 void
 FinalStateMassResolution::
 fillP3Covariance(const reco::Candidate &c,
-		 TMatrixDSym &bigCov,
-		 int offset) const {
+		 AlgebraicSymMatrix33 &cov) const {
   const reco::GsfElectron *gsf=0;
   const reco::Muon *mu=0;
   const reco::PFCandidate *pf=0;
@@ -133,23 +201,23 @@ fillP3Covariance(const reco::Candidate &c,
 
 
   if ((gsf = dynamic_cast<const reco::GsfElectron *>(&c)) != 0) {
-    fillP3Covariance(*gsf, bigCov, offset);
+    fillP3Covariance(*gsf, cov);
   } else if ((pho = dynamic_cast<const reco::Photon*>(&c)) != 0) {
-    fillP3Covariance(*pho, bigCov, offset);
+    fillP3Covariance(*pho, cov);
   } else if ((mu = dynamic_cast<const reco::Muon *>(&c)) != 0) {
-    fillP3Covariance(*mu, bigCov, offset);
+    fillP3Covariance(*mu, cov);
   } else if ((pf = dynamic_cast<const reco::PFCandidate *>(&c)) != 0 &&
 	     pf->pdgId() == 22) {
-    fillP3Covariance(*pf, bigCov, offset);
+    fillP3Covariance(*pf, cov);
   } else if ((jet = dynamic_cast<const pat::Jet *>(&c)) != 0) {
-    fillP3Covariance(*jet, bigCov, offset);
+    fillP3Covariance(*jet, cov);
   } else if ((ph = dynamic_cast<const reco::LeafCandidate * >(&c))!= 0 &&
 	     abs(ph->pdgId()) != 15 ) {
     //&& ph->pdgId() == 22){
     // case of FSR photon,which is assigned as LeafCandidate
     // in the ZZ analysis
 
-    fillP3Covariance(*ph, bigCov, offset);
+    fillP3Covariance(*ph, cov);
 
   } else {
     throw std::bad_cast();
@@ -159,9 +227,8 @@ fillP3Covariance(const reco::Candidate &c,
 void
 FinalStateMassResolution::
 fillP3Covariance(const reco::Muon &c,
-		 TMatrixDSym &bigCov,
-		 int offset) const {
-  fillP3Covariance(c, *c.track(), bigCov, offset);
+		 AlgebraicSymMatrix33 &cov) const {
+  fillP3Covariance(c, *c.track(), cov);
 }
 
 
@@ -170,8 +237,7 @@ fillP3Covariance(const reco::Muon &c,
 void
 FinalStateMassResolution::
 fillP3Covariance(const reco::LeafCandidate &c,
-		 TMatrixDSym &bigCov,
-		 int offset) const {
+		 AlgebraicSymMatrix33 &cov) const {
 
 //  if (c.pdgId() != 22)
 //    edm::LogWarning("Pdg Id mismatch")
@@ -179,14 +245,13 @@ fillP3Covariance(const reco::LeafCandidate &c,
 
 
   reco::PFCandidate pfc(0,c.p4(),reco::PFCandidate::gamma);
-  fillP3Covariance(pfc, bigCov, offset);
+  fillP3Covariance(pfc, cov);
 }
 
 void
 FinalStateMassResolution::
 fillP3Covariance(const reco::GsfElectron &c,
-		 TMatrixDSym &bigCov,
-		 int offset) const {
+		 AlgebraicSymMatrix33 &cov) const {
   double dp = 0.;
   if (c.ecalDriven()) {
     dp = c.p4Error(reco::GsfElectron::P4_COMBINATION);
@@ -221,14 +286,11 @@ fillP3Covariance(const reco::GsfElectron &c,
   ptop3(2,0) = c.pz()/c.p();
   AlgebraicSymMatrix33 mat = ROOT::Math::Similarity(ptop3,
 					       AlgebraicSymMatrix11(dp*dp) );
-  for (int i = 0; i < 3; ++i)
-    for (int j = 0; j < 3; ++j)
-      bigCov(offset+i,offset+j) = mat(i,j);
+  cov = mat;
 }
 
 void   FinalStateMassResolution::fillP3Covariance(const reco::Photon &c,
-						  TMatrixDSym &bigCov,
-						  int offset) const {
+						  AlgebraicSymMatrix33 &cov) const {
 #if CMSSW_VERSION<500
   double dp = uncertainty_->getValue( *(c.superCluster()) ,
 				      0 );
@@ -247,15 +309,12 @@ void   FinalStateMassResolution::fillP3Covariance(const reco::Photon &c,
   ptop3(2,0) = c.pz()/c.p();
   AlgebraicSymMatrix33 mat = ROOT::Math::Similarity(ptop3,
 						    AlgebraicSymMatrix11(dp*dp) );
-  for (int i = 0; i < 3; ++i)
-    for (int j = 0; j < 3; ++j)
-      bigCov(offset+i,offset+j) = mat(i,j);
+  cov = mat;
 }
 
 void FinalStateMassResolution::fillP3Covariance(const reco::Candidate &c,
 						const reco::Track &t,
-						TMatrixDSym &bigCov,
-						int offset) const {
+						AlgebraicSymMatrix33 &cov) const {
   GlobalTrajectoryParameters gp(GlobalPoint(t.vx(), t.vy(),  t.vz()),
 				GlobalVector(t.px(),t.py(),t.pz()),
 				t.charge(),
@@ -265,17 +324,23 @@ void FinalStateMassResolution::fillP3Covariance(const reco::Candidate &c,
     ROOT::Math::Similarity(curv2cart.jacobian(), t.covariance());
   const AlgebraicSymMatrix66 mat = cartErr.matrix();
   for (int i = 0; i < 3; ++i) { for (int j = 0; j < 3; ++j) {
-      bigCov(offset+i,offset+j) = mat(i+3,j+3);
+      cov(i,j) = mat(i+3,j+3);
     } }
 }
 
 // EKF - make this work on our PAT jets.  NB we do some funky
 // stuff to embed the ES systematic directly in the candidate.
 void FinalStateMassResolution::fillP3Covariance(const pat::Jet &c,
-						TMatrixDSym &bigCov,
-						int offset) const {
-  double shiftUp = c.userCand("jes+")->pt() - c.pt();
-  double shiftDown = c.userCand("jes-")->pt() - c.pt();
+						AlgebraicSymMatrix33 &cov) const {
+  // The shifts are either userCands or in a compact PATObjectShifts
+  reco::Candidate::LorentzVector jesUp, jesDown;
+  if (!PATObjectShifts::shiftedP4(c, "jes+", jesUp) ||
+      !PATObjectShifts::shiftedP4(c, "jes-", jesDown)) {
+    throw cms::Exception("MissingShift")
+      << "FinalStateMassResolution: jet has no jes+/jes- shifts" << std::endl;
+  }
+  double shiftUp = jesUp.pt() - c.pt();
+  double shiftDown = jesDown.pt() - c.pt();
   double dp = sqrt(0.5 * (shiftUp * shiftUp + shiftDown * shiftDown));
   // In order to produce a 3x3 matrix,
   // we need a jacobian from (p) to (px,py,pz), i.e.
@@ -288,14 +353,11 @@ void FinalStateMassResolution::fillP3Covariance(const pat::Jet &c,
   ptop3(2,0) = c.pz()/c.p();
   AlgebraicSymMatrix33 mat = ROOT::Math::Similarity(ptop3,
 						 AlgebraicSymMatrix11(dp*dp) );
-  for (int i = 0; i < 3; ++i) { for (int j = 0; j < 3; ++j) {
-      bigCov(offset+i,offset+j) = mat(i,j);
-    } }
+  cov = mat;
 }
 
 void FinalStateMassResolution::fillP3Covariance(const reco::PFCandidate &c,
-						TMatrixDSym &bigCov,
-						int offset) const {
+						AlgebraicSymMatrix33 &cov) const {
   double dp = PFEnergyResolution().getEnergyResolutionEm(c.energy(),
 							 c.eta());
   // In order to produce a 3x3 matrix,
@@ -309,7 +371,5 @@ void FinalStateMassResolution::fillP3Covariance(const reco::PFCandidate &c,
   ptop3(2,0) = c.pz()/c.p();
   AlgebraicSymMatrix33 mat = ROOT::Math::Similarity(ptop3,
 						 AlgebraicSymMatrix11(dp*dp) );
-  for (int i = 0; i < 3; ++i) { for (int j = 0; j < 3; ++j) {
-      bigCov(offset+i,offset+j) = mat(i,j);
-    } }
+  cov = mat;
 }
@@ -0,0 +1,203 @@
+#include "FinalStateAnalysis/PatTools/interface/JetConstituentSummary.h"
+
+#include "DataFormats/ParticleFlowCandidate/interface/PFCandidate.h"
+#include "DataFormats/MuonReco/interface/Muon.h"
+#include "DataFormats/VertexReco/interface/Vertex.h"
+
+#include <cmath>
+#include <cstdlib>
+
+namespace {
+  const double massPion = 0.1396;
+  const double massKaon = 0.493677;
+  const double massD0 = 1.87;
+  const double massD0Window = 0.05;
+
+  double mass2(double en, double px, double py, double pz) {
+    return en*en-px*px-py*py-pz*pz;
+  }
+}
+
+LeptonInJetSummary::LeptonInJetSummary():
+  pt(-10),eta(-10),phi(-10),charge(0),ptRel(0),
+  dxy(1000),dz(1000),dxyError(1000),dzError(1000),isoAbs(-10) {}
+
+SecondaryVertexSummary::SecondaryVertexSummary():
+  nVertices(0),nVertexTracks(0),charge(0),mass(-777),massD(-777),
+  massD0(-777) {
+  for (unsigned isv = 0; isv < maxVertices; ++isv) {
+    nTracks[isv] = 0;
+    flightDistance[isv] = -777;
+    errorFlightDistance[isv] = -777;
+  }
+  for (unsigned it = 0; it < maxTracks; ++it) {
+    trackPx[it] = trackPy[it] = trackPz[it] = -777;
+    trackCharge[it] = -777;
+  }
+}
+
+double SecondaryVertexSummary::discriminator(unsigned isv,
+    unsigned minTracks, bool negative) const {
+  if (isv >= nVertices || isv >= maxVertices)
+    return -777;
+  if (nTracks[isv] < minTracks || errorFlightDistance[isv] <= 0.)
+    return -777;
+  if (negative) {
+    if (flightDistance[isv] > 0.)
+      return -777;
+    return -log(1. - flightDistance[isv]/errorFlightDistance[isv]);
+  }
+  if (flightDistance[isv] < 0.)
+    return -777;
+  return log(1. + flightDistance[isv]/errorFlightDistance[isv]);
+}
+
+void JetConstituentSummary::fillLeptons(const pat::Jet& jet,
+    const reco::VertexCollection& vertices) {
+  muon = LeptonInJetSummary();
+  electron = LeptonInJetSummary();
+
+  double jetPx = jet.px();
+  double jetPy = jet.py();
+  double jetPz = jet.pz();
+  double jetP2 = pow(jet.p(), 2);
+
+  int nConst = jet.nConstituents();
+  for (int i = 0; i < nConst; ++i) {
+    reco::PFCandidatePtr leptoncand = jet.getPFConstituent(i);
+    int absPdgId = abs(leptoncand->pdgId());
+    if (absPdgId != 13 && absPdgId != 11)
+      continue;
+
+    LeptonInJetSummary& best = (absPdgId == 13) ? muon : electron;
+    double dxy = 100; double dz = 100;
+    double dxyError = 100; double dzError = 100;
+    reco::MuonRef muref;
+    if (absPdgId == 13) {
+      muref = leptoncand->muonRef();
+      if (!muref->isGlobalMuon()) continue;
+      if (!muref->isTrackerMuon()) continue;
+
+      if (vertices.size() >= 1) {
+        dxy = muref->innerTrack()->dxy(vertices[0].position());
+        dz = muref->innerTrack()->dz(vertices[0].position());
+        dxyError = muref->innerTrack()->dxyError();
+        dzError = muref->innerTrack()->dzError();
+      }
+      if (fabs(dxy) > 0.2) continue;
+      if (fabs(dz) > 0.2) continue;
+      const reco::HitPattern& hits = muref->globalTrack()->hitPattern();
+      if (muref->globalTrack()->normalizedChi2() > 10.) continue;
+      if (hits.numberOfValidTrackerHits() < 11) continue;
+      if (hits.numberOfValidPixelHits() < 1) continue;
+      if (hits.numberOfValidMuonHits() < 1) continue;
+      if (muref->numberOfMatches() < 2) continue;
+    }
+
+    double dot = leptoncand->px()*jetPx + leptoncand->py()*jetPy +
+      leptoncand->pz()*jetPz;
+    double ptrelcand = sqrt(pow(leptoncand->p(), 2) - pow(dot, 2)/jetP2);
+    if (ptrelcand > best.ptRel) {
+      best.pt = leptoncand->pt();
+      best.eta = leptoncand->eta();
+      best.phi = leptoncand->phi();
+      best.charge = leptoncand->charge();
+      best.ptRel = ptrelcand*leptoncand->charge();
+      if (absPdgId == 13) {
+        best.dxy = dxy;
+        best.dz = dz;
+        best.dxyError = dxyError;
+        best.dzError = dzError;
+        best.isoAbs = muref->isolationR03().sumPt +
+          muref->isolationR03().emEt + muref->isolationR03().hadEt;
+      }
+    }
+  }
+}
+
+void JetConstituentSummary::fillSecondaryVertices(const pat::Jet& jet) {
+  fill(jet.tagInfoSecondaryVertex("secondaryVertex"), positive);
+  fill(jet.tagInfoSecondaryVertex("secondaryVertexNegative"), negative);
+}
+
+void JetConstituentSummary::fill(const reco::SecondaryVertexTagInfo* info,
+    SecondaryVertexSummary& output) {
+  output = SecondaryVertexSummary();
+  if (!info || info->vertexTracks().size() == 0)
+    return;
+
+  const reco::TrackRefVector& tracks = info->vertexTracks();
+  unsigned nTracks = tracks.size();
+  output.nVertexTracks = nTracks;
+
+  // Everything but the D hypotheses needs a single pass over the tracks.
+  // Those need the total charge, so the momenta of the (at most 3) tracks
+  // they use are kept.
+  double enall = 0.;
+  double pxall = 0.;
+  double pyall = 0.;
+  double pzall = 0.;
+  double p2[SecondaryVertexSummary::maxTracks];
+  for (unsigned it = 0; it < nTracks; ++it) {
+    const reco::Track& track = *tracks[it];
+    double px = track.px();
+    double py = track.py();
+    double pz = track.pz();
+    double trackP2 = px*px+py*py+pz*pz;
+    enall += sqrt(trackP2+massPion*massPion);    // mass v1: everything is a pion
+    pxall += px;
+    pyall += py;
+    pzall += pz;
+    output.charge += track.charge();
+    if (it < SecondaryVertexSummary::maxTracks) {
+      p2[it] = trackP2;
+      output.trackPx[it] = px;
+      output.trackPy[it] = py;
+      output.trackPz[it] = pz;
+      output.trackCharge[it] = track.charge();
+    }
+  }
+  double mass2All = mass2(enall, pxall, pyall, pzall);
+  if (mass2All > 0.) output.mass = sqrt(mass2All);
+
+  // mass v2: a 3 track decay with global charge -1 or +1 is
+  // (pi-,pi-,ka+) or (pi+,pi+,k-)
+  double enD = 0.;
+  if (nTracks == 3 && abs(output.charge) == 1) {
+    for (unsigned it = 0; it < 3; ++it) {
+      double massHadron = massPion;
+      if (output.trackCharge[it]*output.charge < 0) massHadron = massKaon;
+      enD += sqrt(p2[it]+massHadron*massHadron);
+    }
+  }
+  double mass2D = mass2(enD, pxall, pyall, pzall);
+  if (mass2D > 0.) output.massD = sqrt(mass2D);
+
+  // mass v3: a 2 track decay is a D0 to K pi, with either track the kaon
+  double enD0_1 = 0.;
+  double enD0_2 = 0.;
+  if (nTracks == 2) {
+    enD0_1 = sqrt(p2[0]+massPion*massPion) + sqrt(p2[1]+massKaon*massKaon);
+    enD0_2 = sqrt(p2[0]+massKaon*massKaon) + sqrt(p2[1]+massPion*massPion);
+  }
+  double mass2D0_1 = mass2(enD0_1, pxall, pyall, pzall);
+  if (mass2D0_1 > 0.) mass2D0_1 = sqrt(mass2D0_1);
+  double mass2D0_2 = mass2(enD0_2, pxall, pyall, pzall);
+  if (mass2D0_2 > 0.) mass2D0_2 = sqrt(mass2D0_2);
+
+  if (fabs(mass2D0_1-massD0) < massD0Window &&
+      fabs(mass2D0_2-massD0) > massD0Window)
+    output.massD0 = mass2D0_1;
+  else if (fabs(mass2D0_2-massD0) < massD0Window &&
+      fabs(mass2D0_1-massD0) > massD0Window)
+    output.massD0 = mass2D0_2;
+
+  output.nVertices = info->nVertices();
+  for (unsigned isv = 0;
+      isv < output.nVertices && isv < SecondaryVertexSummary::maxVertices;
+      ++isv) {
+    output.nTracks[isv] = info->nVertexTracks(isv);
+    output.flightDistance[isv] = info->flightDistance(isv).value();
+    output.errorFlightDistance[isv] = info->flightDistance(isv).error();
+  }
+}
@@ -17,7 +17,8 @@ namespace pattools {
     typedef ElectronEffectiveArea::ElectronEffectiveAreaTarget EATARGET;
   }
 
-  PATElectronEACalculator::PATElectronEACalculator(const VPSet& areas){
+  PATElectronEACalculator::PATElectronEACalculator(const VPSet& areas):
+    _eatype(-1) {
     VPSet::const_iterator i = areas.begin();
     VPSet::const_iterator e = areas.end();
 
@@ -30,16 +31,43 @@ namespace pattools {
       temp.ea_target = ea_target;
       temp.ea_type   = ea_type;
 
-      _eamap[name] = temp;
+      // the last definition of a repeated name wins
+      std::map<std::string,size_t>::const_iterator found = 
+	_eaindex.find(name);
+      if( found == _eaindex.end() ) {
+	_eaindex[name] = _eas.size();
+	_eas.push_back(temp);
+      } else {
+	_eas[found->second] = temp;
+      }
     }
   }
 
-  double PATElectronEACalculator::operator() (const pat::Electron& ele) {
-    if( _eatype == "" )
+  size_t PATElectronEACalculator::index(const std::string& type) const {
+    std::map<std::string,size_t>::const_iterator found = 
+      _eaindex.find(type);
+    if( found == _eaindex.end() ) 
+      throw cms::Exception("PATElectronEACalculator") 
+	<< "unknown effective area " << type << "!\n";
+    return found->second;
+  }
+
+  void PATElectronEACalculator::setEAType(const std::string& type) {
+    _eatype = index(type);
+  }
+
+  void PATElectronEACalculator::setEATypes(const std::vector<std::string>& types) {
+    _eatypes.clear();
+    for( size_t k = 0; k < types.size(); ++k ) 
+      _eatypes.push_back(index(types[k]));
+  }
+
+  double PATElectronEACalculator::operator() (const pat::Electron& ele) const {
+    if( _eatype < 0 )
       throw cms::Exception("PATElectronEACalculator::()")
 	<< "_eatype not set!\n";
 
-    map_type::mapped_type ea = _eamap[_eatype];
+    const ea_info& ea = _eas[_eatype];
 
     EATYPE   type   = (EATYPE)ea.ea_type;
     EATARGET target = (EATARGET)ea.ea_target;
@@ -49,4 +77,16 @@ namespace pattools {
 					 target);
   }
 
+  void PATElectronEACalculator::operator() (const pat::Electron& ele,
+					   std::vector<double>& output) const {
+    double sc_eta = ele.superCluster()->eta();
+    output.resize(_eatypes.size());
+    for( size_t k = 0; k < _eatypes.size(); ++k ) {
+      const ea_info& ea = _eas[_eatypes[k]];
+      output[k] = eea::GetElectronEffectiveArea((EATYPE)ea.ea_type,
+						sc_eta,
+						(EATARGET)ea.ea_target);
+    }
+  }
+
 }
@@ -20,6 +20,7 @@
 #include "DataFormats/VertexReco/interface/VertexFwd.h"
 #include "DataFormats/VertexReco/interface/Vertex.h"
 
+#include <cassert>
 #include <stdio.h>
 
 namespace pattools {
@@ -58,6 +59,9 @@ namespace pattools {
     VPSet available_regressions =
       conf.getParameterSetVector("available_regressions");
 
+    // regression type : index in _regs
+    std::map<std::string,int> regIndex;
+
     { // make iterators descope
       VPSet::const_iterator i = available_regressions.begin();
       VPSet::const_iterator e = available_regressions.end();
@@ -68,18 +72,24 @@ namespace pattools {
 	int version          = i->getParameter<int>("version");
 	int index            = i->getParameter<int>("index");
 
+	if( !regIndex.count(type) ) {
+	  regIndex[type] = _regs.size();
+	  _regs.push_back(reg_list::value_type(-1,NULL));
+	}
+	reg_list::value_type& thisReg = _regs[regIndex[type]];
+	if( thisReg.second )
+	  delete thisReg.second;
+
 	if( index >= 0 ) {
-	  _regs[type] = std::make_pair(version,new regCalc());
-	  _regs[type].second->initialize(fWeights,
+	  thisReg = std::make_pair(version,new regCalc());
+	  thisReg.second->initialize(fWeights,
 				(regCalc::ElectronEnergyRegressionType)index);
-	  if( _regs[type].second->isInitialized() )
+	  if( thisReg.second->isInitialized() )
 	    std::cout << type << " is init!" << std::endl;
 	}
 	else {
-	  _regs[type] = std::make_pair(-1,new regCalc());
-	  // compiler yells at me if I try to instantiate to NULL
-	  delete _regs[type].second;
-	  _regs[type].second = NULL;
+	  thisReg.first = -1;
+	  thisReg.second = NULL;
 	}
 
       }
@@ -93,6 +103,8 @@ namespace pattools {
       conf.getParameter<vstring>("applyCalibrations");
     _dataset = conf.getParameter<std::string>("dataSet");
 
+    apply_map apply;
+
     { // make iterators descope
       VPSet::const_iterator i = available_calibrations.begin();
       VPSet::const_iterator e = available_calibrations.end();
@@ -109,13 +121,38 @@ namespace pattools {
 	  _calibs[type] =
 	    new eCalib(_dataset,isAOD,isMC,true,applyCorrections,_smearRatio,false,_isSync);
 	  if( std::find(iapp,eapp,type) != eapp)
-	    _apply[type] = regType;
+	    apply[type] = regType;
 	}
 	else
 	  _calibs[type] = NULL;
       }
     }
 
+    // resolve the applied calibrations and their regressions
+    _regUsed.assign(_regs.size(),false);
+    { // make iterators descope
+      apply_map::const_iterator app = apply.begin();
+      apply_map::const_iterator end = apply.end();
+
+      for( ; app != end; ++app ) {
+	Variation var;
+	var.p4Label  = _userP4Prefix+_dataset+app->first;
+	var.errLabel = var.p4Label+_errPostfix;
+	var.calib    = _calibs[app->first];
+	std::map<std::string,int>::const_iterator reg =
+	  regIndex.find(app->second);
+	var.reg = ( reg != regIndex.end() ? reg->second : -1 );
+	if( var.reg >= 0 )
+	  _regUsed[var.reg] = true;
+	_variations.push_back(var);
+      }
+    }
+
+    _regEnergies.resize(_regs.size());
+    _regErrors.resize(_regs.size());
+    _p4s.resize(_variations.size());
+    _p4Errors.resize(_variations.size());
+
   }
 
   PATElectronEnergyCorrection::~PATElectronEnergyCorrection() {
@@ -125,8 +162,8 @@ namespace pattools {
       if(i->second)
 	delete i->second;
 
-    reg_map::iterator ii = _regs.begin();
-    reg_map::iterator ee = _regs.end();
+    reg_list::iterator ii = _regs.begin();
+    reg_list::iterator ee = _regs.end();
     for(; ii != ee; ++ii)
       if(ii->second.second)
 	delete ii->second.second;
@@ -135,84 +172,101 @@ namespace pattools {
   PATElectronEnergyCorrection::value_type
   PATElectronEnergyCorrection::operator() (const eRef& ele) {
     value_type out = value_type(new value_type::element_type(*ele));
+    (*this)(ele,*out);
+    return out;
+  }
 
-    apply_map::const_iterator app = _apply.begin();
-    apply_map::const_iterator end = _apply.end();
-
-    float max_cor_pt = out->pt();
-
-    for( ; app != end; ++app ) {
-      value_type temp = value_type(new value_type::element_type(*ele));
-
-      reg_map::mapped_type thisReg = _regs[app->second];
-      float this_pt = 0.0;
-      // only calculate regression and calibration corrections for
-      // ECAL driven electrons
-      // LAG - 11 DEC 2012
-      if( temp->core()->ecalDrivenSeed() ) {
-	if( thisReg.second ) {
-          SuperClusterHelper suckyClusterHelper(temp.get(),
-              temp->isEB() ? _recHitCollectionEB.product() : _recHitCollectionEE.product(),
-              _topo, _geom);
-	  double en =
-	    thisReg.second->calculateRegressionEnergy(
-                temp.get(), suckyClusterHelper, _rho,_nvtx);
-	  double en_err =
-	    thisReg.second->calculateRegressionEnergyUncertainty(
-                temp.get(), suckyClusterHelper, _rho,_nvtx);
+  void PATElectronEnergyCorrection::operator() (const eRef& ele,
+						pat::Electron& out) {
+    const size_t nVariations = _variations.size();
+
+    float max_cor_pt = out.pt();
+
+    // only calculate regression and calibration corrections for
+    // ECAL driven electrons
+    // LAG - 11 DEC 2012
+    if( ele->core()->ecalDrivenSeed() ) {
+      // the regression inputs only depend on the uncorrected electron,
+      // so each regression is evaluated once for all the variations
+      bool needRegression = false;
+      for( size_t r = 0; r < _regs.size(); ++r )
+	needRegression = needRegression || (_regUsed[r] && _regs[r].second);
+      if( needRegression ) {
+	SuperClusterHelper suckyClusterHelper(ele.get(),
+            ele->isEB() ? _recHitCollectionEB.product() : _recHitCollectionEE.product(),
+            _topo, _geom);
+	for( size_t r = 0; r < _regs.size(); ++r ) {
+	  if( !_regUsed[r] || !_regs[r].second ) continue;
+	  _regEnergies[r] =
+	    _regs[r].second->calculateRegressionEnergy(
+                ele.get(), suckyClusterHelper, _rho,_nvtx);
+	  _regErrors[r] =
+	    _regs[r].second->calculateRegressionEnergyUncertainty(
+                ele.get(), suckyClusterHelper, _rho,_nvtx);
+	}
+      }
+
+      // one working copy, reset to the uncorrected electron for each
+      // variation, so nothing carries over from one to the next
+      pat::Electron& temp = _work;
+      for( size_t v = 0; v < nVariations; ++v ) {
+	const Variation& var = _variations[v];
+	temp = *ele;
+
+	if( var.reg >= 0 && _regs[var.reg].second ) {
+	  double en     = _regEnergies[var.reg];
+	  double en_err = _regErrors[var.reg];
 
 	  math::XYZTLorentzVector oldP4,newP4;
 	  // recalculate then propagate the regression energy and errors
-	  switch( thisReg.first ) {
+	  switch( _regs[var.reg].first ) {
 	  case 1: // V1 regression (just ecal energy)
-	    temp->setEcalRegressionEnergy(en,en_err); //HCP2012_V03-02
-	    temp->correctEcalEnergy(en,en_err); // this is for later versions?
+	    temp.setEcalRegressionEnergy(en,en_err); //HCP2012_V03-02
+	    temp.correctEcalEnergy(en,en_err); // this is for later versions?
 	    break;
 	  case 2: // V2 regression (including track variables)
-	    oldP4 = temp->p4();
+	    oldP4 = temp.p4();
 	    newP4 = math::XYZTLorentzVector(oldP4.x()*en/oldP4.t(),
 					    oldP4.y()*en/oldP4.t(),
 					    oldP4.z()*en/oldP4.t(),
 					    en);
-	    temp->correctEcalEnergy(en,en_err);
-	    temp->correctMomentum(newP4,temp->trackMomentumError(),en_err);
+	    temp.correctEcalEnergy(en,en_err);
+	    temp.correctMomentum(newP4,temp.trackMomentumError(),en_err);
 	    break;
 	  default:
 	    break;
 	  }
 	}
 
-	pCalib thisCalib = _calibs[app->first];
-	if( thisCalib )
-	  thisCalib->correct(*(temp.get()),temp.get()->r9(),*_event,*_esetup,temp.get()->ecalRegressionEnergy(),temp.get()->ecalRegressionError());
-
-	out->addUserData<math::XYZTLorentzVector>(_userP4Prefix+
-						  _dataset+app->first,
-				  temp->p4(reco::GsfElectron::P4_COMBINATION));
-	out->addUserFloat(_userP4Prefix+
-			  _dataset+app->first+
-			  _errPostfix,
-			  temp->p4Error(reco::GsfElectron::P4_COMBINATION));
-	this_pt = temp->p4(reco::GsfElectron::P4_COMBINATION).pt();
-      } else { // no corrections for tracker driven electrons (per ZZ analysis)
-	// add the nominal pt and ptErr values in as "corrections"
-	// for consistency
-	out->addUserData<math::XYZTLorentzVector>(_userP4Prefix+
-						  _dataset+app->first,
-				  temp->p4(temp->candidateP4Kind()));
-	out->addUserFloat(_userP4Prefix+
-			  _dataset+app->first+
-			  _errPostfix,
-			  temp->p4Error(temp->candidateP4Kind()));
-	this_pt = temp->p4(temp->candidateP4Kind()).pt();
+	if( var.calib )
+	  var.calib->correct(temp,temp.r9(),*_event,*_esetup,temp.ecalRegressionEnergy(),temp.ecalRegressionError());
+
+	_p4s[v]      = temp.p4(reco::GsfElectron::P4_COMBINATION);
+	_p4Errors[v] = temp.p4Error(reco::GsfElectron::P4_COMBINATION);
       }
+      // the corrections must not leak into the output electron
+      assert( out.p4() == ele->p4() &&
+	      out.ecalRegressionEnergy() == ele->ecalRegressionEnergy() &&
+	      out.ecalRegressionError() == ele->ecalRegressionError() );
+    } else { // no corrections for tracker driven electrons (per ZZ analysis)
+      // add the nominal pt and ptErr values in as "corrections"
+      // for consistency
+      for( size_t v = 0; v < nVariations; ++v ) {
+	_p4s[v]      = ele->p4(ele->candidateP4Kind());
+	_p4Errors[v] = ele->p4Error(ele->candidateP4Kind());
+      }
+    }
+
+    for( size_t v = 0; v < nVariations; ++v ) {
+      out.addUserData<math::XYZTLorentzVector>(_variations[v].p4Label,
+					       _p4s[v]);
+      out.addUserFloat(_variations[v].errLabel,_p4Errors[v]);
+      float this_pt = _p4s[v].pt();
       max_cor_pt = std::max(max_cor_pt,
 			    this_pt);
     }
 
-    out->addUserFloat("maxCorPt",max_cor_pt);
-
-    return out;
+    out.addUserFloat("maxCorPt",max_cor_pt);
   }
 
   void PATElectronEnergyCorrection::setES(const edm::EventSetup& es) {
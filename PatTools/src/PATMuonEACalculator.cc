@@ -11,7 +11,8 @@ namespace pattools {
     typedef std::vector<double> vdouble;    
   }
 
-  PATMuonEACalculator::PATMuonEACalculator(const VPSet& areas){
+  PATMuonEACalculator::PATMuonEACalculator(const VPSet& areas):
+    _eatype(-1) {
     VPSet::const_iterator i = areas.begin();
     VPSet::const_iterator e = areas.end();
 
@@ -28,33 +29,70 @@ namespace pattools {
 						   << " must be one greater"
 						   << " than effective_areas"
 						   << "!\n";
-      for( size_t k = 1; k < etas.size(); ++k ) {
-	ea_info temp;
-	temp.eta_max  = etas[k];
-	temp.eta_min  = etas[k-1];
-	temp.eff_area = eas[k-1];
-	temp.cone_size = cone_size;
-
-	temp.needs_pfneut = needs_neuts;
-	temp.needs_pfpho  = needs_phos;
+      if( eas.empty() )
+	throw cms::Exception("PATMuonEACalculator") << "no effective_areas"
+						   << " for " << name
+						   << "!\n";
 
-	_eamap[name].push_back(temp);
+      // bins of a repeated name are added to the same table
+      std::map<std::string,size_t>::const_iterator found = 
+	_eaindex.find(name);
+      if( found == _eaindex.end() ) {
+	found = _eaindex.insert(std::make_pair(name,_tables.size())).first;
+	_tables.push_back(ea_table());
       }
+      ea_table& table = _tables[found->second];
+      table.cone_size    = cone_size;
+      table.needs_pfneut = needs_neuts;
+      table.needs_pfpho  = needs_phos;
+      table.eta_max.insert(table.eta_max.end(),etas.begin()+1,etas.end());
+      table.eff_area.insert(table.eff_area.end(),eas.begin(),eas.end());
     }
   }
 
-  double PATMuonEACalculator::operator() (const pat::Muon& mu) {
-    if( _eatype == "" ) 
-      throw cms::Exception("PATMuonEACalculator::()") << "_eatype not set!\n";
-    
-    map_type::mapped_type eas = _eamap[_eatype];
+  size_t PATMuonEACalculator::index(const std::string& type) const {
+    std::map<std::string,size_t>::const_iterator found = 
+      _eaindex.find(type);
+    if( found == _eaindex.end() ) 
+      throw cms::Exception("PATMuonEACalculator") << "unknown effective area "
+						 << type << "!\n";
+    return found->second;
+  }
 
-    std::vector<ea_info>::const_iterator i = eas.begin();
-    std::vector<ea_info>::const_iterator e = eas.end();
+  void PATMuonEACalculator::setEAType(const std::string& type) {
+    _eatype = index(type);
+  }
 
-    while(fabs(mu.eta()) >= i->eta_max && i != e) ++i;    
+  void PATMuonEACalculator::setEATypes(const std::vector<std::string>& types) {
+    _eatypes.clear();
+    for( size_t k = 0; k < types.size(); ++k ) 
+      _eatypes.push_back(index(types[k]));
+  }
+
+  double PATMuonEACalculator::lookup(const ea_table& table, 
+				     double abseta) const {
+    // first bin that doesn't end below abseta, the last bin beyond the 
+    // last boundary
+    size_t last = table.eta_max.size() - 1;
+    size_t k = 0;
+    while( k < last && abseta >= table.eta_max[k] ) ++k;
+    return table.eff_area[k];
+  }
+
+  double PATMuonEACalculator::operator() (const pat::Muon& mu) const {
+    if( _eatype < 0 ) 
+      throw cms::Exception("PATMuonEACalculator::()") 
+	<< "_eatype not set!\n";
     
-    return i->eff_area;
+    return lookup(_tables[_eatype],fabs(mu.eta()));
   }  
 
+  void PATMuonEACalculator::operator() (const pat::Muon& mu, 
+				       std::vector<double>& output) const {
+    double abseta = fabs(mu.eta());
+    output.resize(_eatypes.size());
+    for( size_t k = 0; k < _eatypes.size(); ++k ) 
+      output[k] = lookup(_tables[_eatypes[k]],abseta);
+  }
+
 }
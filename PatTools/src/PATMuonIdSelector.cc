@@ -127,12 +127,8 @@ void PATMuonIdSelectorImp::print()
   if ( IPrefType_   == kVertex      ) std::cout << "vertex"      << std::endl;
 }
 
-void PATMuonIdSelectorImp::select(const edm::Handle<collection>& patMuonCollection,
-				    edm::Event& evt, const edm::EventSetup& es)
+void PATMuonIdSelectorImp::setReferencePoint(const edm::Event& evt)
 {
-  selected_.clear();
-
-  reco::TrackBase::Point IPrefPoint;
   bool IPrefPoint_initialized = false;
 
   if ( IPrefType_ == kVertex ) {
@@ -141,7 +137,7 @@ void PATMuonIdSelectorImp::select(const edm::Handle<collection>& patMuonCollecti
     for ( reco::VertexCollection::const_iterator recoVertex = recoVertices->begin();
 	  recoVertex != recoVertices->end(); ++recoVertex ) {
       if ( recoVertex->tracksSize() > 0 ) {
-	IPrefPoint = recoVertex->position();
+	IPrefPoint_ = recoVertex->position();
 	IPrefPoint_initialized = true;
 	break;
       }
@@ -151,46 +147,58 @@ void PATMuonIdSelectorImp::select(const edm::Handle<collection>& patMuonCollecti
   if ( !IPrefPoint_initialized ) {
     edm::Handle<reco::BeamSpot> beamSpot;
     evt.getByLabel(srcBeamSpot_, beamSpot);
-    IPrefPoint = beamSpot->position();
+    IPrefPoint_ = beamSpot->position();
   }
+}
+
+bool PATMuonIdSelectorImp::passes(const pat::Muon& patMuon) const
+{
+  if ( !patMuon.isGlobalMuon()                                                                ) return false;   
+  if ( !use2012IDVariables_ && !patMuon.isTrackerMuon()                                       ) return false;
+  if ( use2012IDVariables_  && usePFMuonReq_ && !(patMuon.type() & kPFMuonType )              ) return false;
+  if ( !isValidRef(patMuon.globalTrack())                                                     ) return false;
+  if ( !isValidRef(patMuon.innerTrack())                                                      ) return false;
+
+  if ( applyGlobalMuonPromptTight_ && !muon::isGoodMuon(patMuon, muon::GlobalMuonPromptTight) ) return false;
+  if ( applyAllArbitrated_         && !muon::isGoodMuon(patMuon, muon::AllArbitrated)         ) return false;
+
+  reco::TrackRef muonTrack;
+  if      ( IPtrackType_ == kInnerTrack  ) muonTrack = patMuon.innerTrack();
+  else if ( IPtrackType_ == kGlobalTrack ) muonTrack = patMuon.globalTrack();
+  if ( !isValidRef(muonTrack)                                                                  ) return false;
+  if ( !(TMath::Abs(muonTrack->dxy(IPrefPoint_)) < maxIPxy_)                                    ) return false;
+  if ( !(TMath::Abs(muonTrack->dz(IPrefPoint_)) < maxIPz_)                                      ) return false;
+
+  if ( !(patMuon.globalTrack()->normalizedChi2() < maxChi2red_)                               ) return false;
+  if ( !use2012IDVariables_ && 
+	 !(patMuon.innerTrack()->ptError() < (maxDptOverPt_*patMuon.innerTrack()->pt()))       ) return false;
+
+  const reco::HitPattern& innerHitPattern = patMuon.innerTrack()->hitPattern();
+  if ( !use2012IDVariables_ && 
+	 !(innerHitPattern.numberOfValidTrackerHits() >= (int)minTrackerHits_)                   ) return false; 
+  if (  use2012IDVariables_ && 
+	 !(innerHitPattern.trackerLayersWithMeasurement() >= (int)minTkLayersWithMeasurement_)   ) return false;
+  if ( !(innerHitPattern.numberOfValidPixelHits() >= (int)minPixelHits_)                       ) return false;
+
+  if ( !(patMuon.numberOfMatchedStations() >= (int)minMuonStations_)                           ) return false;
+
+  const reco::HitPattern& globalHitPattern = patMuon.globalTrack()->hitPattern();    
+  if ( use2012IDVariables_ && 
+	 !(globalHitPattern.numberOfValidMuonHits() >= (int)minMuonHits_)                         ) return false;
+  if ( !use2012IDVariables_ && !(patMuon.numberOfMatches() >= (int)minMatchedSegments_)        ) return false;
+
+  return true;
+}
+
+void PATMuonIdSelectorImp::select(const edm::Handle<collection>& patMuonCollection,
+				    edm::Event& evt, const edm::EventSetup& es)
+{
+  selected_.clear();
+
+  setReferencePoint(evt);
 
   for ( collection::const_iterator patMuon = patMuonCollection->begin();
 	patMuon != patMuonCollection->end(); ++patMuon ) {
-
-    if ( !patMuon->isGlobalMuon()                                                                ) continue;   
-    if ( !use2012IDVariables_ && !patMuon->isTrackerMuon()                                       ) continue;
-    if ( use2012IDVariables_  && usePFMuonReq_ && !(patMuon->type() & kPFMuonType )              ) continue;
-    if ( !isValidRef(patMuon->globalTrack())                                                     ) continue;
-    if ( !isValidRef(patMuon->innerTrack())                                                      ) continue;
-
-    if ( applyGlobalMuonPromptTight_ && !muon::isGoodMuon(*patMuon, muon::GlobalMuonPromptTight) ) continue;
-    if ( applyAllArbitrated_         && !muon::isGoodMuon(*patMuon, muon::AllArbitrated)         ) continue;
-
-    reco::TrackRef muonTrack;
-    if      ( IPtrackType_ == kInnerTrack  ) muonTrack = patMuon->innerTrack();
-    else if ( IPtrackType_ == kGlobalTrack ) muonTrack = patMuon->globalTrack();
-    if ( !isValidRef(muonTrack)                                                                  ) continue;
-    if ( !(TMath::Abs(muonTrack->dxy(IPrefPoint)) < maxIPxy_)                                    ) continue;
-    if ( !(TMath::Abs(muonTrack->dz(IPrefPoint)) < maxIPz_)                                      ) continue;
-
-    if ( !(patMuon->globalTrack()->normalizedChi2() < maxChi2red_)                               ) continue;
-    if ( !use2012IDVariables_ && 
-	 !(patMuon->innerTrack()->ptError() < (maxDptOverPt_*patMuon->innerTrack()->pt()))       ) continue;
-
-    const reco::HitPattern& innerHitPattern = patMuon->innerTrack()->hitPattern();
-    if ( !use2012IDVariables_ && 
-	 !(innerHitPattern.numberOfValidTrackerHits() >= (int)minTrackerHits_)                   ) continue; 
-    if (  use2012IDVariables_ && 
-	 !(innerHitPattern.trackerLayersWithMeasurement() >= (int)minTkLayersWithMeasurement_)   ) continue;
-    if ( !(innerHitPattern.numberOfValidPixelHits() >= (int)minPixelHits_)                       ) continue;
-    
-    if ( !(patMuon->numberOfMatchedStations() >= (int)minMuonStations_)                           ) continue;
-
-    const reco::HitPattern& globalHitPattern = patMuon->globalTrack()->hitPattern();    
-    if ( use2012IDVariables_ && 
-	 !(globalHitPattern.numberOfValidMuonHits() >= (int)minMuonHits_)                         ) continue;
-    if ( !use2012IDVariables_ && !(patMuon->numberOfMatches() >= (int)minMatchedSegments_)        ) continue;
-
-    selected_.push_back(&(*patMuon));
+    if ( passes(*patMuon) ) selected_.push_back(&(*patMuon));
   }
 }
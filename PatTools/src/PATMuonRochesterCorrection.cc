@@ -27,7 +27,8 @@ namespace pattools {
 							 const bool isMC):
     _errupPostfix("_errUp"),
     _errdownPostfix("_errDown"),
-    _tkFitErr("_tkFitErr") {
+    _tkFitErr("_tkFitErr"),
+    _isMC(isMC) {
     
     _userP4Prefix = conf.getParameter<std::string>("userP4Prefix");
         
@@ -63,6 +64,18 @@ namespace pattools {
 	
       }      
     }    
+
+    for( vstring::const_iterator app = _apply.begin(); 
+	 app != _apply.end(); ++app ) {
+      calib_map::const_iterator calib = _calibs.find(*app);
+      if( calib == _calibs.end() ) {
+	throw cms::Exception("PATMuonRochesterCorrection::ctor")
+	  << "applied correction " << *app 
+	  << " is not in available_corrections!\n";
+      }
+      _applied.push_back(&calib->second);
+    }
+    _corrected.resize(3*_applied.size());
     
   }
  
@@ -77,50 +90,105 @@ namespace pattools {
 
   pat::Muon
   PATMuonRochesterCorrection::operator() (const muRef& mu) {    
-    pat::Muon out = *mu;
+    pat::MuonCollection in(1, *mu);
+    pat::MuonCollection out;
+    (*this)(in, out);
+    return out.front();
+  }  
 
-    vstring::const_iterator app = _apply.begin();
-    vstring::const_iterator end = _apply.end();
-    
-    float max_cor_pt = out.pt();
-
-    for( ; app != end; ++app ) {
-      std::pair<math::XYZTLorentzVector,float> corr_p4, errup_p4, errdown_p4;
-      float syst = _calibs[*app].syst_err;
-
-      corr_p4    = _calibs[*app].central_value->correct(mu->p4(),
-							mu->charge(),
-							syst);      
-      errup_p4   = _calibs[*app].syst_smear->correct(mu->p4(),
-						     mu->charge(),
-						     syst);
-      errdown_p4 = _calibs[*app].syst_smear->correct(mu->p4(),
-						     mu->charge(),
-						     -syst);
-
-      out.addUserData<math::XYZTLorentzVector>(_userP4Prefix+
-					       *app,
-					       corr_p4.first);
-      out.addUserFloat(_userP4Prefix+
-		       *app+_tkFitErr,
-		       corr_p4.second);
-      out.addUserData<math::XYZTLorentzVector>(_userP4Prefix+
-					       *app+
-					       _errupPostfix,
-					       errup_p4.first);
-      out.addUserData<math::XYZTLorentzVector>(_userP4Prefix+
-					       *app+
-					       _errdownPostfix,
-					       errdown_p4.first);
-
-      float this_pt = corr_p4.first.pt();
-      max_cor_pt = std::max(max_cor_pt, 
-			    this_pt);
+  void
+  PATMuonRochesterCorrection::operator() (const pat::MuonCollection& muons,
+					  pat::MuonCollection& output) {
+    const size_t n = muons.size();
+    const size_t n_calibs = _applied.size();
+    if( n == 0 ) return;
+
+    _charge.resize(n);
+    for( size_t i = 0; i < n; ++i ) _charge[i] = muons[i].charge();
+
+    // one-by-one, the deviates are drawn per muon, per calibration,
+    // for the central value, up and down shifts in turn
+    if( _isMC && n_calibs ) {
+      _normals.resize(3*n_calibs*n);
+      _applied.front()->central_value->drawNormals(_normals.size(), 
+						   &_normals[0]);
+      _calibNormals.resize(n);
     }
-    
-    out.addUserFloat("maxCorPt",max_cor_pt);
 
-    return out;
+    for( size_t iCalib = 0; iCalib < n_calibs; ++iCalib ) {
+      const calib_container& calib = *_applied[iCalib];
+      for( size_t iShift = 0; iShift < 3; ++iShift ) {
+	corrected_p4s& p4s = _corrected[3*iCalib + iShift];
+	p4s.px.resize(n);
+	p4s.py.resize(n);
+	p4s.pz.resize(n);
+	p4s.e.resize(n);
+	p4s.err.resize(n);
+	for( size_t i = 0; i < n; ++i ) {
+	  const math::XYZTLorentzVector& pin = muons[i].p4();
+	  p4s.px[i] = pin.x();
+	  p4s.py[i] = pin.y();
+	  p4s.pz[i] = pin.z();
+	  p4s.e[i]  = pin.t();
+	}
+	if( _isMC ) {
+	  for( size_t i = 0; i < n; ++i ) 
+	    _calibNormals[i] = _normals[3*(i*n_calibs + iCalib) + iShift];
+	}
+	
+	CorrectionBase* corr = 
+	  (iShift == 0 ? calib.central_value : calib.syst_smear);
+	float sysdev = (iShift == 2 ? -calib.syst_err : calib.syst_err);
+	corr->correct(n,
+		      &p4s.px[0], &p4s.py[0], &p4s.pz[0], &p4s.e[0],
+		      &_charge[0],
+		      sysdev,
+		      &p4s.err[0],
+		      _isMC ? &_calibNormals[0] : 0);
+      }
+    }
+
+    for( size_t i = 0; i < n; ++i ) {
+      output.push_back(muons[i]);
+      pat::Muon& out = output.back();
+
+      float max_cor_pt = out.pt();
+
+      for( size_t iCalib = 0; iCalib < n_calibs; ++iCalib ) {
+	const std::string& app = _apply[iCalib];
+	const corrected_p4s& corr_p4s = _corrected[3*iCalib];
+	const corrected_p4s& errup_p4s = _corrected[3*iCalib + 1];
+	const corrected_p4s& errdown_p4s = _corrected[3*iCalib + 2];
+
+	math::XYZTLorentzVector corr_p4(corr_p4s.px[i], corr_p4s.py[i],
+					corr_p4s.pz[i], corr_p4s.e[i]);
+	math::XYZTLorentzVector errup_p4(errup_p4s.px[i], errup_p4s.py[i],
+					 errup_p4s.pz[i], errup_p4s.e[i]);
+	math::XYZTLorentzVector errdown_p4(errdown_p4s.px[i], errdown_p4s.py[i],
+					   errdown_p4s.pz[i], errdown_p4s.e[i]);
+
+	out.addUserData<math::XYZTLorentzVector>(_userP4Prefix+
+						 app,
+						 corr_p4);
+	out.addUserFloat(_userP4Prefix+
+			 app+_tkFitErr,
+			 corr_p4s.err[i]);
+	out.addUserData<math::XYZTLorentzVector>(_userP4Prefix+
+						 app+
+						 _errupPostfix,
+						 errup_p4);
+	out.addUserData<math::XYZTLorentzVector>(_userP4Prefix+
+						 app+
+						 _errdownPostfix,
+						 errdown_p4);
+
+	float this_pt = corr_p4.pt();
+	max_cor_pt = std::max(max_cor_pt, 
+			      this_pt);
+      }
+    
+      out.addUserFloat("maxCorPt",max_cor_pt);
+    }
   }  
   
 }
@@ -11,7 +11,8 @@ namespace pattools {
     typedef std::vector<double> vdouble;    
   }
 
-  PATPhotonEACalculator::PATPhotonEACalculator(const VPSet& areas){
+  PATPhotonEACalculator::PATPhotonEACalculator(const VPSet& areas):
+    _eatype(-1) {
     VPSet::const_iterator i = areas.begin();
     VPSet::const_iterator e = areas.end();
 
@@ -28,34 +29,70 @@ namespace pattools {
 						   << " must be one greater"
 						   << " than effective_areas"
 						   << "!\n";
-      for( size_t k = 1; k < etas.size(); ++k ) {
-	ea_info temp;
-	temp.eta_max  = etas[k];
-	temp.eta_min  = etas[k-1];
-	temp.eff_area = eas[k-1];
-	temp.cone_size = cone_size;
-
-	temp.needs_pfneut = needs_neuts;
-	temp.needs_pfpho  = needs_phos;
+      if( eas.empty() )
+	throw cms::Exception("PATPhotonEACalculator") << "no effective_areas"
+						   << " for " << name
+						   << "!\n";
 
-	_eamap[name].push_back(temp);
+      // bins of a repeated name are added to the same table
+      std::map<std::string,size_t>::const_iterator found = 
+	_eaindex.find(name);
+      if( found == _eaindex.end() ) {
+	found = _eaindex.insert(std::make_pair(name,_tables.size())).first;
+	_tables.push_back(ea_table());
       }
+      ea_table& table = _tables[found->second];
+      table.cone_size    = cone_size;
+      table.needs_pfneut = needs_neuts;
+      table.needs_pfpho  = needs_phos;
+      table.eta_max.insert(table.eta_max.end(),etas.begin()+1,etas.end());
+      table.eff_area.insert(table.eff_area.end(),eas.begin(),eas.end());
     }
   }
 
-  double PATPhotonEACalculator::operator() (const pat::Photon& pho) {
-    if( _eatype == "" ) 
-      throw cms::Exception("PATPhotonEACalculator::()") 
-	<< "_eatype not set!\n";
-    
-    map_type::mapped_type eas = _eamap[_eatype];
+  size_t PATPhotonEACalculator::index(const std::string& type) const {
+    std::map<std::string,size_t>::const_iterator found = 
+      _eaindex.find(type);
+    if( found == _eaindex.end() ) 
+      throw cms::Exception("PATPhotonEACalculator") << "unknown effective area "
+						 << type << "!\n";
+    return found->second;
+  }
 
-    std::vector<ea_info>::const_iterator i = eas.begin();
-    std::vector<ea_info>::const_iterator e = eas.end();
+  void PATPhotonEACalculator::setEAType(const std::string& type) {
+    _eatype = index(type);
+  }
 
-    while(fabs(pho.superCluster()->eta()) >= i->eta_max && i != e) ++i;    
+  void PATPhotonEACalculator::setEATypes(const std::vector<std::string>& types) {
+    _eatypes.clear();
+    for( size_t k = 0; k < types.size(); ++k ) 
+      _eatypes.push_back(index(types[k]));
+  }
+
+  double PATPhotonEACalculator::lookup(const ea_table& table, 
+				     double abseta) const {
+    // first bin that doesn't end below abseta, the last bin beyond the 
+    // last boundary
+    size_t last = table.eta_max.size() - 1;
+    size_t k = 0;
+    while( k < last && abseta >= table.eta_max[k] ) ++k;
+    return table.eff_area[k];
+  }
+
+  double PATPhotonEACalculator::operator() (const pat::Photon& pho) const {
+    if( _eatype < 0 ) 
+      throw cms::Exception("PATPhotonEACalculator::()") 
+	<< "_eatype not set!\n";
     
-    return i->eff_area;
+    return lookup(_tables[_eatype],fabs(pho.superCluster()->eta()));
   }  
 
+  void PATPhotonEACalculator::operator() (const pat::Photon& pho, 
+				       std::vector<double>& output) const {
+    double abseta = fabs(pho.superCluster()->eta());
+    output.resize(_eatypes.size());
+    for( size_t k = 0; k < _eatypes.size(); ++k ) 
+      output[k] = lookup(_tables[_eatypes[k]],abseta);
+  }
+
 }
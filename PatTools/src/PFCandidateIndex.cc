@@ -0,0 +1,123 @@
+#include "FinalStateAnalysis/PatTools/interface/PFCandidateIndex.h"
+
+#include <algorithm>
+
+namespace {
+  // Number of PFCandidate::ParticleTypes
+  const size_t nTypes = reco::PFCandidate::egamma_HF + 1;
+
+  // False for NaN and +-inf
+  bool isFinite(double x) {
+    return x - x == 0;
+  }
+}
+
+PFCandidateIndex::PFCandidateIndex(double cellSize):
+  buckets_(nTypes, Bucket(cellSize)),
+  cachedVertices_(0),cachedDeltaZ_(0),cachedBeamSpot_(0) {}
+
+void PFCandidateIndex::fill(const reco::PFCandidateCollection& pfCandidates) {
+  for (size_t t = 0; t < buckets_.size(); ++t) {
+    buckets_[t].candidates.clear();
+    buckets_[t].index.clear();
+    buckets_[t].unindexed.clear();
+  }
+  for (size_t i = 0; i < pfCandidates.size(); ++i) {
+    const reco::PFCandidate& pfCandidate = pfCandidates[i];
+    Bucket& theBucket = buckets_.at(pfCandidate.particleId());
+    size_t position = theBucket.candidates.size();
+    theBucket.candidates.push_back(&pfCandidate);
+    double eta = pfCandidate.eta();
+    double phi = pfCandidate.phi();
+    if (isFinite(eta) && isFinite(phi))
+      theBucket.index.insert(eta, phi, position);
+    else
+      theBucket.unindexed.push_back(position);
+  }
+  for (size_t t = 0; t < buckets_.size(); ++t) {
+    buckets_[t].vertices.assign(buckets_[t].candidates.size(), 0);
+    buckets_[t].vertexDone.assign(buckets_[t].candidates.size(), 0);
+  }
+  cachedVertices_ = 0;
+  cachedBeamSpot_ = 0;
+}
+
+const PFCandidateIndex::Bucket& PFCandidateIndex::bucket(
+    reco::PFCandidate::ParticleType type) const {
+  return buckets_.at(type);
+}
+
+const std::vector<const reco::PFCandidate*>& PFCandidateIndex::candidates(
+    reco::PFCandidate::ParticleType type) const {
+  return bucket(type).candidates;
+}
+
+void PFCandidateIndex::near(reco::PFCandidate::ParticleType type,
+    const reco::Particle::Vector& axis, double radius,
+    std::vector<size_t>& output) const {
+  const Bucket& theBucket = bucket(type);
+  double eta = axis.eta();
+  double phi = axis.phi();
+  if (!isFinite(eta) || !isFinite(phi)) {
+    // Every deltaR is NaN, so nothing can be rejected
+    output.clear();
+    for (size_t i = 0; i < theBucket.candidates.size(); ++i)
+      output.push_back(i);
+    return;
+  }
+  theBucket.index.neighbours(eta, phi, radius, output);
+  if (!theBucket.unindexed.empty()) {
+    output.insert(output.end(),
+        theBucket.unindexed.begin(), theBucket.unindexed.end());
+    std::sort(output.begin(), output.end());
+  }
+}
+
+void PFCandidateIndex::near(reco::PFCandidate::ParticleType type,
+    const reco::Particle::Vector& axis, double radius,
+    std::vector<const reco::PFCandidate*>& output) const {
+  near(type, axis, radius, positions_);
+  const std::vector<const reco::PFCandidate*>& all = candidates(type);
+  output.clear();
+  output.reserve(positions_.size());
+  for (size_t i = 0; i < positions_.size(); ++i)
+    output.push_back(all[positions_[i]]);
+}
+
+void PFCandidateIndex::useVertices(const reco::VertexCollection& vertices,
+    double deltaZ, const reco::BeamSpot& bs) const {
+  if (cachedVertices_ == &vertices && cachedDeltaZ_ == deltaZ &&
+      cachedBeamSpot_ == &bs)
+    return;
+  for (size_t t = 0; t < buckets_.size(); ++t) {
+    std::fill(buckets_[t].vertexDone.begin(),
+        buckets_[t].vertexDone.end(), 0);
+  }
+  if (cachedVertices_ != &vertices)
+    vertexMatcher_.fill(vertices);
+  cachedVertices_ = &vertices;
+  cachedDeltaZ_ = deltaZ;
+  cachedBeamSpot_ = &bs;
+}
+
+const reco::Vertex* PFCandidateIndex::vertex(
+    reco::PFCandidate::ParticleType type, size_t i,
+    const reco::VertexCollection& vertices, double deltaZ,
+    const reco::BeamSpot& bs) const {
+  useVertices(vertices, deltaZ, bs);
+  const Bucket& theBucket = bucket(type);
+  if (!theBucket.vertexDone.at(i)) {
+    reco::TrackRef track = theBucket.candidates[i]->trackRef();
+    theBucket.vertices[i] = track.isNonnull() ?
+      findVertex(track.get(), vertexMatcher_, deltaZ, bs) : 0;
+    theBucket.vertexDone[i] = 1;
+  }
+  return theBucket.vertices[i];
+}
+
+const reco::Vertex* PFCandidateIndex::trackVertex(const reco::Track* track,
+    const reco::VertexCollection& vertices, double deltaZ,
+    const reco::BeamSpot& bs) const {
+  useVertices(vertices, deltaZ, bs);
+  return findVertex(track, vertexMatcher_, deltaZ, bs);
+}
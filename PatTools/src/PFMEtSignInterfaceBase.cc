@@ -3,16 +3,51 @@
 #include "FWCore/Utilities/interface/Exception.h"
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 
-#include "RecoMET/METAlgorithms/interface/significanceAlgo.h"
-
-#include <TMath.h>
-#include <TVectorD.h>
+#include <cmath>
 
 const double defaultPFMEtResolutionX = 10.;
 const double defaultPFMEtResolutionY = 10.;
 
 const double epsilon = 1.e-9;
 
+namespace {
+  // Closed form eigen-decomposition of the symmetric 2x2 matrix [cov].
+  // The eigenvalues are sorted in decreasing order, and the (normalized)
+  // eigenvectors are stored in the columns of [eigenVectors], as for
+  // TMatrixD::EigenVectors.
+  void eigenDecomposition(const PFMEtSignInterfaceBase::Covariance& cov,
+			  double eigenValues[2], double eigenVectors[2][2])
+  {
+    double mean = 0.5*(cov(0,0) + cov(1,1));
+    double halfDiff = 0.5*(cov(0,0) - cov(1,1));
+    double root = std::sqrt(halfDiff*halfDiff + cov(0,1)*cov(0,1));
+    eigenValues[0] = mean + root;
+    eigenValues[1] = mean - root;
+    // Take the eigenvector from the row which avoids the cancellation
+    double x = 1.;
+    double y = 0.;
+    if ( halfDiff >= 0. ) {
+      x = halfDiff + root;
+      y = cov(0,1);
+    } else {
+      x = cov(0,1);
+      y = root - halfDiff;
+    }
+    double norm = std::sqrt(x*x + y*y);
+    if ( norm > 0. ) {
+      x /= norm;
+      y /= norm;
+    } else {
+      x = 1.;
+      y = 0.;
+    }
+    eigenVectors[0][0] = x;
+    eigenVectors[1][0] = y;
+    eigenVectors[0][1] = -y;
+    eigenVectors[1][1] = x;
+  }
+}
+
 PFMEtSignInterfaceBase::PFMEtSignInterfaceBase(const edm::ParameterSet& cfg)
   : pfMEtResolution_(0)
 {
@@ -27,20 +62,20 @@ PFMEtSignInterfaceBase::~PFMEtSignInterfaceBase()
   delete pfMEtResolution_;
 }
 
-TMatrixD PFMEtSignInterfaceBase::operator()(const std::list<const reco::Candidate*>& particles) const
+PFMEtSignInterfaceBase::Covariance PFMEtSignInterfaceBase::operator()(const std::vector<const reco::Candidate*>& particles) const
 {
   if ( this->verbosity_ ) {
     std::cout << "<PFMEtSignInterfaceBase::operator()>:" << std::endl;
     std::cout << " particles: entries = " << particles.size() << std::endl;
   }
 
-  std::vector<metsig::SigInputObj> pfMEtSignObjects;
-  addPFMEtSignObjects(pfMEtSignObjects, particles);
+  pfMEtSignObjects_.clear();
+  addPFMEtSignObjects(pfMEtSignObjects_, particles);
 
-  return this->operator()(pfMEtSignObjects);
+  return this->operator()(pfMEtSignObjects_);
 }
 
-TMatrixD PFMEtSignInterfaceBase::operator()(const std::vector<metsig::SigInputObj>& pfMEtSignObjects) const
+PFMEtSignInterfaceBase::Covariance PFMEtSignInterfaceBase::operator()(const std::vector<metsig::SigInputObj>& pfMEtSignObjects) const
 {
   if ( this->verbosity_ ) {
     std::cout << "<PFMEtSignInterfaceBase::operator()>:" << std::endl;
@@ -54,44 +89,58 @@ TMatrixD PFMEtSignInterfaceBase::operator()(const std::vector<metsig::SigInputOb
 		<< " phi = " << pfMEtSignObject->get_phi() << " --> dpt = " << pfMEtSignObject->get_sigma_e() << std::endl;
       dpt2Sum += pfMEtSignObject->get_sigma_e();
     }
-    std::cout << "--> sqrt(sum(dpt^2)) = " << TMath::Sqrt(dpt2Sum) << std::endl;
+    std::cout << "--> sqrt(sum(dpt^2)) = " << std::sqrt(dpt2Sum) << std::endl;
   }
 
-  TMatrixD pfMEtCov(2,2);
+  // Symmetric, so (0,1) and (1,0) are the same element
+  Covariance pfMEtCov;
   if ( pfMEtSignObjects.size() >= 2 ) {
-    metsig::significanceAlgo pfMEtSignAlgorithm;
-    pfMEtSignAlgorithm.addObjects(pfMEtSignObjects);
-    pfMEtCov = pfMEtSignAlgorithm.getSignifMatrix();
+//--- sum the resolution of each object, rotated from its (pt, phi) frame
+//    into x-y, as in metsig::significanceAlgo::addObjects
+    double cov00 = 0.;
+    double cov01 = 0.;
+    double cov11 = 0.;
+    for ( std::vector<metsig::SigInputObj>::const_iterator pfMEtSignObject = pfMEtSignObjects.begin();
+	  pfMEtSignObject != pfMEtSignObjects.end(); ++pfMEtSignObject ) {
+      double phi = pfMEtSignObject->get_phi();
+      double cosphi = std::cos(phi);
+      double sinphi = std::sin(phi);
+      double sigma0_2 = pfMEtSignObject->get_sigma_e()*pfMEtSignObject->get_sigma_e();
+      double sigma1_2 = pfMEtSignObject->get_sigma_tan()*pfMEtSignObject->get_sigma_tan();
+      cov00 += sigma0_2*cosphi*cosphi + sigma1_2*sinphi*sinphi;
+      cov01 += cosphi*sinphi*(sigma0_2 - sigma1_2);
+      cov11 += sigma1_2*cosphi*cosphi + sigma0_2*sinphi*sinphi;
+    }
+    pfMEtCov(0,0) = cov00;
+    pfMEtCov(0,1) = cov01;
+    pfMEtCov(1,1) = cov11;
 
-    if ( this->verbosity_ && TMath::Abs(pfMEtCov.Determinant()) > epsilon ) {
-      TVectorD eigenValues(2);
-      TMatrixD eigenVectors = pfMEtCov.EigenVectors(eigenValues);
+    double det = cov00*cov11 - cov01*cov01;
+
+    if ( this->verbosity_ && std::fabs(det) > epsilon ) {
+      double eigenValues[2];
+      double eigenVectors[2][2];
+      eigenDecomposition(pfMEtCov, eigenValues, eigenVectors);
       // CV: eigenvectors are stored in columns
       //     and are sorted such that the one corresponding to the highest eigenvalue is in the **first** column
       for ( unsigned iEigenVector = 0; iEigenVector < 2; ++iEigenVector ) {
-	std::cout << "eigenVector #" << iEigenVector << " (eigenValue = " << eigenValues(iEigenVector) << "):"
-		  << " x = " << eigenVectors(0, iEigenVector) << ", y = " << eigenVectors(1, iEigenVector) << std::endl;
+	std::cout << "eigenVector #" << iEigenVector << " (eigenValue = " << eigenValues[iEigenVector] << "):"
+		  << " x = " << eigenVectors[0][iEigenVector] << ", y = " << eigenVectors[1][iEigenVector] << std::endl;
       }
     }
 
 //--- substitute (PF)MEt resolution matrix by default values
 //    in case resolution matrix cannot be inverted
-    if ( TMath::Abs(pfMEtCov.Determinant()) < epsilon ) {
+    if ( std::fabs(det) < epsilon ) {
       edm::LogWarning("PFMEtSignInterfaceBase::operator()")
-	<< "Inversion of PFMEt covariance matrix failed, det = " << pfMEtCov.Determinant()
+	<< "Inversion of PFMEt covariance matrix failed, det = " << det
 	<< " --> replacing covariance matrix by resolution defaults !!";
       pfMEtCov(0,0) = (defaultPFMEtResolutionX*defaultPFMEtResolutionX);
       pfMEtCov(0,1) = 0.;
-      pfMEtCov(1,0) = 0.;
       pfMEtCov(1,1) = (defaultPFMEtResolutionY*defaultPFMEtResolutionY);
     }
-  } else {
-    pfMEtCov(0,0) = 0.;
-    pfMEtCov(0,1) = 0.;
-    pfMEtCov(1,0) = 0.;
-    pfMEtCov(1,1) = 0.;
   }
+  // SMatrix is zero-initialized, so fewer than two objects give zeros
 
   return pfMEtCov;
 }
-
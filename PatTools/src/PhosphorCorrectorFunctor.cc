@@ -12,10 +12,13 @@ namespace zgamma {
 
 PhosphorCorrectionFunctor::PhosphorCorrectionFunctor(){
 
+  rand = 0;
+  ClearTable();
 }//default constructor
 PhosphorCorrectionFunctor::PhosphorCorrectionFunctor(const char* filename){
 
   rand = new TRandom3(0);
+  ClearTable();
   this->MapCat();
   //this->MapFile.ifstream(filename);
   if( !SetMapFileName(filename) ){
@@ -32,6 +35,7 @@ PhosphorCorrectionFunctor::PhosphorCorrectionFunctor(const char* filename){
 PhosphorCorrectionFunctor::PhosphorCorrectionFunctor(const char* filename, bool R9Cat){
   
   rand = new TRandom3(0);
+  ClearTable();
   this->MapCat();
   //this->MapFile.ifstream(filename);
   if( !SetMapFileName(filename) ){
@@ -82,7 +86,7 @@ bool PhosphorCorrectionFunctor::CreateMap(){
   double corrNumber;
   MapFile.open(filename);
   std::string line;
-  std::string KeyMap;
+  R9Table = false;
   if(  MapFile.is_open() ){
     getline (MapFile, line);
     //getline (MapFile, line);
@@ -90,11 +94,10 @@ bool PhosphorCorrectionFunctor::CreateMap(){
     while( MapFile.good() ){
      
       if( MapFile.eof() )break;
-      MapFile >> year >> dataType >> detType >> ptBin >> corrType >> corrNumber;
+      if( !(MapFile >> year >> dataType >> detType >> ptBin >> corrType >> corrNumber) )break;
       
-      KeyMap =  CreateMapKey( year, dataType, detType, corrType, ptBin);
-      std::cout << "MAP Key: " << KeyMap << std::endl;
-      CorrMap[KeyMap] = corrNumber;
+      std::cout << "MAP Key: " << year << dataType << detType << corrType << ptBin << std::endl;
+      FillTable( year, dataType, detType, 0, corrType, ptBin, corrNumber, 0.);
     }
 
   }else{
@@ -102,7 +105,7 @@ bool PhosphorCorrectionFunctor::CreateMap(){
     return false;
   }
   
-  if( CorrMap.size() == 64) { 
+  if( TableEntries == 64) { 
     return true;
   }else{
     return false;
@@ -117,7 +120,7 @@ bool PhosphorCorrectionFunctor::CreateMap(bool R9Cat){
   double corrNumber, Err;
   MapFile.open(filename);
   std::string line;
-  std::string KeyMap;
+  R9Table = true;
   if(  MapFile.is_open() ){
     getline (MapFile, line);
     //getline (MapFile, line);
@@ -125,12 +128,9 @@ bool PhosphorCorrectionFunctor::CreateMap(bool R9Cat){
     while( MapFile.good() ){
      
       if( MapFile.eof() )break;
-      MapFile >> year >> dataType >> detType >> r9Cat >> ptBin >> corrType >> corrNumber >> Err;
+      if( !(MapFile >> year >> dataType >> detType >> r9Cat >> ptBin >> corrType >> corrNumber >> Err) )break;
       
-      KeyMap =  CreateMapKey( year, dataType, detType, r9Cat, corrType, ptBin);
-      //std::cout << "MAP Key: " << KeyMap << std::endl;
-      CorrMap[KeyMap] = corrNumber;
-      ErrMap[KeyMap] = Err;
+      FillTable( year, dataType, detType, r9Cat, corrType, ptBin, corrNumber, Err);
     }
 
   }else{
@@ -138,8 +138,8 @@ bool PhosphorCorrectionFunctor::CreateMap(bool R9Cat){
     return false;
   }
   
-  std::cout << "[INFO]--> MAP SIZE: " << CorrMap.size() << std::endl;
-  if( CorrMap.size() == 128) { 
+  std::cout << "[INFO]--> MAP SIZE: " << TableEntries << std::endl;
+  if( TableEntries == 128) { 
     return true;
   }else{
     return false;
@@ -149,26 +149,63 @@ bool PhosphorCorrectionFunctor::CreateMap(bool R9Cat){
 
 
 
-std::string PhosphorCorrectionFunctor:: CreateMapKey(int Year, int DataType, int DetType, int CorrType, int PtBin){
-  
-  stringstream ss;
-  
-  ss << Year << DataType << DetType  << CorrType << PtBin;
+void PhosphorCorrectionFunctor::ClearTable(){
+
+  for(int i = 0; i < nTableCells; i++){
+    CorrTable[i] = 0.;
+    ErrTable[i] = 0.;
+    InTable[i] = false;
+  }
+  TableEntries = 0;
+  R9Table = false;
 
-  return ss.str();
-  
-  
 }
 
-std::string PhosphorCorrectionFunctor:: CreateMapKey(int Year, int DataType, int DetType, int R9Cat, int CorrType, int PtBin){
-  
-  stringstream ss;
-  
-  ss << Year << DataType << DetType  << R9Cat << CorrType << PtBin;
+int PhosphorCorrectionFunctor::TableCell(int Year, int DataType, int DetType, int R9Cat, int CorrType, int PtBin) const{
+
+  if( Year < 0 || Year >= nYears ) return -1;
+  if( DataType < 0 || DataType >= nDataTypes ) return -1;
+  if( DetType < 0 || DetType >= nDetTypes ) return -1;
+  if( R9Cat < 0 || R9Cat >= nR9Cats ) return -1;
+  if( CorrType < 0 || CorrType >= nCorrTypes ) return -1;
+  if( PtBin < 0 || PtBin >= nPtBins ) return -1;
+
+  return ((((Year*nDataTypes + DataType)*nDetTypes + DetType)*nR9Cats + R9Cat)*nCorrTypes + CorrType)*nPtBins + PtBin;
+
+}
+
+void PhosphorCorrectionFunctor::FillTable(int Year, int DataType, int DetType, int R9Cat, int CorrType, int PtBin, double Corr, double Err){
+
+  int cell = TableCell( Year, DataType, DetType, R9Cat, CorrType, PtBin);
+  if( cell < 0 ){
+    std::cout << "[INFO]--> MAP FILE entry out of range, skipped: " << Year << " " << DataType << " " << DetType << " "
+              << R9Cat << " " << PtBin << " " << CorrType << std::endl;
+    return;
+  }
+  if( !InTable[cell] ) TableEntries++;
+  CorrTable[cell] = Corr;
+  ErrTable[cell] = Err;
+  InTable[cell] = true;
+
+}
+
+int PhosphorCorrectionFunctor::TableIndex(int Year, int DataType, int DetType, int CorrType, int PtBin) const{
+
+  //Inclusive entries only exist in a table read without R9 categories
+  if( R9Table ) return -1;
+  int cell = TableCell( Year, DataType, DetType, 0, CorrType, PtBin);
+  if( cell < 0 || !InTable[cell] ) return -1;
+  return cell;
+
+}
+
+int PhosphorCorrectionFunctor::TableIndex(int Year, int DataType, int DetType, int R9Cat, int CorrType, int PtBin) const{
+
+  if( !R9Table ) return -1;
+  int cell = TableCell( Year, DataType, DetType, R9Cat, CorrType, PtBin);
+  if( cell < 0 || !InTable[cell] ) return -1;
+  return cell;
 
-  return ss.str();
-  
-  
 }
 
 
@@ -196,12 +233,11 @@ double PhosphorCorrectionFunctor::GetScaleCorr(int year, double pt, double eta){
   }
   
   //std::cout << "debug2: " << year << " " << dataType  << " " << detType  << " " << corrType << " " << ptBin <<  std::endl;
-  string KeyMap =  CreateMapKey( year, dataType, detType, corrType, ptBin);
-  //std::cout << "debug2: " << KeyMap << std::endl;
+  int index =  TableIndex( year, dataType, detType, corrType, ptBin);
 
-  if( CorrMap.find(KeyMap) == CorrMap.end() )return -999.;
+  if( index < 0 )return -999.;
   
-  return CorrMap[KeyMap];
+  return CorrTable[index];
 
 }
 
@@ -237,29 +273,26 @@ double PhosphorCorrectionFunctor::GetCorrEnergyMC(int year, double pt, double et
     ptBin = Pt3;
   }
   //if(pt>10 && pt <12)std::cout << "blah" << year << std::endl;
-  string KeyMap_Smc =  CreateMapKey( year, 0, detType, 0, ptBin);// CreateMapKey( year, dataType, detType, corrType, ptBin);MC=0 && Scale==0
-  string KeyMap_Rmc =  CreateMapKey( year, 0, detType, 1, ptBin);//MC=0 && Resolution==1
-  string KeyMap_Rdata =  CreateMapKey( year, 1, detType, 1, ptBin);//Data=1 && Resolution==1
-  std::map<std::string, double>::iterator it_Smc = CorrMap.find(KeyMap_Smc);
-  std::map<std::string, double>::iterator it_Rmc = CorrMap.find(KeyMap_Rmc);
-  std::map<std::string, double>::iterator it_Rdata = CorrMap.find(KeyMap_Rdata);
-
-  if( it_Smc == CorrMap.end() ){
+  int index_Smc =  TableIndex( year, 0, detType, 0, ptBin);// TableIndex( year, dataType, detType, corrType, ptBin);MC=0 && Scale==0
+  int index_Rmc =  TableIndex( year, 0, detType, 1, ptBin);//MC=0 && Resolution==1
+  int index_Rdata =  TableIndex( year, 1, detType, 1, ptBin);//Data=1 && Resolution==1
+
+  if( index_Smc < 0 ){
     std::cout << "[INFO]-->Scale MC NOT found on the MAP, correction not applied" << "Pt = "  << pt << " eta = " << etaReco << std::endl;
     return ETtoE( pt, etaReco);
     
-  }else if( it_Rmc == CorrMap.end() ){
+  }else if( index_Rmc < 0 ){
     std::cout << "[INFO]-->Resolution MC NOT found on the MAP, correction not applied" << std::endl;
     return ETtoE( pt, etaReco);
     
-  }else if( it_Rdata == CorrMap.end() ){
+  }else if( index_Rdata < 0 ){
     std::cout << "[INFO]-->Resolution data NOT found on the MAP, correction not applied" << std::endl;
     return ETtoE( pt, etaReco);
   }else{
     //Actually now we apply the correction
-    double Smc = 0.01*((*it_Smc).second) ;//Converting into number from %
-    double Rmc = (*it_Rmc).second;
-    double Rdata = (*it_Rdata).second;
+    double Smc = 0.01*CorrTable[index_Smc] ;//Converting into number from %
+    double Rmc = CorrTable[index_Rmc];
+    double Rdata = CorrTable[index_Rdata];
     double E = ETtoE( pt, etaReco);
     double X_mc = E/Egen -1.0;
     double X_corr = (Rdata/Rmc)*( X_mc - Smc );
@@ -311,29 +344,26 @@ double PhosphorCorrectionFunctor::GetCorrEnergyMC(float R9, int year, double pt,
     r9Cat = 0;//Inclusive Category
   }
   //if(pt>10 && pt <12)std::cout << "blah" << year << std::endl;
-  string KeyMap_Smc =  CreateMapKey( year, 0, detType, r9Cat, 0, ptBin);// CreateMapKey( year, dataType, detType, corrType, ptBin);MC=0 && Scale==0
-  string KeyMap_Rmc =  CreateMapKey( year, 0, detType, r9Cat, 1, ptBin);//MC=0 && Resolution==1
-  string KeyMap_Rdata =  CreateMapKey( year, 1, detType, r9Cat, 1, ptBin);//Data=1 && Resolution==1
-  std::map<std::string, double>::iterator it_Smc = CorrMap.find(KeyMap_Smc);
-  std::map<std::string, double>::iterator it_Rmc = CorrMap.find(KeyMap_Rmc);
-  std::map<std::string, double>::iterator it_Rdata = CorrMap.find(KeyMap_Rdata);
-  
-  if( it_Smc == CorrMap.end() ){
+  int index_Smc =  TableIndex( year, 0, detType, r9Cat, 0, ptBin);// TableIndex( year, dataType, detType, r9Cat, corrType, ptBin);MC=0 && Scale==0
+  int index_Rmc =  TableIndex( year, 0, detType, r9Cat, 1, ptBin);//MC=0 && Resolution==1
+  int index_Rdata =  TableIndex( year, 1, detType, r9Cat, 1, ptBin);//Data=1 && Resolution==1
+  
+  if( index_Smc < 0 ){
     std::cout << "[INFO]-->Scale MC NOT found on the MAP, correction not applied" << "Pt = "  << pt << " eta = " << etaReco << std::endl;
     return ETtoE( pt, etaReco);
     
-  }else if( it_Rmc == CorrMap.end() ){
+  }else if( index_Rmc < 0 ){
     std::cout << "[INFO]-->Resolution MC NOT found on the MAP, correction not applied" << std::endl;
     return ETtoE( pt, etaReco);
     
-  }else if( it_Rdata == CorrMap.end() ){
+  }else if( index_Rdata < 0 ){
     std::cout << "[INFO]-->Resolution data NOT found on the MAP, correction not applied" << std::endl;
     return ETtoE( pt, etaReco);
   }else{
     //Actually now we apply the correction
-    double Smc = 0.01*((*it_Smc).second) ;//Converting into number from %
-    double Rmc = (*it_Rmc).second;
-    double Rdata = (*it_Rdata).second;
+    double Smc = 0.01*CorrTable[index_Smc] ;//Converting into number from %
+    double Rmc = CorrTable[index_Rmc];
+    double Rdata = CorrTable[index_Rdata];
     double E = ETtoE( pt, etaReco);
     double X_mc = E/Egen -1.0;
     double X_corr = (Rdata/Rmc)*( X_mc - Smc );
@@ -377,14 +407,13 @@ double PhosphorCorrectionFunctor::GetCorrEnergyData(int year, double pt, double
   
 
   // std::cout << "debug2: " << year << " " << dataType  << " " << detType  << " " << corrType << " " << ptBin <<  std::endl;
-  string KeyMap =  CreateMapKey( year, dataType, detType, corrType, ptBin);
-  //std::cout << "debug2: " << KeyMap << std::endl;
+  int index =  TableIndex( year, dataType, detType, corrType, ptBin);
   
-  if( CorrMap.find(KeyMap) == CorrMap.end() ){
+  if( index < 0 ){
     std::cout << "[INFO]-->Scale Data Not found, No correction applied. PT:  " << pt <<std::endl;
     return ETtoE( pt, etaReco);
   }else{
-    double Sdata = 0.01*CorrMap[KeyMap];//Converting into number from %
+    double Sdata = 0.01*CorrTable[index];//Converting into number from %
     if(Sdata != -1.0){//avoid division by zero
       //std::cout << "Sdata: " << Sdata << std::endl;
       return  ETtoE( pt, etaReco)/(1.0 + Sdata);
@@ -436,14 +465,13 @@ double PhosphorCorrectionFunctor::GetCorrEnergyData(float R9, int year, double p
   }
 
   // std::cout << "debug2: " << year << " " << dataType  << " " << detType  << " " << corrType << " " << ptBin <<  std::endl;
-  string KeyMap =  CreateMapKey( year, dataType, detType, r9Cat, corrType, ptBin);
-  //std::cout << "debug2: " << KeyMap << std::endl;
+  int index =  TableIndex( year, dataType, detType, r9Cat, corrType, ptBin);
   
-  if( CorrMap.find(KeyMap) == CorrMap.end() ){
+  if( index < 0 ){
     std::cout << "[INFO]-->Scale Data Not found, No correction applied. PT:  " << pt <<std::endl;
     return ETtoE( pt, etaReco);
   }else{
-    double Sdata = 0.01*CorrMap[KeyMap];//Converting into number from %
+    double Sdata = 0.01*CorrTable[index];//Converting into number from %
     if(Sdata != -1.0){//avoid division by zero
       //std::cout << "Sdata: " << Sdata << std::endl;
       return  ETtoE( pt, etaReco)/(1.0 + Sdata);
@@ -487,14 +515,13 @@ double PhosphorCorrectionFunctor::GetCorrEnergy(int year, double pt, double etaR
   }
   
   // std::cout << "debug2: " << year << " " << dataType  << " " << detType  << " " << corrType << " " << ptBin <<  std::endl;
-  string KeyMap =  CreateMapKey( year, dataType, detType, corrType, ptBin);
-  //std::cout << "debug2: " << KeyMap << std::endl;
+  int index =  TableIndex( year, dataType, detType, corrType, ptBin);
   
-  if( CorrMap.find(KeyMap) == CorrMap.end() ){
+  if( index < 0 ){
     std::cout << "[INFO]-->Scale Data Not found, No correction applied. PT:  " << pt << std::endl;
     return ETtoE( pt, etaReco);
   }else{
-    double Sdata = 0.01*CorrMap[KeyMap];//Converting into number from %
+    double Sdata = 0.01*CorrTable[index];//Converting into number from %
     if(Sdata != -1.0){//avoid division by zero
       //std::cout << "Sdata: " << Sdata << std::endl;
       return  ETtoE( pt, etaReco)/(1.0 + Sdata);
@@ -615,13 +642,13 @@ int PhosphorCorrectionFunctor::GetCategory(float R9, int year, double pt, double
   
   std::cout << "C0: " << cat_in[0] << " C1: " << cat_in[1] << " C2: " << cat_in[2] << " C3: " << cat_in[3] << std::endl;
 
-  string KeyMap_Smc =  CreateMapKey( cat_in[1], 0, cat_in[3], cat_in[0], 0, cat_in[2]);// CreateMapKey( year, dataType, detType, corrType, ptBin);MC=0 && Scale==0
-  string KeyMap_Rmc =  CreateMapKey( cat_in[1], 0, cat_in[3], cat_in[0], 1, cat_in[2]);//MC=0 && Resolution==1
-  string KeyMap_Rdata =  CreateMapKey( cat_in[1], 1, cat_in[3], cat_in[0], 1, cat_in[2]);//Data=1 && Resolution==1
+  int index_Smc =  TableIndex( cat_in[1], 0, cat_in[3], cat_in[0], 0, cat_in[2]);// TableIndex( year, dataType, detType, r9Cat, corrType, ptBin);MC=0 && Scale==0
+  int index_Rmc =  TableIndex( cat_in[1], 0, cat_in[3], cat_in[0], 1, cat_in[2]);//MC=0 && Resolution==1
+  int index_Rdata =  TableIndex( cat_in[1], 1, cat_in[3], cat_in[0], 1, cat_in[2]);//Data=1 && Resolution==1
 
-  float SmcErr = ErrMap[KeyMap_Smc];
-  float Rmc = CorrMap[KeyMap_Rmc];
-  float Rdata = CorrMap[KeyMap_Rdata];
+  float SmcErr = TableErr(index_Smc);
+  float Rmc = TableCorr(index_Rmc);
+  float Rdata = TableCorr(index_Rdata);
 
   std::cout << "SmcErr: " << SmcErr << " Rmc: " << Rmc << " Rdata: " << Rdata << " factor: " << sqrt( ScaleError*ScaleError + pow( 0.01*Rdata*SmcErr/Rmc, 2 ) ) << std::endl;
   std::cout << "SmcErr: " << SmcErr << " Rmc: " << Rmc << " Rdata: " << Rdata << " factor: " << sqrt( pow( 0.01*Rdata*SmcErr/Rmc, 2 ) ) << std::endl;
@@ -643,10 +670,10 @@ pair <int,double> PhosphorCorrectionFunctor::ResEnError(float R9, int year, doub
   
   std::cout << "C0: " << cat_in[0] << " C1: " << cat_in[1] << " C2: " << cat_in[2] << " C3: " << cat_in[3] << std::endl;
 
-  string KeyMap_Rmc =  CreateMapKey( cat_in[1], 0, cat_in[3], cat_in[0], 1, cat_in[2]);//MC=0 && Resolution==1
+  int index_Rmc =  TableIndex( cat_in[1], 0, cat_in[3], cat_in[0], 1, cat_in[2]);//MC=0 && Resolution==1
 
-  float Rmc = CorrMap[KeyMap_Rmc];
-  float ErrRmc = ErrMap[KeyMap_Rmc];
+  float Rmc = TableCorr(index_Rmc);
+  float ErrRmc = TableErr(index_Rmc);
 
   std::cout << "Rmc: " << Rmc << " ErrRmc: " << ErrRmc << " factor: " << sqrt( SigR_over_R*SigR_over_R + pow( ErrRmc/Rmc, 2 ) ) << std::endl;
   std::cout << "Rmc: " << Rmc << " ErrRmc: " << ErrRmc << " factor: " << sqrt( pow( ErrRmc/Rmc, 2 ) ) << std::endl;
@@ -666,16 +693,17 @@ double PhosphorCorrectionFunctor::ScaleEnError(float R9, int year, double pt, do
   c_in = CatIndex(R9, year, pt, etaReco);//cat[0]=R9,cat[1]=year, cat[2]=pt, cat[3]=det//Same order as arguments passed
   
   int cat_in[4] = {*c_in,*(c_in+1),*(c_in+2),*(c_in+3)};
+  delete [] c_in;
   
   //std::cout << "C0: " << cat_in[0] << " C1: " << cat_in[1] << " C2: " << cat_in[2] << " C3: " << cat_in[3] << std::endl;
   
-  string KeyMap_Smc =  CreateMapKey( cat_in[1], 0, cat_in[3], cat_in[0], 0, cat_in[2]);// CreateMapKey( year, dataType, detType, corrType, ptBin);MC=0 && Scale==0
-  string KeyMap_Rmc =  CreateMapKey( cat_in[1], 0, cat_in[3], cat_in[0], 1, cat_in[2]);//MC=0 && Resolution==1
-  string KeyMap_Rdata =  CreateMapKey( cat_in[1], 1, cat_in[3], cat_in[0], 1, cat_in[2]);//Data=1 && Resolution==1
+  int index_Smc =  TableIndex( cat_in[1], 0, cat_in[3], cat_in[0], 0, cat_in[2]);// TableIndex( year, dataType, detType, r9Cat, corrType, ptBin);MC=0 && Scale==0
+  int index_Rmc =  TableIndex( cat_in[1], 0, cat_in[3], cat_in[0], 1, cat_in[2]);//MC=0 && Resolution==1
+  int index_Rdata =  TableIndex( cat_in[1], 1, cat_in[3], cat_in[0], 1, cat_in[2]);//Data=1 && Resolution==1
   
-  float SmcErr = ErrMap[KeyMap_Smc];
-  float Rmc = CorrMap[KeyMap_Rmc];
-  float Rdata = CorrMap[KeyMap_Rdata];
+  float SmcErr = TableErr(index_Smc);
+  float Rmc = TableCorr(index_Rmc);
+  float Rdata = TableCorr(index_Rdata);
   
   //std::cout << "SmcErr: " << SmcErr << " Rmc: " << Rmc << " Rdata: " << Rdata << " factor: " << sqrt( ScaleError*ScaleError + pow( 0.01*Rdata*SmcErr/Rmc, 2 ) ) << std::endl;
   //std::cout << "SmcErr: " << SmcErr << " Rmc: " << Rmc << " Rdata: " << Rdata << " factor: " << sqrt( pow( 0.01*Rdata*SmcErr/Rmc, 2 ) ) << std::endl;
@@ -694,13 +722,14 @@ double PhosphorCorrectionFunctor::ResEnError(float R9, int year, double pt, doub
   c_in = CatIndex(R9, year, pt, etaReco);//cat[0]=R9,cat[1]=year, cat[2]=pt, cat[3]=det//Same order as arguments passed
  
   int cat_in[4] = {*c_in,*(c_in+1),*(c_in+2),*(c_in+3)};
+  delete [] c_in;
   
   //std::cout << "C0: " << cat_in[0] << " C1: " << cat_in[1] << " C2: " << cat_in[2] << " C3: " << cat_in[3] << std::endl;
 
-  string KeyMap_Rmc =  CreateMapKey( cat_in[1], 0, cat_in[3], cat_in[0], 1, cat_in[2]);//MC=0 && Resolution==1
+  int index_Rmc =  TableIndex( cat_in[1], 0, cat_in[3], cat_in[0], 1, cat_in[2]);//MC=0 && Resolution==1
 
-  float Rmc = CorrMap[KeyMap_Rmc];
-  float ErrRmc = ErrMap[KeyMap_Rmc];
+  float Rmc = TableCorr(index_Rmc);
+  float ErrRmc = TableErr(index_Rmc);
 
   //std::cout << "Rmc: " << Rmc << " ErrRmc: " << ErrRmc << " factor: " << sqrt( SigR_over_R*SigR_over_R + pow( ErrRmc/Rmc, 2 ) ) << std::endl;
   //std::cout << "Rmc: " << Rmc << " ErrRmc: " << ErrRmc << " factor: " << sqrt( pow( ErrRmc/Rmc, 2 ) ) << std::endl;
@@ -338,6 +338,12 @@ namespace rochcor {
 
   
   void RochesterCorrections2011::momcor_mc( TLorentzVector& mu, float charge, float sysdev, int runopt, float& qter){
+    double normal;
+    drawNormals(1, &normal);
+    momcor_mc(mu, charge, sysdev, runopt, qter, normal);
+  }
+
+  void RochesterCorrections2011::momcor_mc( TLorentzVector& mu, float charge, float sysdev, int runopt, float& qter, double normal){
     
     //sysdev == num : deviation = num
     
@@ -412,9 +418,9 @@ namespace rochcor {
     
     float momscl = sqrt(px*px + py*py)/ptmu;
     
-    CLHEP::RandGaussQ smear(rng->getEngine(), 1.0, sf + sysdev*sfer);
-
-    float tune = 1.0/(1.0 + (delta + sysdev*deltaer)*sqrt(px*px + py*py)*smear.fire());
+    // the value of a RandGaussQ(engine, 1.0, sf + sysdev*sfer)
+    double smear = normal*(sf + sysdev*sfer) + 1.0;
+    float tune = 1.0/(1.0 + (delta + sysdev*deltaer)*sqrt(px*px + py*py)*smear);
     
     px *= (tune); 
     py *= (tune);  
@@ -489,6 +495,38 @@ void RochesterCorrections2011::momcor_data( TLorentzVector& mu, float charge, fl
   
 }
 
+void RochesterCorrections2011::momcor_mc(size_t n, double* px, double* py, double* pz, double* e,
+				 const float* charge, float sysdev, int runopt, float* qter,
+				 const double* normals){
+  for(size_t i=0; i<n; ++i){
+    TLorentzVector mu(px[i],py[i],pz[i],e[i]);
+    momcor_mc(mu,charge[i],sysdev,runopt,qter[i],normals[i]);
+    px[i] = mu.Px();
+    py[i] = mu.Py();
+    pz[i] = mu.Pz();
+    e[i]  = mu.E();
+  }
+}
+
+void RochesterCorrections2011::momcor_data(size_t n, double* px, double* py, double* pz, double* e,
+				   const float* charge, float sysdev, int runopt, float* qter){
+  for(size_t i=0; i<n; ++i){
+    TLorentzVector mu(px[i],py[i],pz[i],e[i]);
+    momcor_data(mu,charge[i],sysdev,runopt,qter[i]);
+    px[i] = mu.Px();
+    py[i] = mu.Py();
+    pz[i] = mu.Pz();
+    e[i]  = mu.E();
+  }
+}
+
+void RochesterCorrections2011::drawNormals(size_t n, double* output){
+  CLHEP::HepRandomEngine& engine = rng->getEngine();
+  for(size_t i=0; i<n; ++i){
+    output[i] = CLHEP::RandGaussQ::shoot(&engine);
+  }
+}
+
 void RochesterCorrections2011::musclefit_data( TLorentzVector& mu, TLorentzVector& mubar){
 
   float dpar1 = 0.0;
@@ -0,0 +1,322 @@
+#include "FinalStateAnalysis/PatTools/interface/TMVAForest.h"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <sstream>
+
+namespace {
+  // An xml element start or end tag
+  struct Tag {
+    // Closing tags are named "/Name"
+    std::string name;
+    std::map<std::string, std::string> attributes;
+    // Self-closing (<Name ... />)
+    bool closed;
+    // The text between this tag and the next one
+    std::string text;
+  };
+
+  const char* whitespace = " \t\r\n";
+
+  std::string trim(const std::string& input) {
+    size_t begin = input.find_first_not_of(whitespace);
+    if (begin == std::string::npos)
+      return "";
+    size_t end = input.find_last_not_of(whitespace);
+    return input.substr(begin, end - begin + 1);
+  }
+
+  // Read the next tag at or after [pos].  Returns false at the end of the
+  // document, or if it is malformed.
+  bool nextTag(const std::string& xml, size_t& pos, Tag& tag) {
+    size_t begin = xml.find('<', pos);
+    while (begin != std::string::npos && xml.compare(begin, 4, "<!--") == 0) {
+      size_t endComment = xml.find("-->", begin);
+      if (endComment == std::string::npos)
+        return false;
+      begin = xml.find('<', endComment);
+    }
+    if (begin == std::string::npos)
+      return false;
+    // Find the end of the tag, skipping '>' in the attribute values
+    size_t end = begin;
+    bool inQuotes = false;
+    for (; end < xml.size(); ++end) {
+      if (xml[end] == '"')
+        inQuotes = !inQuotes;
+      else if (xml[end] == '>' && !inQuotes)
+        break;
+    }
+    if (end == xml.size())
+      return false;
+
+    tag.closed = (xml[end-1] == '/');
+    size_t stop = tag.closed ? end - 1 : end;
+    size_t nameEnd = std::min(xml.find_first_of(" \t\r\n/>", begin + 2), stop);
+    tag.name = xml.substr(begin + 1, nameEnd - begin - 1);
+
+    tag.attributes.clear();
+    size_t i = nameEnd;
+    while (true) {
+      size_t equals = xml.find('=', i);
+      if (equals == std::string::npos || equals >= stop)
+        break;
+      size_t open = xml.find('"', equals);
+      size_t close = xml.find('"', open + 1);
+      if (open >= stop || close >= stop)
+        return false;
+      tag.attributes[trim(xml.substr(i, equals - i))] =
+        xml.substr(open + 1, close - open - 1);
+      i = close + 1;
+    }
+
+    size_t next = xml.find('<', end);
+    tag.text = trim(xml.substr(end + 1, next - end - 1));
+    pos = end + 1;
+    return true;
+  }
+
+  std::string attribute(const Tag& tag, const std::string& name) {
+    std::map<std::string, std::string>::const_iterator found =
+      tag.attributes.find(name);
+    return found == tag.attributes.end() ? "" : found->second;
+  }
+
+  // Parse the attribute [name] into [value] with a stream, as TMVA does, so
+  // the float attributes are rounded the same way.
+  template<typename T>
+  bool readAttribute(const Tag& tag, const std::string& name, T& value) {
+    std::map<std::string, std::string>::const_iterator found =
+      tag.attributes.find(name);
+    if (found == tag.attributes.end())
+      return false;
+    std::istringstream stream(found->second);
+    stream >> value;
+    return !stream.fail();
+  }
+
+  bool readFile(const std::string& path, std::string& output) {
+    // gzread reads uncompressed files as they are
+    gzFile file = gzopen(path.c_str(), "rb");
+    if (!file)
+      return false;
+    char buffer[16384];
+    int nRead = 0;
+    while ((nRead = gzread(file, buffer, sizeof(buffer))) > 0)
+      output.append(buffer, nRead);
+    gzclose(file);
+    return nRead == 0;
+  }
+
+  // A node as it is read from the file
+  struct XMLNode {
+    int variable;
+    float cut;
+    int cutType;
+    int nodeType;
+    float response;
+    float nSignal;
+    float nBackground;
+    int children[2];
+  };
+}
+
+TMVAForest::TMVAForest():nVariables_(0),gradBoost_(false) {}
+
+void TMVAForest::clear() {
+  nVariables_ = 0;
+  gradBoost_ = false;
+  nodes_.clear();
+  roots_.clear();
+  treeWeights_.clear();
+}
+
+bool TMVAForest::load(const std::string& path,
+    const std::vector<std::string>& variables) {
+  clear();
+  std::string xml;
+  if (!readFile(path, xml))
+    return false;
+
+  std::string boostType = "AdaBoost";
+  std::string varTransform = "None";
+  bool useYesNoLeaf = true;
+  bool useWeightedTrees = true;
+  bool regressionTrees = false;
+  std::vector<std::string> fileVariables;
+
+  std::vector<XMLNode> xmlNodes;
+  std::vector<size_t> xmlRoots;
+  std::vector<double> boostWeights;
+  // The open <Node> elements
+  std::vector<size_t> parents;
+
+  size_t pos = 0;
+  Tag tag;
+  while (nextTag(xml, pos, tag)) {
+    if (tag.name == "MethodSetup") {
+      if (attribute(tag, "Method").compare(0, 5, "BDT::") != 0)
+        return false;
+    } else if (tag.name == "Option") {
+      std::string name = attribute(tag, "name");
+      if (name == "BoostType")
+        boostType = tag.text;
+      else if (name == "VarTransform")
+        varTransform = tag.text;
+      else if (name == "UseYesNoLeaf")
+        useYesNoLeaf = (tag.text == "True");
+      else if (name == "UseWeightedTrees")
+        useWeightedTrees = (tag.text == "True");
+    } else if (tag.name == "Transformations") {
+      int nTransformations = 0;
+      readAttribute(tag, "NTransformations", nTransformations);
+      if (nTransformations != 0)
+        return false;
+    } else if (tag.name == "Variable") {
+      size_t index = 0;
+      if (!readAttribute(tag, "VarIndex", index))
+        return false;
+      if (fileVariables.size() <= index)
+        fileVariables.resize(index + 1);
+      fileVariables[index] = attribute(tag, "Expression");
+    } else if (tag.name == "Weights") {
+      int treeType = 0;
+      readAttribute(tag, "TreeType", treeType);
+      // Types::kRegression
+      regressionTrees = (treeType == 1);
+    } else if (tag.name == "BinaryTree") {
+      double boostWeight = 0;
+      if (!readAttribute(tag, "boostWeight", boostWeight))
+        return false;
+      boostWeights.push_back(boostWeight);
+      xmlRoots.push_back(xmlNodes.size());
+      parents.clear();
+    } else if (tag.name == "Node") {
+      if (xmlRoots.empty())
+        return false;
+      XMLNode node;
+      node.children[0] = node.children[1] = -1;
+      if (!readAttribute(tag, "IVar", node.variable) ||
+          !readAttribute(tag, "Cut", node.cut) ||
+          !readAttribute(tag, "cType", node.cutType) ||
+          !readAttribute(tag, "nType", node.nodeType))
+        return false;
+      node.response = 0;
+      node.nSignal = node.nBackground = 0;
+      readAttribute(tag, "res", node.response);
+      readAttribute(tag, "nS", node.nSignal);
+      readAttribute(tag, "nB", node.nBackground);
+      // Fisher cuts
+      int nCoefficients = 0;
+      readAttribute(tag, "NCoef", nCoefficients);
+      if (nCoefficients != 0)
+        return false;
+
+      size_t index = xmlNodes.size();
+      std::string position = attribute(tag, "pos");
+      if (!parents.empty()) {
+        if (position != "l" && position != "r")
+          return false;
+        xmlNodes[parents.back()].children[position == "r"] = index;
+      } else if (index != xmlRoots.back()) {
+        return false;
+      }
+      xmlNodes.push_back(node);
+      if (!tag.closed)
+        parents.push_back(index);
+    } else if (tag.name == "/Node") {
+      if (parents.empty())
+        return false;
+      parents.pop_back();
+    }
+  }
+
+  if (fileVariables != variables || varTransform != "None")
+    return false;
+  if (boostType == "Grad")
+    gradBoost_ = true;
+  else if (boostType != "AdaBoost" && boostType != "Bagging")
+    return false;
+  if (xmlRoots.empty())
+    return false;
+
+  nodes_.resize(xmlNodes.size());
+  for (size_t i = 0; i < xmlNodes.size(); ++i) {
+    const XMLNode& xmlNode = xmlNodes[i];
+    Node& node = nodes_[i];
+    if (xmlNode.nodeType == 0) {
+      // Intermediate node
+      if (xmlNode.variable < 0 ||
+          xmlNode.variable >= static_cast<int>(variables.size()) ||
+          xmlNode.children[0] < 0 || xmlNode.children[1] < 0) {
+        clear();
+        return false;
+      }
+      node.variable = xmlNode.variable;
+      node.value = xmlNode.cut;
+      // DecisionTreeNode::GoesRight: go right if the value is at or above
+      // the cut, or if it is not and the cut selects background (cType 0).
+      bool aboveGoesRight = (xmlNode.cutType != 0);
+      node.children[0] = xmlNode.children[!aboveGoesRight];
+      node.children[1] = xmlNode.children[aboveGoesRight];
+    } else {
+      // Leaf, see DecisionTree::CheckEvent
+      node.variable = -1;
+      node.children[0] = node.children[1] = i;
+      if (regressionTrees) {
+        node.value = xmlNode.response;
+      } else if (useYesNoLeaf) {
+        node.value = xmlNode.nodeType;
+      } else {
+        float total = xmlNode.nSignal + xmlNode.nBackground;
+        node.value = total > 0 ? xmlNode.nSignal / total : -1;
+      }
+    }
+  }
+
+  nVariables_ = variables.size();
+  roots_.assign(xmlRoots.begin(), xmlRoots.end());
+  if (gradBoost_ || !useWeightedTrees)
+    treeWeights_.assign(roots_.size(), 1.0);
+  else
+    treeWeights_ = boostWeights;
+  return true;
+}
+
+double TMVAForest::evaluate(const float* inputs) const {
+  double output = 0;
+  evaluate(1, inputs, &output);
+  return output;
+}
+
+void TMVAForest::evaluate(size_t n, const float* inputs,
+    double* output) const {
+  std::fill(output, output + n, 0.0);
+  double norm = 0;
+  // Run each tree over all the objects, so the tree stays in the cache.
+  // Each object still sums the trees in order.
+  for (size_t t = 0; t < roots_.size(); ++t) {
+    double weight = treeWeights_[t];
+    norm += weight;
+    for (size_t i = 0; i < n; ++i) {
+      const float* values = inputs + i*nVariables_;
+      const Node* node = &nodes_[roots_[t]];
+      while (node->variable >= 0)
+        node = &nodes_[node->children[values[node->variable] >= node->value]];
+      output[i] += weight*node->value;
+    }
+  }
+  for (size_t i = 0; i < n; ++i) {
+    if (gradBoost_) {
+      // MethodBDT::GetGradBoostMVA
+      output[i] = 2.0/(1.0 + std::exp(-2.0*output[i])) - 1;
+    } else {
+      output[i] = norm > std::numeric_limits<double>::epsilon() ?
+        output[i]/norm : 0;
+    }
+  }
+}
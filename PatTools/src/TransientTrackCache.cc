@@ -0,0 +1,36 @@
+#include "FinalStateAnalysis/PatTools/interface/TransientTrackCache.h"
+
+#include "DataFormats/GsfTrackReco/interface/GsfTrack.h"
+#include "TrackingTools/TransientTrack/interface/TransientTrackBuilder.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+TransientTrackCache::TransientTrackCache():builder_(0) {}
+
+void TransientTrackCache::reset(const TransientTrackBuilder* builder) {
+  builder_ = builder;
+  tracks_.clear();
+}
+
+const reco::TransientTrack& TransientTrackCache::get(
+    const reco::TrackRef& track) {
+  Key key(track.get(), kTrack);
+  TrackMap::iterator cached = tracks_.find(key);
+  if (cached == tracks_.end()) {
+    if (!builder_)
+      throw cms::Exception("TransientTrackCache") << "No track builder set";
+    cached = tracks_.insert(std::make_pair(key, builder_->build(track))).first;
+  }
+  return cached->second;
+}
+
+const reco::TransientTrack& TransientTrackCache::get(
+    const reco::GsfTrackRef& track) {
+  Key key(track.get(), kGsfTrack);
+  TrackMap::iterator cached = tracks_.find(key);
+  if (cached == tracks_.end()) {
+    if (!builder_)
+      throw cms::Exception("TransientTrackCache") << "No track builder set";
+    cached = tracks_.insert(std::make_pair(key, builder_->build(track))).first;
+  }
+  return cached->second;
+}
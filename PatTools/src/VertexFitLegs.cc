@@ -0,0 +1,45 @@
+#include "FinalStateAnalysis/PatTools/interface/VertexFitLegs.h"
+
+#include "FinalStateAnalysis/DataFormats/interface/PATFinalState.h"
+#include "DataFormats/PatCandidates/interface/Electron.h"
+#include "DataFormats/PatCandidates/interface/Muon.h"
+#include "DataFormats/PatCandidates/interface/Tau.h"
+
+#include <algorithm>
+
+VertexFitLeg vertexFitLeg(const reco::CandidatePtr& cand) {
+  VertexFitLeg output;
+  output.cand = cand;
+  const pat::Muon* muon = dynamic_cast<const pat::Muon*>(cand.get());
+  const pat::Electron* electron = dynamic_cast<const pat::Electron*>(cand.get());
+  const pat::Tau* tau = dynamic_cast<const pat::Tau*>(cand.get());
+  if (muon) {
+    if (muon->innerTrack().isNonnull())
+      output.track = muon->innerTrack();
+  } else if (electron) {
+    if (electron->gsfTrack().isNonnull())
+      output.gsfTrack = electron->gsfTrack();
+  } else if (tau && tau->signalPFChargedHadrCands().size()) {
+    if (tau->signalPFChargedHadrCands()[0]->trackRef().isNonnull())
+      output.track = tau->signalPFChargedHadrCands()[0]->trackRef();
+    else
+      if (tau->signalPFChargedHadrCands()[0]->gsfTrackRef().isNonnull())
+        output.gsfTrack = tau->signalPFChargedHadrCands()[0]->gsfTrackRef();
+  }
+  output.valid = output.track.isNonnull() || output.gsfTrack.isNonnull();
+  return output;
+}
+
+std::vector<VertexFitLeg> vertexFitLegs(const PATFinalState& finalState) {
+  std::vector<VertexFitLeg> output;
+  output.reserve(finalState.numberOfDaughters());
+  for (size_t d = 0; d < finalState.numberOfDaughters(); ++d) {
+    VertexFitLeg leg = vertexFitLeg(finalState.daughterPtr(d));
+    // Make sure all legs have a track
+    if (!leg.valid)
+      return std::vector<VertexFitLeg>();
+    output.push_back(leg);
+  }
+  std::sort(output.begin(), output.end());
+  return output;
+}
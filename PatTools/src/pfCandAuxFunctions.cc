@@ -2,68 +2,143 @@
 
 #include <TMath.h>
 
+#include <cmath>
+
 const double epsilon = 0.01;
 
-std::vector<const reco::PFCandidate*> getPFCandidatesOfType(const reco::PFCandidateCollection& pfCandidates,
-							    reco::PFCandidate::ParticleType pfParticleType)
-{
-  std::vector<const reco::PFCandidate*> retVal;
+namespace {
+  // The (eta, phi) cells of VertexTrackMatcher are twice as wide as the
+  // matching window, so a match is always in one of the 3x3 cells around
+  // the track, whatever the rounding.
+  const double cellSize = 2*epsilon;
 
-  for ( reco::PFCandidateCollection::const_iterator pfCandidate = pfCandidates.begin();
-	pfCandidate != pfCandidates.end(); ++pfCandidate ) {
-    if ( pfCandidate->particleId() == pfParticleType ) retVal.push_back(&(*pfCandidate));
+  // False for NaN and +-inf
+  bool isFinite(double x)
+  {
+    return x - x == 0;
   }
 
-  return retVal;
+  long long cellIndex(double x)
+  {
+    return static_cast<long long>(std::floor(x/cellSize));
+  }
+
+  bool isMatch(double eta, double phi, double pt, const reco::Track* signalTrack)
+  {
+    return ( TMath::Abs(eta - signalTrack->eta()) < epsilon                     &&
+	     TMath::Abs(phi - signalTrack->phi()) < epsilon                     &&
+	     TMath::Abs(pt  - signalTrack->pt())  < (epsilon*signalTrack->pt()) );
+  }
+
+  const reco::Vertex* findClosestVertexInZ(const reco::Track* signalTrack, const reco::VertexCollection& vertices,
+					   const reco::BeamSpot& bs)
+  {
+    const reco::Vertex* retVal = 0;
+    double minDeltaZ = 1.e+3;
+    double refZ = (signalTrack->dz(bs.position()) + bs.position().z());
+    for ( reco::VertexCollection::const_iterator vertex = vertices.begin();
+	  vertex != vertices.end(); ++vertex ) {
+      double deltaZ = TMath::Abs(vertex->z() - refZ);
+      if ( retVal == 0 || deltaZ < minDeltaZ ) {
+	retVal = &(*vertex);
+	minDeltaZ = deltaZ;
+      }
+    }
+
+    //std::cout << "minDeltaZ = " << minDeltaZ << std::endl;
+
+    return retVal;
+  }
 }
 
-void getPileUpPFCandidates(const std::vector<const reco::PFCandidate*>& pfCandidates,
-			   const std::vector<const reco::Track*>& signalTracks,
-			   const reco::VertexCollection& vertices, double deltaZ, const reco::BeamSpot& bs,
-			   std::vector<const reco::PFCandidate*>& pfNoPileUpCandidates,
-			   std::vector<const reco::PFCandidate*>& pfPileUpCandidates)
+VertexTrackMatcher::VertexTrackMatcher()
+  : vertices_(0)
+{}
+
+VertexTrackMatcher::VertexTrackMatcher(const reco::VertexCollection& vertices)
+  : vertices_(0)
 {
-  std::vector<const reco::Vertex*> signalVertices;
-  for ( std::vector<const reco::Track*>::const_iterator signalTrack = signalTracks.begin();
-	signalTrack != signalTracks.end(); ++signalTrack ) {
-    const reco::Vertex* signalVertex = findVertex(*signalTrack, vertices, deltaZ, bs);
-    //std::cout << "signalVertex = " << signalVertex;
-    //if ( signalVertex != 0 ) std::cout << ", z = " << signalVertex->z() << std::endl;
-    //std::cout << std::endl;
-    if ( signalVertex != 0 ) signalVertices.push_back(signalVertex);
-  }
+  fill(vertices);
+}
 
-  //std::cout << " #signalVertices = " << signalVertices.size() << std::endl;
+long long VertexTrackMatcher::cellKey(long long etaCell, long long phiCell)
+{
+  // |phi| is well below 2^31 cells
+  return etaCell*(1LL << 32) + phiCell;
+}
 
-  //std::cout << " #pfCandidates = " << pfCandidates.size() << std::endl;
+void VertexTrackMatcher::fill(const reco::VertexCollection& vertices)
+{
+  vertices_ = &vertices;
+  cells_.clear();
+  for ( size_t iVertex = 0; iVertex < vertices.size(); ++iVertex ) {
+    const reco::Vertex& vertex = vertices[iVertex];
+    for ( reco::Vertex::trackRef_iterator vtxAssocTrack = vertex.tracks_begin();
+	  vtxAssocTrack != vertex.tracks_end(); ++vtxAssocTrack ) {
+      TrackEntry entry;
+      entry.eta_ = (*vtxAssocTrack)->eta();
+      entry.phi_ = (*vtxAssocTrack)->phi();
+      entry.pt_ = (*vtxAssocTrack)->pt();
+      entry.vertex_ = iVertex;
+      // Tracks with a non-finite direction never match
+      if ( !isFinite(entry.eta_) || !isFinite(entry.phi_) ) continue;
+      cells_[cellKey(cellIndex(entry.eta_), cellIndex(entry.phi_))].push_back(entry);
+    }
+  }
+}
 
-  for ( std::vector<const reco::PFCandidate*>::const_iterator pfCandidate = pfCandidates.begin();
-	pfCandidate != pfCandidates.end(); ++pfCandidate ) {
-    reco::TrackRef pfCandidateTrack = (*pfCandidate)->trackRef();
-    if ( pfCandidateTrack.isNonnull() ) {
-      const reco::Vertex* pfCandidateVertex = findVertex(pfCandidateTrack.get(), vertices, deltaZ, bs);
-      //std::cout << "pfCandidateVertex = " << pfCandidateVertex;
-      //if ( pfCandidateVertex != 0 ) std::cout << ", z = " << pfCandidateVertex->z() << std::endl;
-      //std::cout << std::endl;
-
-      bool isSignalVtx_associated = false;
-      for ( std::vector<const reco::Vertex*>::const_iterator signalVertex = signalVertices.begin();
-	    signalVertex != signalVertices.end(); ++signalVertex ) {
-	if ( pfCandidateVertex == (*signalVertex) || (pfCandidateVertex->z() - (*signalVertex)->z()) < epsilon ) {
-	  isSignalVtx_associated = true;
+const reco::Vertex* VertexTrackMatcher::match(const reco::Track* signalTrack) const
+{
+  if ( !signalTrack || !vertices_ ) return 0;
+  double eta = signalTrack->eta();
+  double phi = signalTrack->phi();
+  if ( !isFinite(eta) || !isFinite(phi) ) return 0;
+  long long etaCell = cellIndex(eta);
+  long long phiCell = cellIndex(phi);
+  // Tracks are matched per vertex in order, so the first vertex with a
+  // matching track wins.
+  size_t firstVertex = vertices_->size();
+  for ( long long iEta = etaCell - 1; iEta <= etaCell + 1; ++iEta ) {
+    for ( long long iPhi = phiCell - 1; iPhi <= phiCell + 1; ++iPhi ) {
+      CellMap::const_iterator cell = cells_.find(cellKey(iEta, iPhi));
+      if ( cell == cells_.end() ) continue;
+      const std::vector<TrackEntry>& entries = cell->second;
+      for ( size_t iEntry = 0; iEntry < entries.size(); ++iEntry ) {
+	if ( entries[iEntry].vertex_ >= firstVertex ) break;
+	if ( isMatch(entries[iEntry].eta_, entries[iEntry].phi_, entries[iEntry].pt_, signalTrack) ) {
+	  firstVertex = entries[iEntry].vertex_;
 	  break;
 	}
       }
+    }
+  }
+  if ( firstVertex < vertices_->size() ) return &(*vertices_)[firstVertex];
+  return 0;
+}
 
-      //std::cout << "--> isSignalVtx_associated = " << isSignalVtx_associated << ": pt = " << (*pfCandidate)->pt() << std::endl;
+std::vector<const reco::PFCandidate*> getPFCandidatesOfType(const reco::PFCandidateCollection& pfCandidates,
+							    reco::PFCandidate::ParticleType pfParticleType)
+{
+  std::vector<const reco::PFCandidate*> retVal;
 
-      if ( isSignalVtx_associated ) {
-	pfNoPileUpCandidates.push_back(*pfCandidate);
-      } else {
-	pfPileUpCandidates.push_back(*pfCandidate);
-      }
+  for ( reco::PFCandidateCollection::const_iterator pfCandidate = pfCandidates.begin();
+	pfCandidate != pfCandidates.end(); ++pfCandidate ) {
+    if ( pfCandidate->particleId() == pfParticleType ) retVal.push_back(&(*pfCandidate));
+  }
+
+  return retVal;
+}
+
+bool isSignalVertexAssociated(const reco::Vertex* pfCandidateVertex,
+			      const std::vector<const reco::Vertex*>& signalVertices)
+{
+  for ( std::vector<const reco::Vertex*>::const_iterator signalVertex = signalVertices.begin();
+	signalVertex != signalVertices.end(); ++signalVertex ) {
+    if ( pfCandidateVertex == (*signalVertex) || (pfCandidateVertex->z() - (*signalVertex)->z()) < epsilon ) {
+      return true;
     }
   }
+  return false;
 }
 
 const reco::Vertex* findVertex(const reco::Track* signalTrack, const reco::VertexCollection& vertices,
@@ -102,18 +177,16 @@ const reco::Vertex* findVertex(const reco::Track* signalTrack, const reco::Verte
 
 //--- no vertex associated to track found,
 //    find vertex best matching signalTrack by deltaZ
-  double minDeltaZ = 1.e+3;
-  double refZ = (signalTrack->dz(bs.position()) + bs.position().z());
-  for ( reco::VertexCollection::const_iterator vertex = vertices.begin();
-	vertex != vertices.end(); ++vertex ) {
-    double deltaZ = TMath::Abs(vertex->z() - refZ);
-    if ( retVal == 0 || deltaZ < minDeltaZ ) {
-      retVal = &(*vertex);
-      minDeltaZ = deltaZ;
-    }
-  }
+  return findClosestVertexInZ(signalTrack, vertices, bs);
+}
 
-  //std::cout << "minDeltaZ = " << minDeltaZ << std::endl;
+const reco::Vertex* findVertex(const reco::Track* signalTrack, const VertexTrackMatcher& matcher,
+			       double deltaZ, const reco::BeamSpot& bs)
+{
+  if ( !signalTrack || !matcher.vertices() ) return 0;
 
-  return retVal;
+  const reco::Vertex* retVal = matcher.match(signalTrack);
+  if ( retVal ) return retVal;
+
+  return findClosestVertexInZ(signalTrack, *matcher.vertices(), bs);
 }
@@ -28,7 +28,8 @@ options = TauVarParsing.TauVarParsing(
     embedded=0,  # If running on embedded samples, set to 1
     analyzeSkimEff='',  # Analyze the skim efficiency and put it in this file
     eleReg=0,
-    zzMode=False
+    zzMode=False,
+    fuseEmbedders=0,  # Run the object embedders on a single copy
 )
 
 files = []
@@ -91,7 +92,7 @@ tuplize, output_commands = tuplizer.configurePatTuple(
     embedded=options.embedded,
     calibrationTarget=options.calibrationTarget,
     HLTprocess=options.HLTprocess, eleReg=options.eleReg,
-    zzMode=options.zzMode
+    zzMode=options.zzMode, fuseEmbedders=options.fuseEmbedders
 )
 
 if options.globalTag == "":
@@ -0,0 +1,149 @@
+/*
+ * Test that TMVAForest gives the TMVA::Reader response on the electron ID
+ * weight files, including inputs exactly at the cut values of the trees.
+ */
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <Utilities/Testing/interface/CppUnit_testdriver.icpp>
+#include <zlib.h>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "FinalStateAnalysis/PatTools/interface/TMVAForest.h"
+
+#include "FWCore/ParameterSet/interface/FileInPath.h"
+#include "RecoTauTag/RecoTau/interface/TMVAZipReader.h"
+#include "TMVA/Reader.h"
+#include "TRandom3.h"
+
+namespace {
+  const char* noIPVariables[] = {
+    "SigmaIEtaIEta", "DEtaIn", "DPhiIn", "FBrem", "EOverP",
+    "ESeedClusterOverPout", "SigmaIPhiIPhi", "NBrem",
+    "OneOverEMinusOneOverP", "ESeedClusterOverPIn"
+  };
+  const char* withIPVariables[] = {
+    "SigmaIEtaIEta", "DEtaIn", "DPhiIn", "D0", "FBrem", "EOverP",
+    "ESeedClusterOverPout", "SigmaIPhiIPhi", "NBrem",
+    "OneOverEMinusOneOverP", "ESeedClusterOverPIn", "IP3d", "IP3dSig"
+  };
+
+  std::string readFile(const std::string& path) {
+    std::string output;
+    gzFile file = gzopen(path.c_str(), "rb");
+    CPPUNIT_ASSERT(file);
+    char buffer[16384];
+    int nRead = 0;
+    while ((nRead = gzread(file, buffer, sizeof(buffer))) > 0)
+      output.append(buffer, nRead);
+    gzclose(file);
+    return output;
+  }
+
+  // The float value of the attribute [name] of the tag starting at [pos]
+  bool attribute(const std::string& xml, size_t pos, const std::string& name,
+      float& value) {
+    size_t end = xml.find('>', pos);
+    size_t found = xml.find(" " + name + "=\"", pos);
+    if (found == std::string::npos || found > end)
+      return false;
+    std::istringstream stream(xml.substr(found + name.size() + 3));
+    stream >> value;
+    return !stream.fail();
+  }
+
+  // The cut values of the intermediate nodes, by variable
+  std::map<int, std::vector<float> > cutValues(const std::string& xml) {
+    std::map<int, std::vector<float> > output;
+    for (size_t pos = xml.find("<Node "); pos != std::string::npos;
+        pos = xml.find("<Node ", pos + 1)) {
+      float variable = -1;
+      float cut = 0;
+      if (attribute(xml, pos, "IVar", variable) && variable >= 0 &&
+          attribute(xml, pos, "Cut", cut))
+        output[static_cast<int>(variable)].push_back(cut);
+    }
+    return output;
+  }
+}
+
+class testTMVAForest: public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(testTMVAForest);
+  CPPUNIT_TEST(testElectronIDWeights);
+  CPPUNIT_TEST_SUITE_END();
+  public:
+    void setUp(){}
+    void tearDown(){}
+
+    void testElectronIDWeights();
+
+  private:
+    void compare(const std::string& file,
+        const std::vector<std::string>& variables);
+};
+
+void testTMVAForest::compare(const std::string& file,
+    const std::vector<std::string>& variables) {
+  std::string path = edm::FileInPath(
+      "FinalStateAnalysis/PatTools/data/ElectronMVAWeights/" + file).fullPath();
+
+  TMVAForest forest;
+  CPPUNIT_ASSERT(forest.load(path, variables));
+  CPPUNIT_ASSERT(forest.nVariables() == variables.size());
+
+  std::vector<float> inputs(variables.size());
+  TMVA::Reader reader("!Color:Silent:Error");
+  for (size_t v = 0; v < variables.size(); ++v)
+    reader.AddVariable(variables[v], &inputs[v]);
+  reco::details::loadTMVAWeights(&reader, "BDT", path);
+
+  std::map<int, std::vector<float> > cuts = cutValues(readFile(path));
+  CPPUNIT_ASSERT(!cuts.empty());
+
+  // Start from inputs around the cuts of the first trees, then put each
+  // variable exactly at each of its cut values.
+  TRandom3 random(12345);
+  size_t nChecked = 0;
+  for (int trial = 0; trial < 20; ++trial) {
+    std::vector<float> base(variables.size());
+    for (size_t v = 0; v < variables.size(); ++v) {
+      const std::vector<float>& varCuts = cuts[v];
+      base[v] = varCuts.empty() ? 0 :
+        varCuts[random.Integer(varCuts.size())]*random.Uniform(0.5, 1.5);
+    }
+    for (size_t v = 0; v < variables.size(); ++v) {
+      const std::vector<float>& varCuts = cuts[v];
+      for (size_t c = 0; c < varCuts.size(); c += 1 + varCuts.size()/50) {
+        inputs = base;
+        inputs[v] = varCuts[c];
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(reader.EvaluateMVA("BDT"),
+            forest.evaluate(&inputs[0]), 1e-6);
+        ++nChecked;
+      }
+    }
+    inputs = base;
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(reader.EvaluateMVA("BDT"),
+        forest.evaluate(&inputs[0]), 1e-6);
+  }
+  CPPUNIT_ASSERT(nChecked > 0);
+}
+
+void testTMVAForest::testElectronIDWeights() {
+  std::vector<std::string> noIP(noIPVariables, noIPVariables +
+      sizeof(noIPVariables)/sizeof(noIPVariables[0]));
+  std::vector<std::string> withIP(withIPVariables, withIPVariables +
+      sizeof(withIPVariables)/sizeof(withIPVariables[0]));
+  const char* subdets[] = { "Subdet0", "Subdet1", "Subdet2" };
+  const char* ptBins[] = { "LowPt", "HighPt" };
+  for (size_t s = 0; s < 3; ++s) {
+    for (size_t p = 0; p < 2; ++p) {
+      std::string prefix = std::string(subdets[s]) + ptBins[p];
+      compare(prefix + "_NoIPInfo_BDTG.weights.xml.gz", noIP);
+      compare(prefix + "_WithIPInfo_BDTG.weights.xml.gz", withIP);
+    }
+  }
+}
+
+CPPUNIT_TEST_SUITE_REGISTRATION(testTMVAForest);
@@ -0,0 +1,116 @@
+/*
+ * Test the identification of the vertex fit legs, with the tracks embedded
+ * in the muons as in the PAT tuple (patMuons.embedTrack = True).
+ */
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <Utilities/Testing/interface/CppUnit_testdriver.icpp>
+#include <vector>
+
+#include "FinalStateAnalysis/PatTools/interface/VertexFitLegs.h"
+#include "FinalStateAnalysis/DataFormats/interface/PATFinalStateEvent.h"
+#include "FinalStateAnalysis/DataFormats/interface/PATDiLeptonFinalStates.h"
+
+#include "DataFormats/PatCandidates/interface/Muon.h"
+#include "DataFormats/PatCandidates/interface/MET.h"
+#include "DataFormats/TrackReco/interface/Track.h"
+#include "DataFormats/Common/interface/OrphanHandle.h"
+#include "DataFormats/Common/interface/TestHandle.h"
+
+using namespace edm;
+
+class testVertexFitLegs: public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(testVertexFitLegs);
+  CPPUNIT_TEST(testEmbeddedTracks);
+  CPPUNIT_TEST(testMissingTrack);
+  CPPUNIT_TEST_SUITE_END();
+  public:
+    void setUp();
+    void tearDown(){}
+
+    void testEmbeddedTracks();
+    void testMissingTrack();
+
+  private:
+    reco::TrackCollection tracks_;
+    std::vector<pat::Muon> muons_;
+    std::vector<Ptr<pat::Muon> > muonPtrs_;
+    std::vector<pat::MET> mets_;
+    std::vector<PATFinalStateEvent> events_;
+    Ptr<PATFinalStateEvent> eventPtr_;
+};
+
+void testVertexFitLegs::setUp() {
+  for (int i = 0; i < 5; ++i) {
+    tracks_.push_back(reco::Track(1., 2., reco::Track::Point(0, 0, 0),
+          reco::Track::Vector(10. + i, 0, 1.), 1,
+          reco::Track::CovarianceMatrix()));
+  }
+  OrphanHandle<reco::TrackCollection> trackHandle(&tracks_, ProductID(1, 1));
+  // The last muon has no track
+  for (size_t i = 0; i < tracks_.size(); ++i) {
+    reco::Muon muon;
+    muon.setP4(reco::Candidate::PolarLorentzVector(10. + i, 0, 0, 0.1));
+    if (i < 4)
+      muon.setInnerTrack(reco::TrackRef(trackHandle, i));
+    pat::Muon patMuon(muon);
+    if (i < 4)
+      patMuon.embedTrack();
+    muons_.push_back(patMuon);
+  }
+  TestHandle<std::vector<pat::Muon> > muonHandle(&muons_, ProductID(1, 2));
+  for (size_t i = 0; i < muons_.size(); ++i)
+    muonPtrs_.push_back(Ptr<pat::Muon>(muonHandle, i));
+
+  mets_.push_back(pat::MET());
+  TestHandle<std::vector<pat::MET> > metHandle(&mets_, ProductID(1, 3));
+  events_.push_back(PATFinalStateEvent(Ptr<reco::Vertex>(),
+        Ptr<pat::MET>(metHandle, 0)));
+  TestHandle<std::vector<PATFinalStateEvent> > eventHandle(
+      &events_, ProductID(1, 4));
+  eventPtr_ = Ptr<PATFinalStateEvent>(eventHandle, 0);
+}
+
+void testVertexFitLegs::testEmbeddedTracks() {
+  // The embedded tracks can't be told apart by their Refs
+  CPPUNIT_ASSERT(muons_[0].innerTrack().id() == muons_[2].innerTrack().id());
+  CPPUNIT_ASSERT(muons_[0].innerTrack().key() == muons_[2].innerTrack().key());
+
+  // Two distinct pairs in the same event
+  PATMuMuFinalState first(muonPtrs_[0], muonPtrs_[1], eventPtr_);
+  PATMuMuFinalState second(muonPtrs_[2], muonPtrs_[3], eventPtr_);
+  std::vector<VertexFitLeg> firstLegs = vertexFitLegs(first);
+  std::vector<VertexFitLeg> secondLegs = vertexFitLegs(second);
+  CPPUNIT_ASSERT(firstLegs.size() == 2);
+  CPPUNIT_ASSERT(secondLegs.size() == 2);
+
+  std::vector<reco::CandidatePtr> firstKeys;
+  std::vector<reco::CandidatePtr> secondKeys;
+  for (size_t l = 0; l < 2; ++l) {
+    CPPUNIT_ASSERT(firstLegs[l].valid);
+    CPPUNIT_ASSERT(firstLegs[l].track.isNonnull());
+    firstKeys.push_back(firstLegs[l].cand);
+    secondKeys.push_back(secondLegs[l].cand);
+  }
+  // The pairs are fitted separately, with their own tracks
+  CPPUNIT_ASSERT(firstKeys != secondKeys);
+  CPPUNIT_ASSERT(firstLegs[0].track.get() != secondLegs[0].track.get());
+  CPPUNIT_ASSERT(firstLegs[1].track.get() != secondLegs[1].track.get());
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(secondLegs[0].track->px(), 12., 1e-6);
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(secondLegs[1].track->px(), 13., 1e-6);
+
+  // The same pair in the other order shares the fit
+  PATMuMuFinalState swapped(muonPtrs_[1], muonPtrs_[0], eventPtr_);
+  std::vector<VertexFitLeg> swappedLegs = vertexFitLegs(swapped);
+  CPPUNIT_ASSERT(swappedLegs.size() == 2);
+  CPPUNIT_ASSERT(swappedLegs[0].cand == firstKeys[0]);
+  CPPUNIT_ASSERT(swappedLegs[1].cand == firstKeys[1]);
+}
+
+void testVertexFitLegs::testMissingTrack() {
+  CPPUNIT_ASSERT(!vertexFitLeg(muonPtrs_[4]).valid);
+  PATMuMuFinalState noTrack(muonPtrs_[0], muonPtrs_[4], eventPtr_);
+  CPPUNIT_ASSERT(vertexFitLegs(noTrack).empty());
+}
+
+CPPUNIT_TEST_SUITE_REGISTRATION(testVertexFitLegs);
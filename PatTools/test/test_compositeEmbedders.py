@@ -0,0 +1,126 @@
+'''
+
+Test of fusing chains of PAT object embedders into composite embedders
+
+'''
+
+import unittest
+import FWCore.ParameterSet.Config as cms
+from FinalStateAnalysis.PatTools.compositeEmbedders import \
+    fuse_embedders, make_composite, _ModuleCollector
+
+
+def modules(sequence):
+    collector = _ModuleCollector()
+    sequence.visit(collector)
+    return collector.modules
+
+
+def value_map_embedder(type_):
+    return cms.EDProducer(
+        type_,
+        src=cms.InputTag('fixme'),
+        maps=cms.VPSet(cms.PSet(
+            src=cms.InputTag('someMap'),
+            label=cms.string('someMap'),
+        )),
+    )
+
+
+class TestCompositeEmbedders(unittest.TestCase):
+    def setUp(self):
+        self.process = cms.Process('TEST')
+        process = self.process
+        process.muonRho = cms.EDProducer(
+            'MuonRhoOverloader',
+            src=cms.InputTag('fixme'),
+            srcRho=cms.InputTag('kt6PFJets', 'rho'),
+        )
+        process.muonEA = cms.EDProducer(
+            'PATMuonEAEmbedder',
+            src=cms.InputTag('fixme'),
+            target=cms.string('2012Data'),
+        )
+        process.muonMaps = value_map_embedder('PATMuonValueMapEmbedder')
+        process.muonId = cms.EDProducer(
+            'PATMuonIdEmbedder',
+            src=cms.InputTag('fixme'),
+        )
+        process.muonSelection = cms.EDFilter(
+            'PATMuonSelector',
+            src=cms.InputTag('fixme'),
+            cut=cms.string('pt > 5'),
+        )
+        process.muonIp = cms.EDProducer(
+            'PATMuonIpEmbedder',
+            src=cms.InputTag('fixme'),
+        )
+        process.muonIp2 = cms.EDProducer(
+            'PATMuonIpEmbedder',
+            src=cms.InputTag('fixme'),
+            noSeqChain=cms.bool(True),
+        )
+        process.sequence = cms.Sequence(
+            process.muonRho * process.muonEA * process.muonMaps *
+            process.muonId * process.muonSelection * process.muonIp *
+            process.muonIp2)
+
+    def test_fuse(self):
+        labels = fuse_embedders(self.process, self.process.sequence)
+        # The value map embedder starts a new run, the selector and the
+        # unchained embedder are not fused.
+        self.assertEqual(labels, ['muonRhoComposite', 'muonMapsComposite'])
+        fused = modules(self.process.sequence)
+        self.assertEqual(
+            [x.label() for x in fused],
+            ['muonRhoComposite', 'muonMapsComposite', 'muonSelection',
+             'muonIp', 'muonIp2'])
+
+        first = self.process.muonRhoComposite
+        self.assertEqual(first.type_(), 'PATMuonCompositeEmbedder')
+        self.assertEqual(
+            [x.type.value() for x in first.embedders],
+            ['MuonRhoOverloader', 'PATMuonEAEmbedder'])
+        self.assertEqual(first.embedders[0].srcRho.value(), 'kt6PFJets:rho')
+        self.assertFalse(hasattr(first.embedders[0], 'src'))
+
+        second = self.process.muonMapsComposite
+        self.assertEqual(
+            [x.type.value() for x in second.embedders],
+            ['PATMuonValueMapEmbedder', 'PATMuonIdEmbedder'])
+
+    def test_value_map_after_other(self):
+        self.assertRaises(ValueError, make_composite,
+                          self.process.muonId, self.process.muonMaps)
+
+    def test_mixed_types(self):
+        jet_id = cms.EDProducer('PATJetIdEmbedder', src=cms.InputTag('fixme'))
+        self.assertRaises(ValueError, make_composite,
+                          self.process.muonId, jet_id)
+
+    def test_jet_pu_id(self):
+        # The PU ID is keyed to the reco jets, so it can be fused anywhere
+        process = self.process
+        process.jetId = cms.EDProducer(
+            'PATJetIdEmbedder', src=cms.InputTag('fixme'))
+        process.jetPUID = cms.EDProducer(
+            'PATJetPUIDEmbedder',
+            src=cms.InputTag('fixme'),
+            discriminants=cms.VInputTag(),
+            ids=cms.VInputTag(),
+        )
+        process.jetMaps = value_map_embedder('PATJetValueMapEmbedder')
+        process.jetSequence = cms.Sequence(
+            process.jetId * process.jetPUID * process.jetMaps)
+        labels = fuse_embedders(process, process.jetSequence)
+        self.assertEqual(labels, ['jetIdComposite'])
+        self.assertEqual(
+            [x.label() for x in modules(process.jetSequence)],
+            ['jetIdComposite', 'jetMaps'])
+        self.assertEqual(
+            [x.type.value() for x in process.jetIdComposite.embedders],
+            ['PATJetIdEmbedder', 'PATJetPUIDEmbedder'])
+
+
+if __name__ == '__main__':
+    unittest.main()
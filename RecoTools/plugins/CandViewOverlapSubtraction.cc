@@ -21,6 +21,8 @@
 
 #include "DataFormats/Math/interface/deltaR.h"
 
+#include "FinalStateAnalysis/DataAlgos/interface/EtaPhiIndex.h"
+
 class CandViewOverlapSubtraction : public edm::EDFilter {
   public:
     CandViewOverlapSubtraction(const edm::ParameterSet& pset);
@@ -31,6 +33,9 @@ class CandViewOverlapSubtraction : public edm::EDFilter {
     edm::InputTag subtractSrc_;
     double minDeltaR_;
     bool filter_;
+    // Per-event working space, kept to reuse the allocations
+    EtaPhiIndex index_;
+    std::vector<size_t> near_;
 };
 
 CandViewOverlapSubtraction::CandViewOverlapSubtraction(const edm::ParameterSet& pset) {
@@ -54,11 +59,19 @@ bool CandViewOverlapSubtraction::filter(edm::Event& evt, const edm::EventSetup&
   const reco::CandidateBaseRefVector &toFilter = candsToFilter->refVector();
   const reco::CandidateBaseRefVector &toSubtract = candsToSubtract->refVector();
 
+  index_.clear();
+  for (size_t j = 0; j < toSubtract.size(); ++j) {
+    index_.insert(toSubtract[j]->p4().eta(), toSubtract[j]->p4().phi(), j);
+  }
+
   for (size_t i = 0; i < toFilter.size(); ++i) {
     const reco::CandidateBaseRef& baseRef = toFilter[i];
     bool passes = true;
-    for (size_t j = 0; j < toSubtract.size(); ++j) {
-      double deltaR = reco::deltaR(baseRef->p4(), toSubtract[j]->p4());
+    // Only the objects in the cells around this one can be within minDeltaR
+    index_.neighbours(baseRef->p4().eta(), baseRef->p4().phi(), minDeltaR_,
+        near_);
+    for (size_t n = 0; n < near_.size(); ++n) {
+      double deltaR = reco::deltaR(baseRef->p4(), toSubtract[near_[n]]->p4());
       if (deltaR < minDeltaR_) {
         passes = false;
         break;
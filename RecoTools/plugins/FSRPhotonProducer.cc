@@ -2,6 +2,10 @@
 File: FSRPhotonProducer
 Author: Ian Ross (iross@cern.ch), University of Wisconsin Madison
 Description: Make the FSR photon candidate collection for ZZ4L analysis
+
+If [leptonSrcs] are given, only the photons within [maxDeltaR] of one of
+these leptons are kept, and the nearest lepton and its deltaR are stored in
+ValueMaps (nearestLepton, nearestLeptonDR) associated to the photons.
 */
 
 
@@ -34,13 +38,27 @@ Description: Make the FSR photon candidate collection for ZZ4L analysis
 #include "DataFormats/TrackReco/interface/Track.h"
 #include "DataFormats/TrackReco/interface/TrackExtra.h"
 
+#include "DataFormats/Common/interface/ValueMap.h"
+#include "DataFormats/Common/interface/View.h"
+#include "DataFormats/Math/interface/deltaR.h"
+#include "FinalStateAnalysis/DataAlgos/interface/EtaPhiIndex.h"
+
 
 class FSRPhotonProducer : public edm::EDProducer {
   public:
     explicit FSRPhotonProducer(const edm::ParameterSet& iConfig):
       src_(iConfig.getParameter<edm::InputTag>("src"))
   {
+    leptonSrcs_ = iConfig.exists("leptonSrcs") ?
+      iConfig.getParameter<std::vector<edm::InputTag> >("leptonSrcs") :
+      std::vector<edm::InputTag>();
+    maxDeltaR_ = iConfig.exists("maxDeltaR") ?
+      iConfig.getParameter<double>("maxDeltaR") : 0.5;
     produces<reco::PFCandidateCollection>();
+    if (!leptonSrcs_.empty()) {
+      produces<edm::ValueMap<reco::CandidatePtr> >("nearestLepton");
+      produces<edm::ValueMap<float> >("nearestLeptonDR");
+    }
   }
 
     ~FSRPhotonProducer() {}
@@ -56,29 +74,98 @@ class FSRPhotonProducer : public edm::EDProducer {
       //PF photons from the particleFlow collection, plus PF photons created from the ecalEnergy of the muon PF candidates (sample code1, sample code 2, with properly massless photons)
       //Preselection: pT > 2 GeV, |η| < 2.4
 
+      // Index the seed leptons, so each photon is only compared to the
+      // leptons around it
+      bool seeded = !leptonSrcs_.empty();
+      leptons_.clear();
+      index_.clear();
+      for (size_t i = 0; i < leptonSrcs_.size(); ++i) {
+        edm::Handle<edm::View<reco::Candidate> > leptons;
+        iEvent.getByLabel(leptonSrcs_[i], leptons);
+        for (size_t j = 0; j < leptons->size(); ++j) {
+          const reco::Candidate& lepton = leptons->at(j);
+          index_.insert(lepton.eta(), lepton.phi(), leptons_.size());
+          leptons_.push_back(leptons->ptrAt(j));
+        }
+      }
+      nearest_.clear();
+      nearestDR_.clear();
+
       edm::Handle<reco::PFCandidateCollection> pfcands;
 
       if(iEvent.getByLabel(src_,pfcands)) {
         for ( reco::PFCandidateCollection::const_iterator it=pfcands->begin(); it!=pfcands->end(); ++it )    {
           // todo: look at nearest leptons, apply iso?
           if (it->pdgId() == 22 && it->charge()==0 && it->pt()>2 && fabs(it->eta())<2.4){
-            out->push_back(*it);
+            if (!seeded || nearLepton(*it)) {
+              out->push_back(*it);
+            }
             //std::cout << "Adding: " << it->pt() << " (eta, phi): " << it->eta() << " " << it->phi() << std::endl;
           }
           if (abs(it->pdgId())==13 && fabs(it->eta())<2.4){
             reco::Particle::PolarLorentzVector p4(it->ecalEnergy()*it->pt()/it->p(),it->eta(),it->phi(),0.0);
             if (p4.pt() > 2.0) {
-              out->push_back( reco::PFCandidate(0,reco::Particle::LorentzVector(p4), reco::PFCandidate::gamma) );
+              reco::PFCandidate photon(0,reco::Particle::LorentzVector(p4), reco::PFCandidate::gamma);
+              if (!seeded || nearLepton(photon)) {
+                out->push_back(photon);
+              }
               //std::cout << "Adding: " << p4.pt() << " (eta, phi): " << p4.eta() << " " << p4.phi() << std::endl;
             }
           }
         }
       }
-      iEvent.put(out);
+      edm::OrphanHandle<reco::PFCandidateCollection> outH = iEvent.put(out);
+
+      if (seeded) {
+        std::auto_ptr<edm::ValueMap<reco::CandidatePtr> > nearest(
+            new edm::ValueMap<reco::CandidatePtr>());
+        edm::ValueMap<reco::CandidatePtr>::Filler nearestFiller(*nearest);
+        nearestFiller.insert(outH, nearest_.begin(), nearest_.end());
+        nearestFiller.fill();
+        iEvent.put(nearest, "nearestLepton");
+
+        std::auto_ptr<edm::ValueMap<float> > nearestDR(
+            new edm::ValueMap<float>());
+        edm::ValueMap<float>::Filler nearestDRFiller(*nearestDR);
+        nearestDRFiller.insert(outH, nearestDR_.begin(), nearestDR_.end());
+        nearestDRFiller.fill();
+        iEvent.put(nearestDR, "nearestLeptonDR");
+      }
+    }
+
+    // Find the nearest seed lepton within maxDeltaR of [photon].  If there
+    // is one, record it for the next output photon and return true.
+    bool nearLepton(const reco::Candidate& photon)
+    {
+      index_.neighbours(photon.eta(), photon.phi(), maxDeltaR_, near_);
+      int nearest = -1;
+      double nearestDR = maxDeltaR_;
+      for (size_t n = 0; n < near_.size(); ++n) {
+        double dR = reco::deltaR(photon, *leptons_[near_[n]]);
+        if (dR < nearestDR) {
+          nearestDR = dR;
+          nearest = near_[n];
+        }
+      }
+      if (nearest < 0)
+        return false;
+      nearest_.push_back(leptons_[nearest]);
+      nearestDR_.push_back(nearestDR);
+      return true;
     }
 
     // ----------member data ---------------------------
     edm::InputTag src_;
+    std::vector<edm::InputTag> leptonSrcs_;
+    double maxDeltaR_;
+
+    // Per-event working space, kept to reuse the allocations
+    std::vector<reco::CandidatePtr> leptons_;
+    EtaPhiIndex index_;
+    std::vector<size_t> near_;
+    // Nearest lepton of each output photon
+    std::vector<reco::CandidatePtr> nearest_;
+    std::vector<float> nearestDR_;
 
 };
 
@@ -24,6 +24,8 @@
 
 #include "DataFormats/Math/interface/deltaR.h"
 
+#include "FinalStateAnalysis/DataAlgos/interface/EtaPhiIndex.h"
+
 class PFJetViewOverlapSubtraction : public edm::EDFilter {
   public:
     PFJetViewOverlapSubtraction(const edm::ParameterSet& pset);
@@ -35,6 +37,9 @@ class PFJetViewOverlapSubtraction : public edm::EDFilter {
     double minDeltaR_;
     bool filter_;
     bool invert_;
+    // Per-event working space, kept to reuse the allocations
+    EtaPhiIndex index_;
+    std::vector<size_t> near_;
 };
 
 PFJetViewOverlapSubtraction::PFJetViewOverlapSubtraction(const edm::ParameterSet& pset) {
@@ -60,11 +65,19 @@ bool PFJetViewOverlapSubtraction::filter(edm::Event& evt, const edm::EventSetup&
   const edm::PtrVector<reco::PFJet> &toFilter = candsToFilter->ptrVector();
   const reco::CandidateBaseRefVector &toSubtract = candsToSubtract->refVector();
 
+  index_.clear();
+  for (size_t j = 0; j < toSubtract.size(); ++j) {
+    index_.insert(toSubtract[j]->p4().eta(), toSubtract[j]->p4().phi(), j);
+  }
+
   for (size_t i = 0; i < toFilter.size(); ++i) {
     edm::Ptr<reco::PFJet> baseRef = toFilter[i];
     bool passes = true;
-    for (size_t j = 0; j < toSubtract.size(); ++j) {
-      double deltaR = reco::deltaR(baseRef->p4(), toSubtract[j]->p4());
+    // Only the objects in the cells around this one can be within minDeltaR
+    index_.neighbours(baseRef->p4().eta(), baseRef->p4().phi(), minDeltaR_,
+        near_);
+    for (size_t n = 0; n < near_.size(); ++n) {
+      double deltaR = reco::deltaR(baseRef->p4(), toSubtract[near_[n]]->p4());
       if (deltaR < minDeltaR_) {
         passes = false;
         break;
@@ -0,0 +1,112 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  BinnedLookup.h
+ *
+ *    Description:  N-dimensional binned table of values (and uncertainties),
+ *                  i.e. efficiencies or scale factors in bins of pt and eta.
+ *                  The bin edges, values and errors are read from a text
+ *                  file, so a new table doesn't need any new code.
+ *
+ *                  A bin is found by binary search of the edges, or
+ *                  directly by arithmetic for equally spaced edges.
+ *
+ *                  File format.  Everything after a '#' is a comment, the
+ *                  numbers can be laid out freely.
+ *
+ *                    axis <name> <convention> [other] <edge> <edge> ...
+ *                    default <value> [<error>]
+ *                    values <value> <value> ...
+ *                    errors <error> <error> ...
+ *
+ *                  There is one 'axis' line per dimension, in the order the
+ *                  coordinates are given.  The <convention> gives which edges
+ *                  belong to a bin:
+ *                    [)  lo <= x < hi
+ *                    (]  lo < x <= hi
+ *                    []  lo <= x < hi, except the last bin is lo <= x <= hi
+ *                  With 'other', the axis has an extra bin (after the
+ *                  regular ones) for everything outside the edges, including
+ *                  NaN.  Edges can be 'inf' or '-inf'.
+ *
+ *                  The 'values' (and the optional 'errors') are given for
+ *                  every bin, with the bins of the last axis varying
+ *                  fastest.  The 'default' value and error (0 if they are
+ *                  not given) are returned outside the table.
+ *
+ * =====================================================================================
+ */
+
+#ifndef BINNEDLOOKUP_R4HX8N2C
+#define BINNEDLOOKUP_R4HX8N2C
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+class BinnedLookup {
+  public:
+    BinnedLookup();
+
+    /// Load the table in the file [path].  Throws a cms::Exception if it
+    /// can't be read.
+    explicit BinnedLookup(const std::string& path);
+
+    /// Replace the content with the table in the file [path]
+    void load(const std::string& path);
+
+    size_t nAxes() const { return axes_.size(); }
+    const std::string& axisName(size_t axis) const;
+    /// The total number of bins
+    size_t nBins() const { return values_.size(); }
+
+    /// The bin containing [point] (nAxes() coordinates), or -1 if it is
+    /// outside the table.
+    int bin(const double* point) const;
+
+    double value(const double* point) const;
+    double error(const double* point) const;
+
+    /// Shortcuts for one and two dimensional tables
+    double value(double x) const;
+    double value(double x, double y) const;
+    double error(double x) const;
+    double error(double x, double y) const;
+
+    /// Look up [n] points.  [points] holds nAxes() coordinates for each
+    /// point, one point after the other.  The [errors] are only filled if
+    /// given.
+    void values(size_t n, const double* points, double* output,
+        double* errors=0) const;
+
+  private:
+    struct Axis {
+      std::string name;
+      std::vector<double> edges;
+      // Bins are lo < x <= hi, instead of lo <= x < hi
+      bool upperInclusive;
+      // The last bin includes the upper edge
+      bool closed;
+      // There is an extra bin for everything outside the edges
+      bool other;
+      // The edges are equally spaced, so the bin can be computed
+      bool uniform;
+      double inverseWidth;
+
+      size_t nBins() const { return edges.size() - 1 + other; }
+      // The bin of [x] on this axis, or -1
+      int find(double x) const;
+    };
+
+    void check(size_t nCoordinates) const;
+
+    std::vector<Axis> axes_;
+    // Flat index increment of one bin on each axis
+    std::vector<size_t> strides_;
+    std::vector<double> values_;
+    std::vector<double> errors_;
+    double defaultValue_;
+    double defaultError_;
+};
+
+#endif /* end of include guard: BINNEDLOOKUP_R4HX8N2C */
@@ -0,0 +1,249 @@
+#include "FinalStateAnalysis/TagAndProbe/interface/BinnedLookup.h"
+
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+namespace {
+  // Parse [token] as a number, including "inf" and "-inf"
+  bool readNumber(const std::string& token, double& output) {
+    const char* begin = token.c_str();
+    char* end = 0;
+    output = std::strtod(begin, &end);
+    return end != begin && *end == '\0';
+  }
+
+  // Read the numbers starting at [tokens][pos], up to the next keyword
+  void readNumbers(const std::vector<std::string>& tokens, size_t& pos,
+      std::vector<double>& output) {
+    double number = 0;
+    while (pos < tokens.size() && readNumber(tokens[pos], number)) {
+      output.push_back(number);
+      ++pos;
+    }
+  }
+}
+
+BinnedLookup::BinnedLookup():defaultValue_(0),defaultError_(0) {}
+
+BinnedLookup::BinnedLookup(const std::string& path):
+  defaultValue_(0),defaultError_(0) {
+  load(path);
+}
+
+void BinnedLookup::load(const std::string& path) {
+  std::ifstream file(path.c_str());
+  if (!file) {
+    throw cms::Exception("BinnedLookup")
+      << "Can't open the table file " << path << std::endl;
+  }
+  std::vector<std::string> tokens;
+  std::string line;
+  while (std::getline(file, line)) {
+    std::istringstream stream(line.substr(0, line.find('#')));
+    std::string token;
+    while (stream >> token)
+      tokens.push_back(token);
+  }
+
+  std::vector<Axis> axes;
+  std::vector<double> values;
+  std::vector<double> errors;
+  std::vector<double> defaults;
+  size_t pos = 0;
+  while (pos < tokens.size()) {
+    const std::string& keyword = tokens[pos++];
+    if (keyword == "axis") {
+      if (pos + 2 > tokens.size()) {
+        throw cms::Exception("BinnedLookup")
+          << "Incomplete axis in " << path << std::endl;
+      }
+      Axis axis;
+      axis.name = tokens[pos++];
+      const std::string& convention = tokens[pos++];
+      if (convention != "[)" && convention != "(]" && convention != "[]") {
+        throw cms::Exception("BinnedLookup")
+          << "Unknown bin convention " << convention << " for axis "
+          << axis.name << " in " << path << std::endl;
+      }
+      axis.upperInclusive = (convention == "(]");
+      axis.closed = (convention == "[]");
+      axis.other = (pos < tokens.size() && tokens[pos] == "other");
+      if (axis.other)
+        ++pos;
+      readNumbers(tokens, pos, axis.edges);
+      if (axis.edges.size() < 2) {
+        throw cms::Exception("BinnedLookup")
+          << "Axis " << axis.name << " in " << path
+          << " needs at least two edges" << std::endl;
+      }
+      for (size_t i = 1; i < axis.edges.size(); ++i) {
+        if (!(axis.edges[i-1] < axis.edges[i])) {
+          throw cms::Exception("BinnedLookup")
+            << "The edges of axis " << axis.name << " in " << path
+            << " are not increasing" << std::endl;
+        }
+      }
+      double first = axis.edges.front();
+      double width = axis.edges[1] - first;
+      axis.uniform = (width - width == 0 &&
+          axis.edges.back() - axis.edges.back() == 0);
+      for (size_t i = 1; axis.uniform && i < axis.edges.size(); ++i) {
+        double expected = first + i*width;
+        axis.uniform = std::fabs(axis.edges[i] - expected) <= 1e-9*width;
+      }
+      axis.inverseWidth = axis.uniform ? 1.0/width : 0;
+      axes.push_back(axis);
+    } else if (keyword == "default") {
+      readNumbers(tokens, pos, defaults);
+      if (defaults.empty() || defaults.size() > 2) {
+        throw cms::Exception("BinnedLookup")
+          << "The default in " << path
+          << " should be a value and an optional error" << std::endl;
+      }
+    } else if (keyword == "values") {
+      readNumbers(tokens, pos, values);
+    } else if (keyword == "errors") {
+      readNumbers(tokens, pos, errors);
+    } else {
+      throw cms::Exception("BinnedLookup")
+        << "Unexpected " << keyword << " in " << path << std::endl;
+    }
+  }
+
+  if (axes.empty()) {
+    throw cms::Exception("BinnedLookup")
+      << "No axes in " << path << std::endl;
+  }
+  std::vector<size_t> strides(axes.size(), 1);
+  for (size_t i = axes.size() - 1; i > 0; --i)
+    strides[i-1] = strides[i]*axes[i].nBins();
+  size_t nBins = strides[0]*axes[0].nBins();
+  if (values.size() != nBins) {
+    throw cms::Exception("BinnedLookup")
+      << path << " has " << values.size() << " values for " << nBins
+      << " bins" << std::endl;
+  }
+  if (errors.empty()) {
+    errors.assign(nBins, 0.0);
+  } else if (errors.size() != nBins) {
+    throw cms::Exception("BinnedLookup")
+      << path << " has " << errors.size() << " errors for " << nBins
+      << " bins" << std::endl;
+  }
+
+  axes_.swap(axes);
+  strides_.swap(strides);
+  values_.swap(values);
+  errors_.swap(errors);
+  defaultValue_ = defaults.size() > 0 ? defaults[0] : 0;
+  defaultError_ = defaults.size() > 1 ? defaults[1] : 0;
+}
+
+const std::string& BinnedLookup::axisName(size_t axis) const {
+  return axes_.at(axis).name;
+}
+
+int BinnedLookup::Axis::find(double x) const {
+  int lastEdge = edges.size() - 1;
+  int found = -1;
+  // The range checks are false for NaN
+  bool inside = upperInclusive ?
+    (x > edges.front() && x <= edges.back()) :
+    (x >= edges.front() && x < edges.back());
+  if (inside) {
+    if (uniform) {
+      // The guess can be off by one near an edge, from rounding
+      found = std::min(
+          static_cast<int>((x - edges.front())*inverseWidth), lastEdge - 1);
+      if (upperInclusive) {
+        while (x <= edges[found])
+          --found;
+        while (x > edges[found+1])
+          ++found;
+      } else {
+        while (x < edges[found])
+          --found;
+        while (x >= edges[found+1])
+          ++found;
+      }
+    } else if (upperInclusive) {
+      found = std::lower_bound(edges.begin(), edges.end(), x)
+        - edges.begin() - 1;
+    } else {
+      found = std::upper_bound(edges.begin(), edges.end(), x)
+        - edges.begin() - 1;
+    }
+  } else if (closed && x == edges.back()) {
+    found = lastEdge - 1;
+  } else if (other) {
+    found = lastEdge;
+  }
+  return found;
+}
+
+int BinnedLookup::bin(const double* point) const {
+  int output = 0;
+  for (size_t i = 0; i < axes_.size(); ++i) {
+    int found = axes_[i].find(point[i]);
+    if (found < 0)
+      return -1;
+    output += found*strides_[i];
+  }
+  return output;
+}
+
+double BinnedLookup::value(const double* point) const {
+  int found = bin(point);
+  return found < 0 ? defaultValue_ : values_[found];
+}
+
+double BinnedLookup::error(const double* point) const {
+  int found = bin(point);
+  return found < 0 ? defaultError_ : errors_[found];
+}
+
+void BinnedLookup::check(size_t nCoordinates) const {
+  if (nCoordinates != axes_.size()) {
+    throw cms::Exception("BinnedLookup")
+      << "Lookup with " << nCoordinates << " coordinates in a table with "
+      << axes_.size() << " axes" << std::endl;
+  }
+}
+
+double BinnedLookup::value(double x) const {
+  check(1);
+  return value(&x);
+}
+
+double BinnedLookup::value(double x, double y) const {
+  check(2);
+  double point[2] = {x, y};
+  return value(point);
+}
+
+double BinnedLookup::error(double x) const {
+  check(1);
+  return error(&x);
+}
+
+double BinnedLookup::error(double x, double y) const {
+  check(2);
+  double point[2] = {x, y};
+  return error(point);
+}
+
+void BinnedLookup::values(size_t n, const double* points, double* output,
+    double* errors) const {
+  size_t nAxes = axes_.size();
+  for (size_t i = 0; i < n; ++i) {
+    int found = bin(points + i*nAxes);
+    output[i] = found < 0 ? defaultValue_ : values_[found];
+    if (errors)
+      errors[i] = found < 0 ? defaultError_ : errors_[found];
+  }
+}
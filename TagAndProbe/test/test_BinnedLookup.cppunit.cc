@@ -0,0 +1,150 @@
+/*
+ * Test the BinnedLookup tables against the constants of the if/else chains
+ * they replaced, at the bin edges, in the first and last bins and outside
+ * the tables.
+ */
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <Utilities/Testing/interface/CppUnit_testdriver.icpp>
+#include <cmath>
+#include <limits>
+#include <string>
+
+#include "FinalStateAnalysis/TagAndProbe/interface/BinnedLookup.h"
+#include "FinalStateAnalysis/TagAndProbe/interface/MuonPOG2011HLTEfficiencies.h"
+#include "FinalStateAnalysis/TagAndProbe/interface/ScaleFactorsMuEG201253X.h"
+
+#include "FWCore/ParameterSet/interface/FileInPath.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+namespace {
+  // A point and the value of the old function there
+  struct Expected {
+    double x;
+    double y;
+    double value;
+  };
+
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  const double inf = std::numeric_limits<double>::infinity();
+
+  // muTrigScale_MuEG_2012_53X(pt, eta)
+  const Expected muTrigScale[] = {
+    // first bin, and its edges: 10 < pt <= 15, 0 <= |eta| < 0.8
+    {12.0, 0.5, 0.9841},
+    {10.0001, 0.0, 0.9841},
+    {15.0, 0.7999, 0.9841},
+    {15.0, 0.8, 0.9742},
+    {15.0001, 0.0, 0.9846},
+    // negative eta
+    {12.0, -1.3, 0.9955},
+    // last regular pt bin, last eta bin
+    {35.0, 2.0, 0.9428},
+    // pt <= 10 and pt > 35 use the last row
+    {10.0, 0.5, 0.9991},
+    {5.0, 1.3, 0.9611},
+    {35.0001, 0.7999, 0.9991},
+    {50.0, -1.0, 0.9626},
+    {nan, 0.5, 0.9991},
+    // outside in eta
+    {35.0, 2.1, 0.9314},
+    {12.0, -3.0, 0.9314},
+    {50.0, 2.1, 0.9314},
+    {100.0, 3.0, 0.9314},
+    {20.0, nan, 0.9314},
+    {inf, inf, 0.9314},
+  };
+
+  // Eff_HLT_Mu13_Mu8_2011_TPfit_RunAB_EtaEta_DATA(eta1, eta2)
+  const Expected mu13Mu8Data[] = {
+    // first and last bins
+    {-2.4, -2.4, 0.683784},
+    {-2.1001, -2.1001, 0.683784},
+    {2.4, 2.4, 0.805183},
+    {2.1, 2.1, 0.805183},
+    // the upper edge only belongs to the last bin
+    {2.1, -2.1, 0.849978},
+    {-2.1, 2.39999, 0.849978},
+    {-2.2, 0.0, 0.810635},
+    {-2.2, -0.0001, 0.809198},
+    {0.1, 2.4, 0.879619},
+    {1.6, -0.2, 0.931441},
+    // outside
+    {2.4001, 0.0, 0.0},
+    {0.0, -2.4001, 0.0},
+    {-inf, 0.0, 0.0},
+    {nan, 0.0, 0.0},
+    {0.0, nan, 0.0},
+  };
+
+  std::string tablePath(const std::string& name) {
+    return edm::FileInPath(
+        "FinalStateAnalysis/TagAndProbe/data/" + name + ".txt").fullPath();
+  }
+}
+
+class testBinnedLookup: public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(testBinnedLookup);
+  CPPUNIT_TEST(testMuTrigScale);
+  CPPUNIT_TEST(testMuonPOG);
+  CPPUNIT_TEST(testTable);
+  CPPUNIT_TEST_SUITE_END();
+  public:
+    void setUp(){}
+    void tearDown(){}
+
+    void testMuTrigScale();
+    void testMuonPOG();
+    void testTable();
+};
+
+void testBinnedLookup::testMuTrigScale() {
+  size_t n = sizeof(muTrigScale)/sizeof(muTrigScale[0]);
+  for (size_t i = 0; i < n; ++i) {
+    const Expected& point = muTrigScale[i];
+    CPPUNIT_ASSERT_EQUAL(point.value,
+        muTrigScale_MuEG_2012_53X(point.x, point.y));
+  }
+}
+
+void testBinnedLookup::testMuonPOG() {
+  size_t n = sizeof(mu13Mu8Data)/sizeof(mu13Mu8Data[0]);
+  for (size_t i = 0; i < n; ++i) {
+    const Expected& point = mu13Mu8Data[i];
+    CPPUNIT_ASSERT_EQUAL(point.value,
+        Eff_HLT_Mu13_Mu8_2011_TPfit_RunAB_EtaEta_DATA(point.x, point.y));
+  }
+  // The table is symmetric in the two muons
+  CPPUNIT_ASSERT_EQUAL(
+      Eff_HLT_Mu17_Mu8_2011_TPfit_RunAB_EtaEta_MC(-1.0, 0.25),
+      Eff_HLT_Mu17_Mu8_2011_TPfit_RunAB_EtaEta_MC(0.25, -1.0));
+}
+
+void testBinnedLookup::testTable() {
+  BinnedLookup table(tablePath(
+        "ScaleFactorsMuEG201253X/muTrigScale_MuEG_2012_53X"));
+  CPPUNIT_ASSERT(table.nAxes() == 2);
+  CPPUNIT_ASSERT(table.axisName(0) == "pt");
+  CPPUNIT_ASSERT(table.axisName(1) == "abseta");
+  // 5 pt bins + other, 4 eta bins
+  CPPUNIT_ASSERT(table.nBins() == 24);
+  double inside[2] = {12.0, 0.5};
+  double outside[2] = {12.0, 2.5};
+  CPPUNIT_ASSERT(table.bin(inside) == 0);
+  CPPUNIT_ASSERT(table.bin(outside) == -1);
+  CPPUNIT_ASSERT_THROW(table.value(12.0), cms::Exception);
+
+  // Batch lookup gives the same as one point at a time
+  double points[6] = {12.0, 0.5, 40.0, 1.7, 12.0, 2.5};
+  double values[3];
+  double errors[3];
+  table.values(3, points, values, errors);
+  for (size_t i = 0; i < 3; ++i) {
+    CPPUNIT_ASSERT_EQUAL(table.value(points + 2*i), values[i]);
+    CPPUNIT_ASSERT_EQUAL(table.error(points + 2*i), errors[i]);
+  }
+
+  CPPUNIT_ASSERT_THROW(BinnedLookup("does/not/exist.txt"), cms::Exception);
+}
+
+CPPUNIT_TEST_SUITE_REGISTRATION(testBinnedLookup);
@@ -142,6 +142,34 @@ def chain_sequence(sequence, input_src, src_names=('src',)):
     sequence.visit(chainer)
     return cms.InputTag(chainer.current_src)
 
+class SequenceAssociator(object):
+    def __init__(self, input_src, src_names):
+        self.input_src = input_src
+        self.src_names = src_names
+        self.labels = []
+    def enter(self, visitee):
+        skip = hasattr(visitee, 'noSeqChain') and visitee.noSeqChain
+        if skip:
+            return
+        for src_name in self.src_names:
+            if hasattr(visitee, src_name):
+                setattr(visitee, src_name, cms.InputTag(self.input_src))
+                visitee.associate = cms.bool(True)
+                self.labels.append(visitee.label())
+                break
+    def leave(self, visitee):
+        pass
+
+def associate_sequence(sequence, input_src, src_names=('src',)):
+    ''' Like chain_sequence, but every module reads [input_src] directly
+
+    Each module is switched to emit an association to [input_src] instead of
+    a copy of it.  Returns the associations as a VInputTag.
+    '''
+    associator = SequenceAssociator(input_src, src_names)
+    sequence.visit(associator)
+    return cms.VInputTag(*[cms.InputTag(x) for x in associator.labels])
+
 def format(cfg_object, **replacements):
     if isinstance(cfg_object, cms._Parameterizable):
         # If this is a PSet like type (PSet, EDFilter, etc), recurse down